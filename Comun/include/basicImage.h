@@ -0,0 +1,823 @@
+/**
+ * @file basicImage.h
+ * @brief Fichero cabecera del TDA BasicImage, núcleo común de las imágenes de las prácticas
+ *
+ * Tanto la clase Image de la práctica 3 (grises de 8 bits) como la clase Imagen de la práctica 6
+ * (RGB con transparencia) guardan sus píxeles en un BasicImage, que se encarga de la memoria,
+ * del acceso por filas, de los recortes, de la conversión entre formatos de píxel y de la lectura
+ * y escritura en formato PNM (PGM, PPM y PAM). Así cualquier mejora de estas operaciones sirve
+ * para ambas.
+ *
+ * Todo está en la cabecera: cada combinación de formatos genera en tiempo de compilación su
+ * propio núcleo de conversión, sin llamadas indirectas por píxel.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef COMUN_BASICIMAGE_H
+#define COMUN_BASICIMAGE_H
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Píxel de gris de 8 bits
+ */
+typedef unsigned char Gris8;
+
+/**
+ * @brief Píxel de gris de 16 bits
+ */
+typedef uint16_t Gris16;
+
+/**
+ * @brief Píxel RGB de 8 bits por canal
+ */
+struct Rgb8 {
+	unsigned char r; ///< Rojo
+	unsigned char g; ///< Verde
+	unsigned char b; ///< Azul
+};
+
+/**
+ * @brief Píxel RGBA de 8 bits por canal
+ *
+ * Es el formato intermedio de las conversiones entre formatos de píxel.
+ */
+struct Rgba8 {
+	unsigned char r; ///< Rojo
+	unsigned char g; ///< Verde
+	unsigned char b; ///< Azul
+	unsigned char a; ///< Opacidad: 0 transparente, 255 opaco
+};
+
+/**
+ * @brief Luminancia de un color con los pesos de la recomendación BT.601 en punto fijo
+ * @param c Color
+ * @return Gris de 8 bits equivalente
+ */
+inline unsigned char Luminancia(const Rgba8 &c) {
+	// 77 + 150 + 29 = 256, así que nunca pasa de 255
+	return (unsigned char) ((77 * c.r + 150 * c.g + 29 * c.b + 128) >> 8);
+}
+
+/**
+ * @brief Formato de un tipo de píxel
+ *
+ * Describe cómo se guarda un píxel en un fichero PNM y cómo se pasa a RGBA y desde RGBA.
+ * Cada especialización define:
+ *  - @c CANALES: número de muestras por píxel (1, 3 o 4).
+ *  - @c MAXIMO: valor máximo de cada muestra (255 o 65535). Con 65535 cada muestra ocupa dos bytes.
+ *  - @c DIRECTO: true si los bytes del píxel en memoria son los mismos que en el fichero.
+ *  - @c ARgba() y @c DeRgba(): conversión al formato intermedio y desde él.
+ *  - @c Empaquetar() y @c Desempaquetar(): paso de @a n píxeles a las muestras del fichero y al revés.
+ *
+ * El parámetro @c Formato de BasicImage es, por defecto, esta clase, pero puede ser cualquier otra
+ * con la misma interfaz; así un mismo tipo de píxel se puede leer o escribir de varias formas.
+ *
+ * @tparam PixelT Tipo de píxel
+ */
+template <class PixelT> struct FormatoPixel;
+
+/**
+ * @brief Formato de los grises de 8 bits
+ */
+template <> struct FormatoPixel<Gris8> {
+	static const int CANALES = 1;
+	static const int MAXIMO = 255;
+	static const bool DIRECTO = true;
+
+	static Rgba8 ARgba(Gris8 p) {
+		Rgba8 c = {p, p, p, 255};
+		return c;
+	}
+
+	static Gris8 DeRgba(const Rgba8 &c) {
+		return Luminancia(c);
+	}
+
+	static void Empaquetar(const Gris8 *p, int n, unsigned char *muestras) {
+		memcpy(muestras, p, n);
+	}
+
+	static void Desempaquetar(const unsigned char *muestras, int n, Gris8 *p) {
+		memcpy(p, muestras, n);
+	}
+};
+
+/**
+ * @brief Formato de los grises de 16 bits
+ *
+ * En el fichero cada muestra ocupa dos bytes, el más significativo primero.
+ */
+template <> struct FormatoPixel<Gris16> {
+	static const int CANALES = 1;
+	static const int MAXIMO = 65535;
+	static const bool DIRECTO = false;
+
+	static Rgba8 ARgba(Gris16 p) {
+		unsigned char v = (unsigned char) (p >> 8);
+		Rgba8 c = {v, v, v, 255};
+		return c;
+	}
+
+	static Gris16 DeRgba(const Rgba8 &c) {
+		return (Gris16) (Luminancia(c) * 257);
+	}
+
+	static void Empaquetar(const Gris16 *p, int n, unsigned char *muestras) {
+		for (int k = 0; k < n; k++) {
+			muestras[2 * k] = (unsigned char) (p[k] >> 8);
+			muestras[2 * k + 1] = (unsigned char) p[k];
+		}
+	}
+
+	static void Desempaquetar(const unsigned char *muestras, int n, Gris16 *p) {
+		for (int k = 0; k < n; k++)
+			p[k] = (Gris16) ((muestras[2 * k] << 8) | muestras[2 * k + 1]);
+	}
+};
+
+/**
+ * @brief Formato de los píxeles RGB
+ */
+template <> struct FormatoPixel<Rgb8> {
+	static const int CANALES = 3;
+	static const int MAXIMO = 255;
+	static const bool DIRECTO = sizeof(Rgb8) == 3;
+
+	static Rgba8 ARgba(const Rgb8 &p) {
+		Rgba8 c = {p.r, p.g, p.b, 255};
+		return c;
+	}
+
+	static Rgb8 DeRgba(const Rgba8 &c) {
+		Rgb8 p = {c.r, c.g, c.b};
+		return p;
+	}
+
+	static void Empaquetar(const Rgb8 *p, int n, unsigned char *muestras) {
+		for (int k = 0; k < n; k++) {
+			muestras[3 * k] = p[k].r;
+			muestras[3 * k + 1] = p[k].g;
+			muestras[3 * k + 2] = p[k].b;
+		}
+	}
+
+	static void Desempaquetar(const unsigned char *muestras, int n, Rgb8 *p) {
+		for (int k = 0; k < n; k++) {
+			p[k].r = muestras[3 * k];
+			p[k].g = muestras[3 * k + 1];
+			p[k].b = muestras[3 * k + 2];
+		}
+	}
+};
+
+/**
+ * @brief Formato de los píxeles RGBA
+ */
+template <> struct FormatoPixel<Rgba8> {
+	static const int CANALES = 4;
+	static const int MAXIMO = 255;
+	static const bool DIRECTO = sizeof(Rgba8) == 4;
+
+	static Rgba8 ARgba(const Rgba8 &p) {
+		return p;
+	}
+
+	static Rgba8 DeRgba(const Rgba8 &c) {
+		return c;
+	}
+
+	static void Empaquetar(const Rgba8 *p, int n, unsigned char *muestras) {
+		for (int k = 0; k < n; k++) {
+			muestras[4 * k] = p[k].r;
+			muestras[4 * k + 1] = p[k].g;
+			muestras[4 * k + 2] = p[k].b;
+			muestras[4 * k + 3] = p[k].a;
+		}
+	}
+
+	static void Desempaquetar(const unsigned char *muestras, int n, Rgba8 *p) {
+		for (int k = 0; k < n; k++) {
+			p[k].r = muestras[4 * k];
+			p[k].g = muestras[4 * k + 1];
+			p[k].b = muestras[4 * k + 2];
+			p[k].a = muestras[4 * k + 3];
+		}
+	}
+};
+
+/**
+ * @brief Núcleo de conversión entre dos formatos de píxel
+ *
+ * En general pasa cada píxel por RGBA; como todo es inline, el compilador genera para cada
+ * pareja de formatos un bucle que sólo hace las operaciones necesarias.
+ *
+ * @tparam Origen Tipo de píxel de origen
+ * @tparam Destino Tipo de píxel de destino
+ * @tparam FO Formato del origen
+ * @tparam FD Formato del destino
+ */
+template <class Origen, class Destino, class FO, class FD>
+struct ConversionPixel {
+	/**
+	 * @brief Convierte @a n píxeles
+	 * @param o Píxeles de origen
+	 * @param n Número de píxeles
+	 * @param d Píxeles de destino
+	 */
+	static void Convertir(const Origen *o, int n, Destino *d) {
+		for (int k = 0; k < n; k++)
+			d[k] = FD::DeRgba(FO::ARgba(o[k]));
+	}
+};
+
+/**
+ * @brief Conversión entre píxeles del mismo tipo y formato: una copia
+ */
+template <class PixelT, class Formato>
+struct ConversionPixel<PixelT, PixelT, Formato, Formato> {
+	static void Convertir(const PixelT *o, int n, PixelT *d) {
+		memcpy(d, o, n * sizeof(PixelT));
+	}
+};
+
+/**
+ * @brief TDA BasicImage
+ *
+ * Una instancia del tipo de datos abstracto @c BasicImage es una matriz de @c filas x @c columnas
+ * píxeles de tipo @c PixelT.
+ *
+ * Los píxeles se guardan en un único bloque de memoria y se accede a ellos a través de un vector
+ * de punteros a las filas. En principio la fila @a i empieza en la posición @a i x @c columnas
+ * del bloque, pero PermutarFilas() reordena las filas cambiando sólo los punteros, por lo que
+ * ninguna operación supone que las filas estén seguidas: todas trabajan fila a fila.
+ *
+ * @tparam PixelT Tipo de píxel. Se copia con memcpy, así que debe ser trivialmente copiable
+ * @tparam Formato Formato del píxel (ver FormatoPixel)
+ */
+template <class PixelT, class Formato = FormatoPixel<PixelT> >
+class BasicImage {
+private:
+	/**
+	 * @brief Número de filas
+	 */
+	int nf;
+
+	/**
+	 * @brief Número de columnas
+	 */
+	int nc;
+
+	/**
+	 * @brief Bloque con los nf x nc píxeles
+	 */
+	PixelT *bloque;
+
+	/**
+	 * @brief Puntero al comienzo de cada fila dentro del bloque
+	 */
+	PixelT **filas;
+
+	/**
+	 * @brief Reserva la memoria de una imagen de @a f x @a c píxeles sin inicializarlos
+	 * @param f Filas
+	 * @param c Columnas
+	 * @param buffer Si no es nulo, bloque de f x c píxeles reservado con new[] que pasa a ser de la imagen
+	 * @pre No hay memoria reservada
+	 */
+	void Reservar(int f, int c, PixelT *buffer = 0) {
+		if (f <= 0 || c <= 0) {
+			delete[] buffer;
+			nf = nc = 0;
+			bloque = 0;
+			filas = 0;
+			return;
+		}
+		nf = f;
+		nc = c;
+		bloque = (buffer != 0) ? buffer : new PixelT[(size_t) nf * nc];
+		filas = new PixelT *[nf];
+		for (int i = 0; i < nf; i++)
+			filas[i] = bloque + (size_t) i * nc;
+	}
+
+	/**
+	 * @brief Libera la memoria de la imagen y la deja vacía
+	 */
+	void Liberar() {
+		delete[] bloque;
+		delete[] filas;
+		nf = nc = 0;
+		bloque = 0;
+		filas = 0;
+	}
+
+	/**
+	 * @brief Copia los píxeles de otra imagen de las mismas dimensiones, fila a fila
+	 * @param otra Imagen de origen
+	 */
+	void CopiarFilas(const BasicImage &otra) {
+		for (int i = 0; i < nf; i++)
+			memcpy(filas[i], otra.filas[i], nc * sizeof(PixelT));
+	}
+
+	/**
+	 * @brief Lee la cabecera de un fichero PNM
+	 * @param f Fichero abierto
+	 * @param filas Parámetro de salida con las filas
+	 * @param columnas Parámetro de salida con las columnas
+	 * @param canales Parámetro de salida con las muestras por píxel
+	 * @param maximo Parámetro de salida con el valor máximo de cada muestra
+	 * @return Si la cabecera es correcta
+	 */
+	static bool LeerCabecera(FILE *f, int &filas, int &columnas, int &canales, int &maximo) {
+		char p, tipo;
+		if (fscanf(f, "%c%c", &p, &tipo) != 2 || p != 'P')
+			return false;
+
+		if (tipo == '5' || tipo == '6') {
+			canales = (tipo == '5') ? 1 : 3;
+			int valores[3];
+			for (int k = 0; k < 3; k++) {
+				// Saltamos separadores y comentarios
+				int ch = fgetc(f);
+				while (ch == '#' || isspace(ch)) {
+					if (ch == '#')
+						while (ch != '\n' && ch != EOF)
+							ch = fgetc(f);
+					ch = fgetc(f);
+				}
+				ungetc(ch, f);
+				if (fscanf(f, "%d", &valores[k]) != 1)
+					return false;
+			}
+			columnas = valores[0];
+			filas = valores[1];
+			maximo = valores[2];
+			// Un único separador antes de los datos
+			fgetc(f);
+		}
+		else if (tipo == '7') {
+			char linea[256], clave[64];
+			int valor;
+			filas = columnas = canales = maximo = -1;
+			while (fgets(linea, sizeof(linea), f) != 0) {
+				if (linea[0] == '#' || sscanf(linea, "%63s", clave) != 1)
+					continue;
+				if (strcmp(clave, "ENDHDR") == 0)
+					break;
+				if (sscanf(linea, "%63s %d", clave, &valor) != 2)
+					continue; // TUPLTYPE u otras que no usamos
+				if (strcmp(clave, "WIDTH") == 0)
+					columnas = valor;
+				else if (strcmp(clave, "HEIGHT") == 0)
+					filas = valor;
+				else if (strcmp(clave, "DEPTH") == 0)
+					canales = valor;
+				else if (strcmp(clave, "MAXVAL") == 0)
+					maximo = valor;
+			}
+		}
+		else
+			return false;
+
+		return filas > 0 && columnas > 0 && canales > 0 && maximo > 0 && maximo <= 65535;
+	}
+
+	/**
+	 * @brief Cabecera PNM de una imagen
+	 * @param filas Filas
+	 * @param columnas Columnas
+	 * @param canales Muestras por píxel: 1 (PGM), 3 (PPM) o 4 (PAM)
+	 * @param maximo Valor máximo de cada muestra
+	 * @return Cabecera
+	 */
+	static string Cabecera(int filas, int columnas, int canales, int maximo) {
+		if (canales == 4)
+			return "P7\nWIDTH " + to_string(columnas) + "\nHEIGHT " + to_string(filas) +
+				   "\nDEPTH 4\nMAXVAL " + to_string(maximo) + "\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+		return string(canales == 1 ? "P5\n" : "P6\n") + to_string(columnas) + ' ' + to_string(filas) + "\n" +
+			   to_string(maximo) + "\n";
+	}
+
+public:
+	/**
+	 * @brief Tipo de los píxeles
+	 */
+	typedef PixelT pixel_type;
+
+	/**
+	 * @brief Formato de los píxeles
+	 */
+	typedef Formato formato_type;
+
+	/**
+	 * @brief Constructor por defecto. Crea una imagen vacía
+	 */
+	BasicImage() : nf(0), nc(0), bloque(0), filas(0) {}
+
+	/**
+	 * @brief Crea una imagen sin inicializar sus píxeles
+	 * @param f Filas
+	 * @param c Columnas
+	 */
+	BasicImage(int f, int c) {
+		Reservar(f, c);
+	}
+
+	/**
+	 * @brief Crea una imagen con todos sus píxeles iguales
+	 * @param f Filas
+	 * @param c Columnas
+	 * @param valor Valor de todos los píxeles
+	 */
+	BasicImage(int f, int c, const PixelT &valor) {
+		Reservar(f, c);
+		Rellenar(valor);
+	}
+
+	/**
+	 * @brief Constructor de copia. La copia tiene las filas en su orden natural
+	 * @param otra Imagen a copiar
+	 */
+	BasicImage(const BasicImage &otra) {
+		Reservar(otra.nf, otra.nc);
+		CopiarFilas(otra);
+	}
+
+	/**
+	 * @brief Constructor de movimiento. La imagen movida queda vacía
+	 * @param otra Imagen a mover
+	 */
+	BasicImage(BasicImage &&otra) : nf(otra.nf), nc(otra.nc), bloque(otra.bloque), filas(otra.filas) {
+		otra.nf = otra.nc = 0;
+		otra.bloque = 0;
+		otra.filas = 0;
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	~BasicImage() {
+		Liberar();
+	}
+
+	/**
+	 * @brief Operador de asignación. Si las dimensiones coinciden se reutiliza la memoria
+	 * @param otra Imagen a copiar
+	 * @return Referencia a esta imagen
+	 */
+	BasicImage &operator=(const BasicImage &otra) {
+		if (this != &otra) {
+			if (nf != otra.nf || nc != otra.nc) {
+				Liberar();
+				Reservar(otra.nf, otra.nc);
+			}
+			CopiarFilas(otra);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Asignación por movimiento. La imagen movida queda vacía
+	 * @param otra Imagen a mover
+	 * @return Referencia a esta imagen
+	 */
+	BasicImage &operator=(BasicImage &&otra) {
+		if (this != &otra) {
+			Liberar();
+			swap(nf, otra.nf);
+			swap(nc, otra.nc);
+			swap(bloque, otra.bloque);
+			swap(filas, otra.filas);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Sustituye la imagen por un bloque de píxeles ya reservado
+	 * @param f Filas
+	 * @param c Columnas
+	 * @param buffer Bloque de f x c píxeles, reservado con new[], que pasa a ser de la imagen
+	 */
+	void Adoptar(int f, int c, PixelT *buffer) {
+		Liberar();
+		Reservar(f, c, buffer);
+	}
+
+	/**
+	 * @brief Filas de la imagen
+	 * @return Número de filas
+	 */
+	int getFilas() const {return nf;}
+
+	/**
+	 * @brief Columnas de la imagen
+	 * @return Número de columnas
+	 */
+	int getColumnas() const {return nc;}
+
+	/**
+	 * @brief Número de píxeles de la imagen
+	 * @return filas x columnas
+	 */
+	int size() const {return nf * nc;}
+
+	/**
+	 * @brief Indica si la imagen está vacía
+	 * @return Si no tiene píxeles
+	 */
+	bool empty() const {return nf == 0;}
+
+	/**
+	 * @brief Acceso a una fila
+	 * @param i Fila
+	 * @return Puntero a sus nc píxeles
+	 * @pre 0 <= i < getFilas()
+	 */
+	PixelT *operator[](int i) {
+		return filas[i];
+	}
+
+	/**
+	 * @brief Acceso a una fila
+	 * @param i Fila
+	 * @return Puntero a sus nc píxeles
+	 * @pre 0 <= i < getFilas()
+	 */
+	const PixelT *operator[](int i) const {
+		return filas[i];
+	}
+
+	/**
+	 * @brief Acceso a un píxel
+	 * @param i Fila
+	 * @param j Columna
+	 * @return Referencia al píxel
+	 * @pre 0 <= i < getFilas(), 0 <= j < getColumnas()
+	 */
+	PixelT &operator()(int i, int j) {
+		assert(i >= 0 && i < nf && j >= 0 && j < nc);
+		return filas[i][j];
+	}
+
+	/**
+	 * @brief Acceso a un píxel
+	 * @param i Fila
+	 * @param j Columna
+	 * @return Referencia constante al píxel
+	 * @pre 0 <= i < getFilas(), 0 <= j < getColumnas()
+	 */
+	const PixelT &operator()(int i, int j) const {
+		assert(i >= 0 && i < nf && j >= 0 && j < nc);
+		return filas[i][j];
+	}
+
+	/**
+	 * @brief Indica si las filas están en su orden natural dentro del bloque
+	 *
+	 * Si es así, Datos() recorre la imagen por filas de principio a fin.
+	 *
+	 * @return Si cada fila i empieza en la posición i x columnas del bloque
+	 */
+	bool Contigua() const {
+		for (int i = 0; i < nf; i++)
+			if (filas[i] != bloque + (size_t) i * nc)
+				return false;
+		return true;
+	}
+
+	/**
+	 * @brief Bloque con todos los píxeles
+	 * @return Puntero al primer píxel del bloque. Las filas están en orden sólo si Contigua()
+	 */
+	PixelT *Datos() {return bloque;}
+
+	/**
+	 * @brief Bloque con todos los píxeles
+	 * @return Puntero al primer píxel del bloque. Las filas están en orden sólo si Contigua()
+	 */
+	const PixelT *Datos() const {return bloque;}
+
+	/**
+	 * @brief Da a todos los píxeles el mismo valor
+	 * @param valor Valor
+	 */
+	void Rellenar(const PixelT &valor) {
+		fill(bloque, bloque + (size_t) nf * nc, valor);
+	}
+
+	/**
+	 * @brief Reordena las filas sin mover los píxeles
+	 * @param origen Vector de getFilas() posiciones: la nueva fila i es la que antes era la fila origen[i]
+	 * @pre origen es una permutación de 0..getFilas()-1
+	 */
+	void PermutarFilas(const int origen[]) {
+		vector<PixelT *> anteriores(filas, filas + nf);
+		for (int i = 0; i < nf; i++)
+			filas[i] = anteriores[origen[i]];
+	}
+
+	/**
+	 * @brief Extrae una parte rectangular de la imagen
+	 * @param i Fila superior
+	 * @param j Columna izquierda
+	 * @param f Filas de la parte
+	 * @param c Columnas de la parte
+	 * @return Nueva imagen con la parte
+	 * @pre La parte está dentro de la imagen
+	 */
+	BasicImage Recortar(int i, int j, int f, int c) const {
+		assert(i >= 0 && j >= 0 && f >= 0 && c >= 0 && i + f <= nf && j + c <= nc);
+		BasicImage resultado(f, c);
+		for (int k = 0; k < resultado.nf; k++)
+			memcpy(resultado.filas[k], filas[i + k] + j, c * sizeof(PixelT));
+		return resultado;
+	}
+
+	/**
+	 * @brief Copia una región de otra imagen de las mismas dimensiones en la misma posición
+	 *
+	 * La parte de la región que quede fuera de la imagen se ignora.
+	 *
+	 * @param origen Imagen de la que se copia
+	 * @param fila Fila superior de la región
+	 * @param columna Columna izquierda de la región
+	 * @param f Filas de la región
+	 * @param c Columnas de la región
+	 * @pre origen tiene las mismas dimensiones
+	 */
+	void CopiarRegion(const BasicImage &origen, int fila, int columna, int f, int c) {
+		assert(origen.nf == nf && origen.nc == nc);
+
+		int fini = max(fila, 0), ffin = min(fila + f, nf);
+		int cini = max(columna, 0), cfin = min(columna + c, nc);
+
+		if (cini < cfin)
+			for (int i = fini; i < ffin; i++)
+				memcpy(filas[i] + cini, origen.filas[i] + cini, (cfin - cini) * sizeof(PixelT));
+	}
+
+	/**
+	 * @brief Convierte la imagen a otro formato de píxel
+	 * @tparam Destino Tipo de píxel del resultado
+	 * @tparam FD Formato del resultado
+	 * @return Nueva imagen con los píxeles convertidos
+	 */
+	template <class Destino, class FD = FormatoPixel<Destino> >
+	BasicImage<Destino, FD> Convertir() const {
+		BasicImage<Destino, FD> resultado(nf, nc);
+		for (int i = 0; i < nf; i++)
+			ConversionPixel<PixelT, Destino, Formato, FD>::Convertir(filas[i], nc, resultado[i]);
+		return resultado;
+	}
+
+	/**
+	 * @brief Compara dos imágenes píxel a píxel
+	 * @param otra Imagen con la que comparar
+	 * @return Si tienen las mismas dimensiones y los mismos píxeles en cada posición
+	 */
+	bool operator==(const BasicImage &otra) const {
+		if (nf != otra.nf || nc != otra.nc)
+			return false;
+		for (int i = 0; i < nf; i++)
+			if (memcmp(filas[i], otra.filas[i], nc * sizeof(PixelT)) != 0)
+				return false;
+		return true;
+	}
+
+	/**
+	 * @brief Compara dos imágenes píxel a píxel
+	 * @param otra Imagen con la que comparar
+	 * @return Si son distintas
+	 */
+	bool operator!=(const BasicImage &otra) const {
+		return !(*this == otra);
+	}
+
+	/**
+	 * @brief Lee una imagen PNM cuyos píxeles son de otro formato, convirtiéndolos
+	 *
+	 * El fichero debe tener las muestras por píxel del formato de origen, y muestras de un byte
+	 * si su máximo es 255 o de dos si es 65535.
+	 *
+	 * @tparam Origen Tipo de píxel del fichero
+	 * @tparam FO Formato del fichero
+	 * @param ruta Fichero a leer
+	 * @return Si se ha leído. Si no, la imagen no se modifica
+	 */
+	template <class Origen, class FO = FormatoPixel<Origen> >
+	bool LeerPNMComo(const char ruta[]) {
+		FILE *f = fopen(ruta, "rb");
+		if (f == 0)
+			return false;
+
+		int filas_f, columnas_f, canales, maximo;
+		bool correcto = LeerCabecera(f, filas_f, columnas_f, canales, maximo) && canales == FO::CANALES &&
+						(maximo > 255) == (FO::MAXIMO > 255);
+		if (correcto) {
+			BasicImage leida(filas_f, columnas_f);
+			size_t bytes = (size_t) columnas_f * canales * (maximo > 255 ? 2 : 1);
+			const bool directo = FO::DIRECTO && ConversionDirecta<Origen, FO>::value;
+
+			if (directo)
+				// Los bytes del fichero son ya los píxeles: se leen todos de una vez
+				correcto = fread(leida.bloque, bytes, filas_f, f) == (size_t) filas_f;
+			else {
+				vector<unsigned char> muestras(bytes);
+				vector<Origen> fila(columnas_f);
+				for (int i = 0; i < filas_f && correcto; i++) {
+					correcto = fread(muestras.data(), 1, bytes, f) == bytes;
+					FO::Desempaquetar(muestras.data(), columnas_f, fila.data());
+					ConversionPixel<Origen, PixelT, FO, Formato>::Convertir(fila.data(), columnas_f, leida.filas[i]);
+				}
+			}
+			if (correcto)
+				*this = move(leida);
+		}
+		fclose(f);
+		return correcto;
+	}
+
+	/**
+	 * @brief Lee una imagen PNM con el formato de los píxeles de la imagen
+	 * @param ruta Fichero a leer
+	 * @return Si se ha leído. Si no, la imagen no se modifica
+	 */
+	bool LeerPNM(const char ruta[]) {
+		return LeerPNMComo<PixelT, Formato>(ruta);
+	}
+
+	/**
+	 * @brief Escribe la imagen en formato PNM convirtiendo sus píxeles a otro formato
+	 *
+	 * Según las muestras por píxel del formato de destino se escribe un PGM (1), un PPM (3)
+	 * o un PAM RGBA (4). La conversión se hace fila a fila, sin copiar la imagen entera.
+	 *
+	 * @tparam Destino Tipo de píxel del fichero
+	 * @tparam FD Formato del fichero
+	 * @param ruta Fichero a escribir
+	 * @return Si se ha escrito
+	 */
+	template <class Destino, class FD = FormatoPixel<Destino> >
+	bool EscribirPNMComo(const char ruta[]) const {
+		FILE *f = fopen(ruta, "wb");
+		if (f == 0)
+			return false;
+
+		string cabecera = Cabecera(nf, nc, FD::CANALES, FD::MAXIMO);
+		bool correcto = fwrite(cabecera.data(), 1, cabecera.size(), f) == cabecera.size();
+
+		size_t bytes = (size_t) nc * FD::CANALES * (FD::MAXIMO > 255 ? 2 : 1);
+		const bool directo = FD::DIRECTO && ConversionDirecta<Destino, FD>::value;
+		vector<unsigned char> muestras(directo ? 0 : bytes);
+		vector<Destino> fila(directo ? 0 : nc);
+
+		for (int i = 0; i < nf && correcto; i++) {
+			if (directo)
+				correcto = fwrite(filas[i], 1, bytes, f) == bytes;
+			else {
+				ConversionPixel<PixelT, Destino, Formato, FD>::Convertir(filas[i], nc, fila.data());
+				FD::Empaquetar(fila.data(), nc, muestras.data());
+				correcto = fwrite(muestras.data(), 1, bytes, f) == bytes;
+			}
+		}
+		correcto = (fclose(f) == 0) && correcto;
+		return correcto;
+	}
+
+	/**
+	 * @brief Escribe la imagen en formato PNM con el formato de sus píxeles
+	 * @param ruta Fichero a escribir
+	 * @return Si se ha escrito
+	 */
+	bool EscribirPNM(const char ruta[]) const {
+		return EscribirPNMComo<PixelT, Formato>(ruta);
+	}
+
+private:
+	/**
+	 * @brief Indica si los píxeles de la imagen se pueden leer o escribir tal cual en un formato
+	 * @tparam Otro Tipo de píxel del fichero
+	 * @tparam FO Formato del fichero
+	 */
+	template <class Otro, class FO>
+	struct ConversionDirecta {
+		static const bool value = is_same<Otro, PixelT>::value && is_same<FO, Formato>::value;
+	};
+};
+
+#endif // COMUN_BASICIMAGE_H
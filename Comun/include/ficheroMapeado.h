@@ -0,0 +1,171 @@
+/**
+ * @file ficheroMapeado.h
+ * @brief Fichero cabecera de los TDA FicheroMapeado y Lector
+ *
+ * Permiten leer ficheros de texto sin pasar por flujos: el fichero se proyecta en memoria
+ * y se recorre con un puntero.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_FICHEROMAPEADO_H
+#define PRACTICAFINAL_FICHEROMAPEADO_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @brief TDA FicheroMapeado
+ *
+ * Una instancia del tipo de datos abstracto @c FicheroMapeado es un fichero proyectado en memoria
+ * (mmap) en modo de sólo lectura. La proyección se deshace al destruir el objeto, por lo que no se puede copiar.
+ */
+class FicheroMapeado {
+private:
+	/**
+	 * @brief Comienzo del fichero en memoria. Nulo si no hay fichero o está vacío
+	 */
+	const char *datos;
+
+	/**
+	 * @brief Tamaño del fichero en bytes
+	 */
+	size_t tam;
+
+public:
+	/**
+	 * @brief Constructor por defecto de la clase. No proyecta ningún fichero
+	 */
+	FicheroMapeado(): datos(0), tam(0) {}
+
+	FicheroMapeado(const FicheroMapeado &) = delete;
+	FicheroMapeado & operator=(const FicheroMapeado &) = delete;
+
+	/**
+	 * @brief Destructor de la clase. Deshace la proyección
+	 */
+	~FicheroMapeado();
+
+	/**
+	 * @brief Proyecta un fichero en memoria
+	 * @param nombre Nombre del fichero
+	 * @retval true Si se ha podido abrir y proyectar
+	 * @retval false En caso contrario
+	 */
+	bool Abrir(const string &nombre);
+
+	/**
+	 * @brief Deshace la proyección del fichero, si la hay
+	 */
+	void Cerrar();
+
+	/**
+	 * @brief Devuelve el comienzo del fichero en memoria
+	 * @return Puntero al primer byte del fichero
+	 */
+	const char *begin() const {return datos;}
+
+	/**
+	 * @brief Devuelve el final del fichero en memoria
+	 * @return Puntero a la posición siguiente al último byte del fichero
+	 */
+	const char *end() const {return datos + tam;}
+
+	/**
+	 * @brief Devuelve el tamaño del fichero
+	 * @return Tamaño en bytes
+	 */
+	size_t size() const {return tam;}
+};
+
+/**
+ * @brief TDA Lector
+ *
+ * Una instancia del tipo de datos abstracto @c Lector es un cursor sobre un rango de caracteres
+ * [ini, fin) que extrae de él caracteres, números y palabras separados por blancos, igual que
+ * el operator>> de un flujo pero sin copiar el texto ni construir flujos intermedios.
+ *
+ * El rango no tiene por qué terminar en '\0'.
+ */
+class Lector {
+private:
+	/**
+	 * @brief Posición actual
+	 */
+	const char *p;
+
+	/**
+	 * @brief Final del rango
+	 */
+	const char *fin;
+
+	/**
+	 * @brief Copia en un búfer el número que empieza en la posición actual
+	 * @param buf Búfer donde se copia, terminado en '\0'
+	 * @param tam Tamaño del búfer
+	 * @return Número de caracteres copiados
+	 */
+	size_t CopiarNumero(char *buf, size_t tam) const;
+
+public:
+	/**
+	 * @brief Constructor de la clase
+	 * @param ini Comienzo del rango
+	 * @param fin Final del rango
+	 */
+	Lector(const char *ini, const char *fin): p(ini), fin(fin) {}
+
+	/**
+	 * @brief Avanza hasta el siguiente carácter que no sea un blanco
+	 */
+	void SaltarBlancos();
+
+	/**
+	 * @brief Indica si se ha llegado al final del rango
+	 * @return True si no quedan caracteres, false en caso contrario
+	 */
+	bool Fin() const {return p >= fin;}
+
+	/**
+	 * @brief Devuelve la posición actual
+	 * @return Puntero al siguiente carácter por leer
+	 */
+	const char *Posicion() const {return p;}
+
+	/**
+	 * @brief Lee un carácter, saltando antes los blancos
+	 * @param c Carácter leído
+	 * @retval true Si se ha leído
+	 * @retval false Si se ha llegado al final
+	 */
+	bool LeerCaracter(char &c);
+
+	/**
+	 * @brief Lee un número real, saltando antes los blancos
+	 * @param d Número leído
+	 * @retval true Si se ha leído
+	 * @retval false Si no hay un número en la posición actual
+	 */
+	bool LeerDouble(double &d);
+
+	/**
+	 * @brief Lee un número entero, saltando antes los blancos
+	 * @param n Número leído
+	 * @retval true Si se ha leído
+	 * @retval false Si no hay un número en la posición actual
+	 */
+	bool LeerEntero(int &n);
+
+	/**
+	 * @brief Lee una palabra (secuencia de caracteres sin blancos), saltando antes los blancos
+	 * @param s Palabra leída
+	 * @retval true Si se ha leído
+	 * @retval false Si se ha llegado al final
+	 */
+	bool LeerPalabra(string &s);
+};
+
+#endif //PRACTICAFINAL_FICHEROMAPEADO_H
@@ -0,0 +1,139 @@
+/**
+ * @file ficheroMapeado.cpp
+ * @brief Fichero de implementación de los TDA FicheroMapeado y Lector
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "ficheroMapeado.h"
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+FicheroMapeado::~FicheroMapeado() {
+	Cerrar();
+}
+
+bool FicheroMapeado::Abrir(const string &nombre) {
+	Cerrar();
+
+	int fd = open(nombre.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) == -1) {
+		close(fd);
+		return false;
+	}
+
+	tam = info.st_size;
+	if (tam > 0) {
+		void *p = mmap(0, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED) {
+			close(fd);
+			tam = 0;
+			return false;
+		}
+		datos = (const char *) p;
+
+		// El fichero se va a recorrer de principio a fin
+		madvise(p, tam, MADV_SEQUENTIAL);
+	}
+
+	// La proyección sigue siendo válida tras cerrar el descriptor
+	close(fd);
+	return true;
+}
+
+void FicheroMapeado::Cerrar() {
+	if (datos != 0)
+		munmap((void *) datos, tam);
+	datos = 0;
+	tam = 0;
+}
+
+/**
+ * @brief Indica si un carácter es un blanco, como lo entiende el operator>> de los flujos
+ */
+static inline bool EsBlanco(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Indica si un carácter puede formar parte de un número
+ */
+static inline bool EsNumerico(char c) {
+	return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+void Lector::SaltarBlancos() {
+	while (p < fin && EsBlanco(*p))
+		++p;
+}
+
+size_t Lector::CopiarNumero(char *buf, size_t tam) const {
+	size_t n = 0;
+	while (p + n < fin && n < tam - 1 && EsNumerico(p[n])) {
+		buf[n] = p[n];
+		n++;
+	}
+	buf[n] = '\0';
+	return n;
+}
+
+bool Lector::LeerCaracter(char &c) {
+	SaltarBlancos();
+	if (p >= fin)
+		return false;
+	c = *p++;
+	return true;
+}
+
+bool Lector::LeerDouble(double &d) {
+	SaltarBlancos();
+
+	// El rango no tiene por qué terminar en '\0', así que strtod trabaja sobre una copia del número
+	char buf[64];
+	if (CopiarNumero(buf, sizeof(buf)) == 0)
+		return false;
+
+	char *fin_num;
+	d = strtod(buf, &fin_num);
+	if (fin_num == buf)
+		return false;
+	p += fin_num - buf;
+	return true;
+}
+
+bool Lector::LeerEntero(int &n) {
+	SaltarBlancos();
+
+	char buf[32];
+	if (CopiarNumero(buf, sizeof(buf)) == 0)
+		return false;
+
+	char *fin_num;
+	n = (int) strtol(buf, &fin_num, 10);
+	if (fin_num == buf)
+		return false;
+	p += fin_num - buf;
+	return true;
+}
+
+bool Lector::LeerPalabra(string &s) {
+	SaltarBlancos();
+	if (p >= fin)
+		return false;
+
+	const char *ini = p;
+	while (p < fin && !EsBlanco(*p))
+		++p;
+	s.assign(ini, p);
+	return true;
+}
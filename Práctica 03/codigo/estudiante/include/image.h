@@ -11,6 +11,7 @@
 
 #include <cstdlib>
 #include "imageIO.h"
+#include "basicImage.h"
 
 
 /**
@@ -89,42 +90,24 @@ class Image{
          del vector img y tomando la primera de ellas, pero esto nos parece un sinsentido por la innecesaria
          ineficiencia que implica).
 
-       **/
-private :
-
-    /**
-      @brief Puntero a la imagen almacenada
-
-      img apunta a un array-2D dinámico de bytes que contiene la imagen en sí. Almacena tantos bytes como pixeles tenga la imagen.
-
-    **/
-    byte **img;
+         @section sec_Image_C Núcleo común con la práctica 6.
 
-    /**
-      @brief Número de filas de la imagen.
-    **/
-    int rows;
+         Esta representación es la de BasicImage (Comun/include/basicImage.h), que comparten la clase Image y la
+         clase Imagen de la práctica 6: el bloque de píxeles hace el papel de "orgn_ptr" y su vector de punteros a
+         filas el de img. Image se limita a guardar un BasicImage<byte> y a implementar sobre él sus operaciones.
 
+       **/
+private :
 
     /**
-      @brief Número de columnas de la imagen.
-    **/
-    int cols;
+      @brief Píxeles de la imagen
 
-    /**
-      @brief Puntero inicializado en img[0] que almacena el inicio de la representación en memoria.
-    **/
-    byte * orgn_ptr;
+      Es una matriz de bytes con la representación descrita arriba: un único bloque con todos
+      los píxeles y un vector de punteros a sus filas, que ShuffleRows_eff() reordena.
+      Se encarga de la memoria, de las copias y de la lectura y escritura en disco.
 
-    /**
-      @brief Initialize una imagen.
-      @param nrows Número de filas que tendrá la imagen. Por defecto, 0
-      @param ncols Número de colwnnas que tendrá la imagen. Por defecto, 0
-      @param buffer Puntero a un buffer de datos con los que rellenar los píxeles de la imagen. Por defecto, 0.
-      @pre filas >= O y columnas >= O
-      @post Reserva memoria para almacenar la imagen y la prepara para usarse.
     **/
-    void Initialize (int nrows= 0, int ncols= 0, byte *buffer= 0);
+    BasicImage<byte> img;
 
     /**
       @brief Lee una imagen PGM desde un archivo.
@@ -135,32 +118,6 @@ private :
     **/
     LoadResult LoadFromPGM(const char * file_path);
 
-    /**
-      @brief Copy una imagen .
-      @param orig Referencia a la imagen original que vamos a copiar
-      @pre Asume que no hay memoria reservada o se ha llamado antes a Destroy()
-      @pre Asume this != &orig
-    **/
-    void Copy(const Image &orig);
-
-    /**
-      @brief Reserva o copia en memoria una imagen.
-      @param nrows Número de filas que tendrá la imagen.
-      @param ncols Número de colwnnas que tendrá la imagen.
-      @param buffer Puntero a un buffer de datos con los que rellenar los píxeles de la imagen. Por defecto, 0.
-      @pre nrows >= O y ncols >= O
-      @post Reserva memoria para almacenar la imagen y la prepara para usarse.
-    **/
-    void Allocate(int nrows, int ncols, byte * buffer = 0);
-
-    /**
-      * @brief Destroy una imagen
-      *
-      * Libera la memoria reservada en la que se almacenaba la imagen que llama a la función.
-      * Si la imagen estaba vacía no hace nada .
-      */
-    void Destroy();
-
 public :
 
     /**
@@ -274,8 +231,8 @@ void set_pixel (int i, int j, byte value);
 
     /**
       * @brief Almacena imágenes en disco.
-      * 	La diferencia con Image::MySave() es que usa la representación secuencial en memoria,
-	  * 			por lo que no funciona con la representación modificada.
+      * 	Escribe la imagen fila a fila, por lo que funciona también con la representación modificada.
+      * 	Es equivalente a Image::MySave().
       * @param file_path Ruta donde se almacenará la imagen.
       * @pre file path debe ser una ruta válida donde almacenar el fichero de salida.
       * @return Devuelve true si la imagen se almacenó con éxito y false en caso contrario.
@@ -285,8 +242,8 @@ void set_pixel (int i, int j, byte value);
 
 	/**
 	 * @brief Almacena imágenes en disco.
-	 * 		La diferencia con Image::Save() es que no usa la representación secuencial en memoria,
-	 * 			por lo que funciona con la representación modificada.
+	 * 		No usa la representación secuencial en memoria, por lo que funciona con la representación modificada.
+	 * 			Antes era la única en hacerlo; ahora es equivalente a Image::Save().
      * @param file_path Ruta donde se almacenará la imagen.
      * @pre file path debe ser una ruta válida donde almacenar el fichero de salida.
      * @return Devuelve true si la imagen se almacenó con éxito y false en caso contrario.
@@ -179,12 +179,12 @@ int main(int argc, char *argv[]) {
 
 	const int NUM_VECES = 1e3; // Media eficiencia
 
-	clock_t tini = clock;    // Anotamos el tiempo de inicio
+	clock_t tini = clock();    // Anotamos el tiempo de inicio
 
 	for (int n = 0; n < NUM_VECES; n++)
-		image.ShuffleRows_eff;
+		image.ShuffleRows_eff();
 
-	clock_t tfin = clock;   // Anotamos el tiempo de finalización
+	clock_t tfin = clock();   // Anotamos el tiempo de finalización
 
 	// Mostramos resultados
 	cout << (tfin - tini) / (double) CLOCKS_PER_SEC / NUM_VECES << endl;
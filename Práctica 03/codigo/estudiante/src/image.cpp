@@ -20,62 +20,13 @@ using namespace std;
 /********************************
       FUNCIONES PRIVADAS
 ********************************/
-void Image::Allocate(int nrows, int ncols, byte * buffer){
-    rows = nrows;
-    cols = ncols;
-
-    img = new byte * [rows];
-
-    if (buffer != 0)
-	    orgn_ptr = buffer;
-    else
-	    orgn_ptr = new byte [rows * cols];
-
-
-	img[0] = orgn_ptr;
-    for (int i=1; i < rows; i++)
-        img[i] = img[i-1] + cols;
-}
-
-// Función auxiliar para inicializar imágenes con valores por defecto o a partir de un buffer de datos
-void Image::Initialize (int nrows, int ncols, byte * buffer){
-    if ((nrows == 0) || (ncols == 0)){
-        rows = cols = 0;
-        img = nullptr;
-		orgn_ptr = nullptr;
-    }
-    else Allocate(nrows, ncols, buffer);
-}
-
-// Función auxiliar para copiar objetos Imagen
-
-void Image::Copy(const Image & orig){
-    Initialize(orig.rows,orig.cols);
-    for (int k=0; k<rows*cols;k++)
-        set_pixel(k,orig.get_pixel(k));
-}
-
-// Función auxiliar para destruir objetos Imagen
-bool Image::Empty() const{
-    return (rows == 0) || (cols == 0);
-}
-
-void Image::Destroy(){
-    if (!Empty()){
-        delete [] orgn_ptr;
-        delete [] img;
-    }
-}
-
 LoadResult Image::LoadFromPGM(const char * file_path){
     if (ReadImageKind(file_path) != IMG_PGM)
         return LoadResult::NOT_PGM;
 
-    byte * buffer = ReadPGMImage(file_path, rows, cols);
-    if (!buffer)
+    if (!img.LeerPNM(file_path))
         return LoadResult::READING_ERROR;
 
-    Initialize(rows, cols, buffer);
     return LoadResult::SUCCESS;
 }
 
@@ -86,51 +37,45 @@ LoadResult Image::LoadFromPGM(const char * file_path){
 // Constructor por defecto
 
 Image::Image(){
-    Initialize();
 }
 
 // Constructores con parámetros
-Image::Image (int nrows, int ncols, byte value){
-    Initialize(nrows, ncols);
-    for (int k=0; k<rows*cols; k++) set_pixel(k,value);
+Image::Image (int nrows, int ncols, byte value) : img(nrows, ncols, value){
 }
 
 bool Image::Load (const char * file_path) {
-    Destroy();
     return LoadFromPGM(file_path) == LoadResult::SUCCESS;
 }
 
 // Constructor de copias
 
-Image::Image (const Image & orig){
-    assert (this != &orig);
-    Copy(orig);
+Image::Image (const Image & orig) : img(orig.img){
 }
 
 // Destructor
 
 Image::~Image(){
-    Destroy();
 }
 
 // Operador de Asignación
 
 Image & Image::operator= (const Image & orig){
-    if (this != &orig){
-        Destroy();
-        Copy(orig);
-    }
+    img = orig.img;
     return *this;
 }
 
 // Métodos de acceso a los campos de la clase
 
+bool Image::Empty() const{
+    return img.empty();
+}
+
 int Image::get_rows() const {
-    return rows;
+    return img.getFilas();
 }
 
 int Image::get_cols() const {
-    return cols;
+    return img.getColumnas();
 }
 
 int Image::size() const{
@@ -145,7 +90,6 @@ byte Image::get_pixel (int i, int j) const {
     return img[i][j];
 }
 
-// This doesn't work if representation changes
 void Image::set_pixel (int k, byte value) {
     // Obtenemos en primer lugar la fila y columna
 	int fil = (int)(k / get_cols());
@@ -154,7 +98,6 @@ void Image::set_pixel (int k, byte value) {
 	set_pixel(fil, col, value);
 }
 
-// This doesn't work if representation changes
 byte Image::get_pixel (int k) const {
 	// Obtenemos en primer lugar la fila y columna
 	int fil = (int)(k / get_cols());
@@ -165,6 +108,5 @@ byte Image::get_pixel (int k) const {
 
 // Métodos para almacenar y cargar imagenes en disco
 bool Image::Save (const char * file_path) const {
-	byte *p = orgn_ptr;
-    return WritePGMImage(file_path, p, rows, cols);
+    return img.EscribirPNM(file_path);
 }
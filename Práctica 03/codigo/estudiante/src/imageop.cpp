@@ -12,22 +12,8 @@
 #include <fstream>
 #include <cassert>
 bool Image::operator==(const Image & other) const{
-
-    bool iguales = true;
-
-    // Han de tener las mismas filas y columnas.
-    iguales &= this->get_rows() == other.get_rows();
-    iguales &= this->get_cols() == other.get_cols();
-
-    int i=0;
-    while (iguales && i<this->size()){
-
-        // Compara cada píxel
-        iguales = this->get_pixel(i) == other.get_pixel(i);
-        i++;
-    }
-
-    return iguales;
+    // Mismas dimensiones y mismos píxeles, comparando fila a fila
+    return img == other.img;
 }
 
 
@@ -101,16 +87,18 @@ Image Image::Subsample(int factor) const{
 }
 
 void Image::Invert() {
-    for (int i = 0; i < this->size(); ++i)
-        this->set_pixel(i,255-(this->get_pixel(i)));
+    // Recorremos cada fila de forma contigua, en un bucle que el compilador vectoriza
+    for (int i = 0; i < get_rows(); ++i) {
+        byte *fila = img[i];
+        for (int j = 0; j < get_cols(); ++j)
+            fila[j] = 255 - fila[j];
+    }
 }
 
 Image Image::Crop(int nrow, int ncol, int height, int width) const {
-    Image return_img(height,width);
-    // Rellenamos la imagen resultante
-    for (int i = 0; i < height; i++)
-        for (int j = 0; j < width; j++)
-            return_img.set_pixel(i,j,this->get_pixel(nrow+i,ncol+j));
+    Image return_img;
+    // Copiamos cada fila del recorte de una vez
+    return_img.img = img.Recortar(nrow, ncol, height, width);
     return return_img;
 }
 
@@ -147,6 +135,7 @@ void Image::AdjustContrast (byte in1, byte in2, byte out1, byte out2){
 
 void Image::ShuffleRows_noeff() {
     const int p = 9973;
+    const int rows = get_rows(), cols = get_cols();
     Image temp(rows,cols);
     int newr;
     for (int r=0; r<rows; r++){
@@ -156,42 +145,28 @@ void Image::ShuffleRows_noeff() {
                                                                     // introducimos el correspondiente de newr
 
     }
-    Copy(temp);
+    img = temp.img;
 }
 
 void Image::ShuffleRows_eff() {
     const int p = 9973;
 
-	// Copiamos el vector de punteros a filas para rellenar el nuevo con originales
-	
-    byte ** aux_img = new byte * [rows];
+    const int rows = get_rows();
+
+    // En la fila i irá la que ahora es la fila (p*i) mod rows.
+    // Sólo se reordenan los punteros a las filas, no los píxeles
+    int * new_pos = new int [rows];
     for (int i = 0; i < rows; i++)
-        aux_img[i] = img[i];
+        new_pos[i] = (p*i) % rows;
 
-    // Shuffleamos
-    int new_pos;
-    for (int i = 0; i < rows; i++) {
-        new_pos = (p*i) % rows;
-        img[i] = aux_img[new_pos];
-    }
+    img.PermutarFilas(new_pos);
 
-    delete [] aux_img;
+    delete [] new_pos;
 }
 
 bool Image::MySave (const char *file_path) const{
-    std::ofstream f(file_path);
-    bool res= true;
-
-    if (f){
-        f << "P5" << std::endl;
-        f << cols << ' ' << rows << std::endl;
-        f << 255 << std::endl;
-        for (int fila = 0; fila < get_rows();++fila )
-            f.write(reinterpret_cast<char const *>(img[fila]), cols);
-        if (!f)
-            res=false;
-    }
-    return res;
+    // BasicImage escribe la imagen fila a fila, siguiendo los punteros a las filas
+    return img.EscribirPNM(file_path);
 }
 
 
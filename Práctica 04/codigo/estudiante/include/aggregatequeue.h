@@ -0,0 +1,107 @@
+/**
+ * @file aggregatequeue.h
+ * @brief  Archivo de especificación del TDA AggregateQueue
+ * @author Arturo Olivares Martos
+ */
+
+#ifndef AGGREGATEQUEUE_H
+#define AGGREGATEQUEUE_H
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief TDA AggregateQueue
+ *
+ * Una instancia @e c del tipo de datos abstracto @c AggregateQueue
+ * es una estructura que almacena una cola de elementos junto con el resultado de combinar todos
+ * ellos, del frente al final, con una operación asociativa (máximo, mínimo, suma, mcd...).
+ *
+ * Se implementa con dos pilas: los elementos se insertan en la pila de entrada y se extraen
+ * de la pila de salida, cuyo tope es el frente de la cola. Cuando la de salida se vacía se
+ * vuelcan en ella, en orden inverso, todos los de la entrada. Cada elemento se mueve de una pila
+ * a otra una sola vez, así que push(), pop() y front() son O(1) amortizado.
+ *
+ * Cada pila guarda junto a cada elemento el agregado de los que hay por debajo de él (él incluido),
+ * por lo que el agregado de la cola es la combinación de los agregados de los dos topes.
+ *
+ * @tparam T Tipo de los elementos.
+ * @tparam Monoide Operación de agregación, con una función estática T Combinar(const T&, const T&)
+ * asociativa. Ver monoide.h.
+ */
+template <typename T, class Monoide>
+class AggregateQueue {
+private:
+	/**
+	 * @brief Pila de entrada: los últimos elementos añadidos.
+	 *
+	 * El tope es el final de la cola. El segundo elemento de cada par es el agregado de
+	 * los que hay debajo de él y él mismo, en ese orden.
+	 */
+	vector<pair<T,T>> entrada;
+
+	/**
+	 * @brief Pila de salida: los primeros elementos de la cola.
+	 *
+	 * El tope (el último del vector) es el frente de la cola. El segundo elemento de cada par es
+	 * el agregado de ese elemento y los que hay debajo de él, que son los que van detrás en la cola.
+	 * Nunca está vacía si la cola tiene elementos.
+	 */
+	vector<pair<T,T>> salida;
+
+	/**
+	 * @brief Frente de la cola y agregado de toda la cola, actualizados en cada push() y pop().
+	 */
+	pair<T,T> frente;
+
+	/**
+	 * @brief Recalcula el frente a partir de los topes de las dos pilas.
+	 * @pre La cola no está vacía.
+	 */
+	void ActualizarFrente();
+
+public:
+
+	/**
+	 * @brief Método que consulta el frente de la cola.
+	 * @return El frente de la cola (first) y el agregado de la cola (second).
+	 * @pre La cola no está vacía.
+	 */
+	const pair<T,T>& front() const;
+
+	/**
+	 * @brief Elimina el frente de la cola.
+	 *
+	 * O(1) amortizado: si se vacía la pila de salida se vuelca en ella la de entrada.
+	 *
+	 * @pre La cola no está vacía.
+	 */
+	void pop();
+
+	/**
+	 * @brief Método que añade en el final de la cola.
+	 *
+	 * O(1): sólo se apila en la pila de entrada.
+	 *
+	 * @param elem Elemento a añadir.
+	 */
+	void push(const T& elem);
+
+	/**
+	 * @brief Método que calcula el número de elementos de una cola.
+	 * @return El número de elementos de la cola.
+	 */
+	int size() const;
+
+	/**
+	 * @brief Informa sobre si la cola está vacía o no.
+	 * @retval true Si la cola está vacía.
+	 * @retval false Si hay algún elemento en la cola.
+	 */
+	bool empty() const;
+};
+
+#include "aggregatequeue.tpp"
+#endif // AGGREGATEQUEUE_H
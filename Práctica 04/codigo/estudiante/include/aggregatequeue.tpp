@@ -0,0 +1,67 @@
+/**
+ * @file aggregatequeue.tpp
+ * @brief  Archivo de implementación del TDA AggregateQueue
+ * @author Arturo Olivares Martos
+ */
+
+template <typename T, class Monoide>
+void AggregateQueue<T,Monoide>::ActualizarFrente(){
+	frente = salida.back();
+	if (!entrada.empty())
+		frente.second = Monoide::Combinar(frente.second, entrada.back().second);
+}
+
+template <typename T, class Monoide>
+const pair<T,T>& AggregateQueue<T,Monoide>::front() const{
+	return frente;
+}
+
+template <typename T, class Monoide>
+void AggregateQueue<T,Monoide>::pop(){
+	salida.pop_back();
+
+	if (salida.empty()){
+		// Volcamos la entrada en la salida. El último en entrar queda al fondo,
+		// así que el agregado de cada elemento es el de él y los que entraron después
+		while (!entrada.empty()){
+			const T &elem = entrada.back().first;
+			if (salida.empty())
+				salida.push_back(pair<T,T>(elem, elem));
+			else
+				salida.push_back(pair<T,T>(elem, Monoide::Combinar(elem, salida.back().second)));
+			entrada.pop_back();
+		}
+	}
+
+	if (!salida.empty())
+		ActualizarFrente();
+}
+
+template <typename T, class Monoide>
+void AggregateQueue<T,Monoide>::push(const T& elem){
+
+	if (salida.empty()){
+		// Cola vacía: el elemento es a la vez el frente y el agregado
+		salida.push_back(pair<T,T>(elem, elem));
+		frente = salida.back();
+		return;
+	}
+
+	// Apilamos en la entrada con el agregado de la entrada hasta él
+	if (entrada.empty())
+		entrada.push_back(pair<T,T>(elem, elem));
+	else
+		entrada.push_back(pair<T,T>(elem, Monoide::Combinar(entrada.back().second, elem)));
+
+	frente.second = Monoide::Combinar(frente.second, elem);
+}
+
+template <typename T, class Monoide>
+int AggregateQueue<T,Monoide>::size() const{
+	return salida.size() + entrada.size();
+}
+
+template <typename T, class Monoide>
+bool AggregateQueue<T,Monoide>::empty() const{
+	return salida.empty();
+}
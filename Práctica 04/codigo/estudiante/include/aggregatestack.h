@@ -0,0 +1,77 @@
+/**
+ * @file aggregatestack.h
+ * @brief  Archivo de especificación del TDA AggregateStack
+ * @author Arturo Olivares Martos
+ */
+
+#ifndef AGGREGATESTACK_H
+#define AGGREGATESTACK_H
+
+#include <vector>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief TDA AggregateStack
+ *
+ * Una instancia @e c del tipo de datos abstracto @c AggregateStack
+ * es una estructura que almacena una pila de elementos junto con el resultado de combinar todos
+ * ellos, del fondo al tope, con una operación asociativa (máximo, mínimo, suma, mcd...).
+ *
+ * Los elementos se guardan en un vector cuyo último elemento es el tope de la pila, junto con el
+ * agregado de ese elemento y los que hay debajo de él. Así push(), pop() y top() son O(1).
+ *
+ * @tparam T Tipo de los elementos.
+ * @tparam Monoide Operación de agregación, con una función estática T Combinar(const T&, const T&)
+ * asociativa. Ver monoide.h.
+ */
+template <typename T, class Monoide>
+class AggregateStack {
+private:
+	/**
+	 * @brief Vector empleado para almacenar la pila.
+	 *
+	 * El tope de la pila es el último elemento. El segundo elemento de cada par es el agregado
+	 * de los anteriores y ese elemento, en ese orden.
+	 */
+	vector<pair<T,T>> v;
+public:
+
+	/**
+	 * @brief Método que consulta el tope de la pila.
+	 * @return El tope de la pila (first) y el agregado de la pila (second).
+	 * @pre La pila no está vacía.
+	 */
+	const pair<T,T>& top() const;
+
+
+	/**
+	 * @brief Elimina el tope de la pila.
+	 * @pre La pila no está vacía.
+	 */
+	void pop();
+
+	/**
+	 * @brief Método que añade en el frente de la pila.
+	 * @param elem Elemento a añadir.
+	 */
+	void push(const T& elem);
+
+	/**
+	 * @brief Método que calcula el número de elementos de una pila.
+	 * @return El número de elementos de la pila.
+	 */
+	int size() const;
+
+
+	/**
+	 * @brief Método que comprueba si la pila está vacía.
+	 * @return @retval true si la pila está vacía.
+	 * @return @retval false si la pila no está vacía.
+	 */
+	bool empty() const;
+
+};
+
+#include "aggregatestack.tpp"
+#endif // AGGREGATESTACK_H
@@ -0,0 +1,35 @@
+/**
+ * @file aggregatestack.tpp
+ * @brief  Archivo de implementación del TDA AggregateStack
+ * @author Arturo Olivares Martos
+ */
+
+template <typename T, class Monoide>
+const pair<T,T>& AggregateStack<T,Monoide>::top() const{
+	return v.back();
+}
+
+template <typename T, class Monoide>
+void AggregateStack<T,Monoide>::pop(){
+	v.pop_back();
+}
+
+template <typename T, class Monoide>
+void AggregateStack<T,Monoide>::push(const T& elem){
+
+	// El agregado anterior sólo existe si la pila no está vacía
+	if (v.empty())
+		v.push_back(pair<T,T>(elem, elem));
+	else
+		v.push_back(pair<T,T>(elem, Monoide::Combinar(v.back().second, elem)));
+}
+
+template <typename T, class Monoide>
+int AggregateStack<T,Monoide>::size() const{
+	return v.size();
+}
+
+template <typename T, class Monoide>
+bool AggregateStack<T,Monoide>::empty() const{
+	return v.empty();
+}
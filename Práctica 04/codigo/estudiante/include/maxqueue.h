@@ -7,64 +7,94 @@
 #ifndef MAXQUEUE_H
 #define MAXQUEUE_H
 
-#include <stack>
-#include <utility>
-
-using namespace std;
+#include <cstddef>
+#include "aggregatequeue.h"
+#include "maxqueue_fija.h"
+#include "monoide.h"
 
 /**
- * @brief TDA MaxQueue
+ * @brief Selecciona la implementación de MaxQueue según su capacidad
  *
- * Una instancia @e c del tipo de datos abstracto @c MaxQueue
- * es una estructura que almacena una cola de elementos junto con el máximo.
+ * Con capacidad @a N fija es una MaxQueueFija.
+ *
+ * @tparam T Tipo de los elementos.
+ * @tparam N Capacidad, o 0 si no está acotada.
+ * @tparam Politica Qué hacer al añadir con la cola llena, si la capacidad es fija.
  */
-template <typename T>
-class MaxQueue {
-private:
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+struct TipoMaxQueue {
 	/**
-	 * @brief Pila empleada para almacenar la cola.
-	 *
-	 * El frente de la cola es el tope de la pila.
+	 * @brief Implementación de MaxQueue.
 	 */
-	stack<pair<T,T>> s;
-
-	/**
-	 * @brief Pila auxiliar para gestionar las inserciones.
-	 */
-	stack<pair<T,T>> aux;
-
-public:
+	typedef MaxQueueFija<T, N, Politica> tipo;
+};
 
+/**
+ * @brief Selecciona la implementación de MaxQueue sin capacidad fija: una AggregateQueue con el máximo
+ * @tparam T Tipo de los elementos.
+ * @tparam Politica No se usa.
+ */
+template <typename T, PoliticaDesbordamiento Politica>
+struct TipoMaxQueue<T, 0, Politica> {
 	/**
-	 * @brief Método que consulta el frente de la cola.
-	 * @return El frente de la cola.
+	 * @brief Implementación de MaxQueue.
 	 */
-	const pair<T,T>& front() const;
+	typedef AggregateQueue<T, Maximo<T>> tipo;
+};
 
-	/**
-	 * @brief Elimina el frente de la cola.
-	 */
-	void pop();
+/**
+ * @brief TDA MaxQueue
+ *
+ * Una instancia @e c del tipo de datos abstracto @c MaxQueue
+ * es una estructura que almacena una cola de elementos junto con el máximo.
+ * front() devuelve el frente de la cola (first) y el máximo de la cola (second).
+ *
+ * - MaxQueue<T> es una AggregateQueue cuya operación es el máximo, que crece sin límite.
+ *   push(), pop() y front() son O(1) amortizado.
+ * - MaxQueue<T, N> y MaxQueue<T, N, Politica> son una MaxQueueFija de capacidad @a N, que
+ *   no reserva memoria. push() devuelve si se ha añadido el elemento.
+ *
+ * @tparam T Tipo de los elementos. Debe tener operador <
+ * @tparam N Capacidad, o 0 (por defecto) si no está acotada.
+ * @tparam Politica Qué hacer al añadir con la cola llena. Por defecto, rechazar el elemento.
+ */
+template <typename T, size_t N = 0, PoliticaDesbordamiento Politica = RECHAZAR>
+using MaxQueue = typename TipoMaxQueue<T, N, Politica>::tipo;
 
-	/**
-	 * @brief Método que añade en el final de la cola.
-	 * @param elem Elemento a añadir.
-	 */
-	void push(const T& elem);
+/**
+ * @brief Calcula de una vez el máximo de cada ventana de @a w elementos de un vector
+ *
+ * Da el mismo resultado que añadir los elementos uno a uno a una MaxQueue, eliminando el frente
+ * cuando tiene más de @a w elementos, y consultar el máximo tras cada inserción:
+ * out[i] es el máximo de in[max(0, i-w+1)], ..., in[i].
+ *
+ * Usa el algoritmo de van Herk/Gil-Werman: se divide el vector en bloques de @a w elementos y,
+ * como cada ventana completa abarca el final de un bloque y el principio del siguiente, su máximo
+ * es el mayor entre el máximo del sufijo de un bloque y el del prefijo del siguiente. Son unas
+ * 3 comparaciones por elemento sea cual sea @a w, y la combinación final es un bucle vectorizable.
+ * Los bloques se reparten entre varios hilos.
+ *
+ * @tparam T Tipo de los elementos. Debe tener operador <. Si es de coma flotante, no puede haber NaN.
+ * @param in Vector de entrada.
+ * @param n Número de elementos de @a in y de @a out.
+ * @param w Tamaño de la ventana.
+ * @param out Vector de salida. No se puede solapar con @a in.
+ * @param hilos Número de hilos. Si es 0, tantos como núcleos, siempre que cada uno tenga trabajo suficiente.
+ * @pre w > 0
+ */
+template <typename T>
+void sliding_max(const T* in, size_t n, size_t w, T* out, unsigned hilos = 0);
 
-	/**
-	 * @brief Método que calcula el número de elementos de una cola.
-	 * @return El número de elementos de la cola.
-	 */
-	int size() const;
+#include "maxqueue.tpp"
 
-	/**
-	 * @brief Informa sobre si la cola está vacía o no.
-	 * @retval true Si la cola está vacía.
-	 * @retval false Si hay algún elemento en la cola.
-	 */
-	bool empty() const;
-};
+// Quien enlaza con la biblioteca maxqueue usa las instancias ya compiladas en ella
+// en lugar de generarlas en cada unidad de compilación
+#ifdef MAXQUEUE_INSTANCIAS_EXTERNAS
+#define MAXQUEUE_EXTERNA(T) \
+	extern template class AggregateQueue<T, Maximo<T>>; \
+	extern template void sliding_max<T>(const T*, size_t, size_t, T*, unsigned);
+TIPOS_ARITMETICOS(MAXQUEUE_EXTERNA)
+#undef MAXQUEUE_EXTERNA
+#endif
 
-#include "maxqueue.cpp"
-#endif // MAXQUEUE_H
\ No newline at end of file
+#endif // MAXQUEUE_H
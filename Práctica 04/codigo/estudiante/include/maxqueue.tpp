@@ -0,0 +1,85 @@
+/**
+ * @file maxqueue.tpp
+ * @brief  Archivo de implementación del cálculo en bloque del máximo en ventana deslizante
+ * @author Arturo Olivares Martos
+ */
+
+#include <vector>
+#include <thread>
+
+/**
+ * @brief Calcula sliding_max() en los bloques de un trozo del vector
+ * @tparam T Tipo de los elementos
+ * @param in Vector de entrada completo
+ * @param ini Primer elemento del trozo. Es múltiplo de @a w
+ * @param fin Siguiente al último elemento del trozo
+ * @param w Tamaño de la ventana
+ * @param out Vector de salida completo
+ */
+template <typename T>
+void SlidingMaxTrozo(const T* in, size_t ini, size_t fin, size_t w, T* out) {
+	// Máximos de los sufijos del bloque anterior: sufijo[k] es el máximo desde su elemento k hasta el final
+	vector<T> sufijo(w);
+
+	for (size_t s = ini; s < fin; s += w) {
+		size_t e = (fin - s < w) ? fin : s + w;
+
+		// Máximos de los prefijos del bloque: son ya el resultado de la ventana que acaba en su último
+		// elemento (que coincide con el bloque) y de las ventanas incompletas del principio
+		out[s] = in[s];
+		for (size_t i = s + 1; i < e; i++)
+			out[i] = Maximo<T>::Combinar(out[i-1], in[i]);
+
+		if (s == 0)
+			continue;
+
+		const T *anterior = in + (s - w);
+		sufijo[w-1] = anterior[w-1];
+		for (size_t k = w - 1; k > 0; k--)
+			sufijo[k-1] = Maximo<T>::Combinar(anterior[k-1], sufijo[k]);
+
+		// La ventana que acaba en s + t empieza en el elemento t + 1 del bloque anterior.
+		// Se combinan en el mismo orden que en MaxQueue (los más antiguos primero) para que,
+		// ante elementos iguales, se quede con el mismo
+		size_t m = (e - s < w) ? e - s : w - 1;
+		const T * __restrict suf = sufijo.data() + 1;
+		T * __restrict r = out + s;
+
+		#pragma omp simd
+		for (size_t t = 0; t < m; t++)
+			r[t] = Maximo<T>::Combinar(suf[t], r[t]);
+	}
+}
+
+template <typename T>
+void sliding_max(const T* in, size_t n, size_t w, T* out, unsigned hilos) {
+	const size_t MIN_POR_HILO = 1 << 16;   // Por debajo no compensa crear el hilo
+
+	if (n == 0)
+		return;
+
+	size_t bloques = (n + w - 1) / w;
+	if (hilos == 0) {
+		hilos = thread::hardware_concurrency();
+		if (hilos == 0)
+			hilos = 1;
+		if (hilos > n / MIN_POR_HILO)
+			hilos = (n / MIN_POR_HILO > 0) ? n / MIN_POR_HILO : 1;
+	}
+	if (hilos > bloques)
+		hilos = bloques;
+
+	// Cada hilo hace un trozo de bloques completos; sólo lee el bloque anterior, que no modifica nadie
+	size_t por_hilo = (bloques + hilos - 1) / hilos * w;
+	vector<thread> trabajadores;
+	for (unsigned h = 1; h < hilos && h * por_hilo < n; h++) {
+		size_t ini = h * por_hilo;
+		size_t fin = (n - ini < por_hilo) ? n : ini + por_hilo;
+		trabajadores.push_back(thread(SlidingMaxTrozo<T>, in, ini, fin, w, out));
+	}
+
+	SlidingMaxTrozo(in, 0, (n < por_hilo) ? n : por_hilo, w, out);
+
+	for (size_t h = 0; h < trabajadores.size(); h++)
+		trabajadores[h].join();
+}
@@ -0,0 +1,151 @@
+/**
+ * @file maxqueue_fija.h
+ * @brief  Archivo de especificación del TDA MaxQueueFija
+ * @author Arturo Olivares Martos
+ */
+
+#ifndef MAXQUEUE_FIJA_H
+#define MAXQUEUE_FIJA_H
+
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * @brief Qué hace MaxQueueFija::push() cuando la cola está llena
+ */
+enum PoliticaDesbordamiento {
+	RECHAZAR,           ///< No se añade el elemento y push() devuelve false
+	DESCARTAR_ANTIGUO   ///< Se elimina el frente para hacer sitio al elemento
+};
+
+/**
+ * @brief TDA MaxQueueFija
+ *
+ * Una instancia @e c del tipo de datos abstracto @c MaxQueueFija es una cola de como mucho
+ * @a N elementos junto con el máximo, pensada para usarse donde no se puede reservar memoria
+ * ni tolerar picos de latencia.
+ *
+ * Los elementos se guardan en un buffer circular dentro del propio objeto, así que ninguna
+ * operación reserva memoria ni lanza excepciones (salvo que lo haga la copia de @a T).
+ *
+ * El máximo se calcula con una cola monótona, también circular y dentro del objeto: guarda los
+ * números de los elementos que pueden llegar a ser el máximo, con valores no crecientes.
+ * push() descarta los del final que son menores que el nuevo, por lo que es O(1) amortizado;
+ * pop() y front() son O(1).
+ *
+ * @tparam T Tipo de los elementos. Debe tener operador < y constructor por defecto.
+ * @tparam N Número máximo de elementos.
+ * @tparam Politica Qué hacer al añadir un elemento con la cola llena.
+ */
+template <typename T, size_t N, PoliticaDesbordamiento Politica = RECHAZAR>
+class MaxQueueFija {
+private:
+	static_assert(N > 0, "La capacidad de MaxQueueFija debe ser positiva");
+
+	/**
+	 * @brief Buffer circular con los elementos. El elemento número @e i se guarda en la posición @e i % N.
+	 */
+	T elementos[N];
+
+	/**
+	 * @brief Cola monótona: números de los elementos que pueden llegar a ser el máximo.
+	 *
+	 * Sus elementos, de mono_ini a mono_fin, son números de elementos de la cola en orden
+	 * creciente cuyos valores son no crecientes, así que el primero es el del máximo.
+	 */
+	size_t monotona[N];
+
+	/**
+	 * @brief Número de elementos eliminados: el frente es el elemento número cabeza.
+	 */
+	size_t cabeza;
+
+	/**
+	 * @brief Número de elementos añadidos.
+	 */
+	size_t final;
+
+	/**
+	 * @brief Primera posición ocupada de la cola monótona.
+	 */
+	size_t mono_ini;
+
+	/**
+	 * @brief Siguiente posición libre de la cola monótona.
+	 */
+	size_t mono_fin;
+
+	/**
+	 * @brief Frente de la cola y máximo de toda la cola, actualizados en cada push() y pop().
+	 */
+	pair<T,T> frente;
+
+	/**
+	 * @brief Recalcula el frente a partir del buffer y la cola monótona.
+	 * @pre La cola no está vacía.
+	 */
+	void ActualizarFrente() noexcept(is_nothrow_copy_assignable<T>::value);
+
+public:
+	/**
+	 * @brief Constructor por defecto. Crea una cola vacía.
+	 */
+	MaxQueueFija() noexcept(is_nothrow_default_constructible<T>::value);
+
+	/**
+	 * @brief Método que consulta el frente de la cola.
+	 * @return El frente de la cola (first) y el máximo de la cola (second).
+	 * @pre La cola no está vacía.
+	 */
+	const pair<T,T>& front() const noexcept;
+
+	/**
+	 * @brief Elimina el frente de la cola.
+	 * @pre La cola no está vacía.
+	 */
+	void pop() noexcept(is_nothrow_copy_assignable<T>::value);
+
+	/**
+	 * @brief Método que añade en el final de la cola.
+	 *
+	 * Si la cola está llena, depende de @a Politica: con RECHAZAR no se añade, y con
+	 * DESCARTAR_ANTIGUO se elimina antes el frente.
+	 *
+	 * @param elem Elemento a añadir.
+	 * @retval true Si se ha añadido.
+	 * @retval false Si la cola estaba llena y la política es RECHAZAR.
+	 */
+	bool push(const T& elem) noexcept(is_nothrow_copy_assignable<T>::value);
+
+	/**
+	 * @brief Método que calcula el número de elementos de una cola.
+	 * @return El número de elementos de la cola.
+	 */
+	int size() const noexcept;
+
+	/**
+	 * @brief Informa sobre si la cola está vacía o no.
+	 * @retval true Si la cola está vacía.
+	 * @retval false Si hay algún elemento en la cola.
+	 */
+	bool empty() const noexcept;
+
+	/**
+	 * @brief Informa sobre si la cola está llena o no.
+	 * @retval true Si la cola tiene N elementos.
+	 * @retval false Si cabe algún elemento más.
+	 */
+	bool full() const noexcept;
+
+	/**
+	 * @brief Número máximo de elementos de la cola.
+	 * @return N.
+	 */
+	static constexpr size_t capacity() noexcept {return N;}
+};
+
+#include "maxqueue_fija.tpp"
+#endif // MAXQUEUE_FIJA_H
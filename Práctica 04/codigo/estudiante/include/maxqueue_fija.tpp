@@ -0,0 +1,68 @@
+/**
+ * @file maxqueue_fija.tpp
+ * @brief  Archivo de implementación del TDA MaxQueueFija
+ * @author Arturo Olivares Martos
+ */
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+MaxQueueFija<T,N,Politica>::MaxQueueFija() noexcept(is_nothrow_default_constructible<T>::value)
+	: cabeza(0), final(0), mono_ini(0), mono_fin(0) {}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+void MaxQueueFija<T,N,Politica>::ActualizarFrente() noexcept(is_nothrow_copy_assignable<T>::value){
+	frente.first = elementos[cabeza % N];
+	frente.second = elementos[monotona[mono_ini % N] % N];
+}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+const pair<T,T>& MaxQueueFija<T,N,Politica>::front() const noexcept{
+	return frente;
+}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+void MaxQueueFija<T,N,Politica>::pop() noexcept(is_nothrow_copy_assignable<T>::value){
+	// Si el frente era el máximo, deja de serlo
+	if (monotona[mono_ini % N] == cabeza)
+		mono_ini++;
+	cabeza++;
+
+	if (cabeza != final)
+		ActualizarFrente();
+}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+bool MaxQueueFija<T,N,Politica>::push(const T& elem) noexcept(is_nothrow_copy_assignable<T>::value){
+	if (full()){
+		if (Politica == RECHAZAR)
+			return false;
+		pop();
+	}
+
+	elementos[final % N] = elem;
+
+	// Descartamos los del final menores que el nuevo: ya no pueden ser el máximo. Los iguales se
+	// quedan para que, como en MaxQueue, entre máximos iguales se devuelva el más antiguo
+	while (mono_fin != mono_ini && elementos[monotona[(mono_fin - 1) % N] % N] < elem)
+		mono_fin--;
+	monotona[mono_fin % N] = final;
+	mono_fin++;
+	final++;
+
+	ActualizarFrente();
+	return true;
+}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+int MaxQueueFija<T,N,Politica>::size() const noexcept{
+	return final - cabeza;
+}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+bool MaxQueueFija<T,N,Politica>::empty() const noexcept{
+	return cabeza == final;
+}
+
+template <typename T, size_t N, PoliticaDesbordamiento Politica>
+bool MaxQueueFija<T,N,Politica>::full() const noexcept{
+	return final - cabeza == N;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file maxqueue_spsc.h
+ * @brief  Archivo de especificación del TDA MaxQueueSPSC
+ * @author Arturo Olivares Martos
+ */
+
+#ifndef MAXQUEUE_SPSC_H
+#define MAXQUEUE_SPSC_H
+
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @brief Tamaño de una línea de caché, en bytes
+ */
+#define TAM_LINEA_CACHE 64
+
+/**
+ * @brief TDA MaxQueueSPSC
+ *
+ * Una instancia @e c del tipo de datos abstracto @c MaxQueueSPSC es una cola de capacidad fija,
+ * con el máximo de sus elementos, que pueden usar a la vez dos hilos sin cerrojos: un productor,
+ * que sólo llama a push(), y un consumidor, que llama a front() y pop().
+ *
+ * Los elementos se guardan en un buffer circular. El productor avanza el índice @c final y el
+ * consumidor el índice @c cabeza; cada uno está en su propia línea de caché, junto con la copia
+ * del índice del otro hilo que éste consulta, para que los dos hilos no se disputen las mismas
+ * líneas en cada operación.
+ *
+ * El máximo lo calcula el consumidor con una cola monótona que sólo él modifica: antes de
+ * consultar el frente incorpora los elementos que el productor ha publicado desde la última
+ * vez, descartando los que quedan por detrás de uno mayor. Así el productor sólo escribe el
+ * elemento y publica el índice, y nunca tiene que esperar al consumidor. Cada elemento entra
+ * y sale una sola vez de la cola monótona, por lo que todas las operaciones son O(1) amortizado.
+ *
+ * @tparam T Tipo de los elementos. Debe tener operador <
+ */
+template <typename T>
+class MaxQueueSPSC {
+private:
+	/**
+	 * @brief Buffer circular con los elementos. Su tamaño es una potencia de 2.
+	 *
+	 * El elemento número @e i que se añade se guarda en la posición @e i & mascara.
+	 */
+	vector<T> buffer;
+
+	/**
+	 * @brief Tamaño del buffer menos uno, para calcular las posiciones.
+	 */
+	size_t mascara;
+
+	/**
+	 * @brief Relleno para que los índices del consumidor no compartan línea de caché con los datos anteriores.
+	 */
+	char relleno_inicio[TAM_LINEA_CACHE];
+
+	/**
+	 * @brief Número de elementos eliminados: el frente es el elemento número cabeza. Lo escribe el consumidor.
+	 */
+	atomic<size_t> cabeza;
+
+	/**
+	 * @brief Copia de final que ha leído el consumidor.
+	 */
+	size_t final_visto;
+
+	/**
+	 * @brief Relleno para separar los índices del consumidor de los del productor.
+	 */
+	char relleno_consumidor[TAM_LINEA_CACHE];
+
+	/**
+	 * @brief Número de elementos añadidos: el siguiente será el elemento número final. Lo escribe el productor.
+	 */
+	atomic<size_t> final;
+
+	/**
+	 * @brief Copia de cabeza que ha leído el productor.
+	 */
+	size_t cabeza_vista;
+
+	/**
+	 * @brief Relleno para separar los índices del productor de la cola monótona.
+	 */
+	char relleno_productor[TAM_LINEA_CACHE];
+
+	/**
+	 * @brief Cola monótona: números de los elementos que pueden llegar a ser el máximo. Sólo la usa el consumidor.
+	 *
+	 * Es un buffer circular del mismo tamaño que @c buffer. Sus elementos, de mono_ini a mono_fin,
+	 * son números de elementos de la cola en orden creciente cuyos valores son estrictamente decrecientes,
+	 * así que el primero es el del máximo.
+	 */
+	vector<size_t> monotona;
+
+	/**
+	 * @brief Primera posición ocupada de la cola monótona.
+	 */
+	size_t mono_ini;
+
+	/**
+	 * @brief Siguiente posición libre de la cola monótona.
+	 */
+	size_t mono_fin;
+
+	/**
+	 * @brief Número del siguiente elemento que hay que incorporar a la cola monótona.
+	 */
+	size_t incorporado;
+
+	/**
+	 * @brief Incorpora a la cola monótona los elementos publicados por el productor.
+	 *
+	 * Sólo la llama el consumidor.
+	 */
+	void Incorporar();
+
+public:
+	/**
+	 * @brief Constructor de la clase.
+	 * @param capacidad Número máximo de elementos. Se redondea a la siguiente potencia de 2.
+	 * @pre capacidad > 0
+	 */
+	explicit MaxQueueSPSC(size_t capacidad);
+
+	/**
+	 * @brief Método que añade en el final de la cola. Sólo lo puede llamar el productor.
+	 * @param elem Elemento a añadir.
+	 * @retval true Si se ha añadido.
+	 * @retval false Si la cola está llena.
+	 */
+	bool push(const T& elem);
+
+	/**
+	 * @brief Método que consulta el frente de la cola. Sólo lo puede llamar el consumidor.
+	 * @param frente Parámetro de salida con el frente de la cola (first) y el máximo de la cola (second).
+	 * @retval true Si la cola tenía algún elemento.
+	 * @retval false Si la cola estaba vacía. @a frente no se modifica.
+	 */
+	bool front(pair<T,T>& frente);
+
+	/**
+	 * @brief Elimina el frente de la cola. Sólo lo puede llamar el consumidor.
+	 * @retval true Si se ha eliminado.
+	 * @retval false Si la cola estaba vacía.
+	 */
+	bool pop();
+
+	/**
+	 * @brief Método que calcula el número de elementos de la cola.
+	 *
+	 * Si el otro hilo está modificando la cola, el resultado puede haber cambiado ya al devolverlo.
+	 *
+	 * @return El número de elementos de la cola.
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Informa sobre si la cola está vacía o no, con la misma salvedad que size().
+	 * @retval true Si la cola está vacía.
+	 * @retval false Si hay algún elemento en la cola.
+	 */
+	bool empty() const;
+
+	/**
+	 * @brief Número máximo de elementos de la cola.
+	 * @return La capacidad de la cola.
+	 */
+	size_t capacity() const;
+};
+
+#include "maxqueue_spsc.tpp"
+#endif // MAXQUEUE_SPSC_H
@@ -0,0 +1,104 @@
+/**
+ * @file maxqueue_spsc.tpp
+ * @brief  Archivo de implementación del TDA MaxQueueSPSC
+ * @author Arturo Olivares Martos
+ */
+
+template <typename T>
+MaxQueueSPSC<T>::MaxQueueSPSC(size_t capacidad)
+	: cabeza(0), final_visto(0), final(0), cabeza_vista(0), mono_ini(0), mono_fin(0), incorporado(0) {
+	size_t tam = 1;
+	while (tam < capacidad)
+		tam *= 2;
+
+	buffer.resize(tam);
+	monotona.resize(tam);
+	mascara = tam - 1;
+}
+
+template <typename T>
+bool MaxQueueSPSC<T>::push(const T& elem){
+	size_t f = final.load(memory_order_relaxed);
+
+	// Sólo volvemos a leer la cabeza del consumidor si, con la que conocemos, la cola está llena
+	if (f - cabeza_vista > mascara){
+		cabeza_vista = cabeza.load(memory_order_acquire);
+		if (f - cabeza_vista > mascara)
+			return false;
+	}
+
+	buffer[f & mascara] = elem;
+
+	// Publicamos el elemento: el consumidor lo verá escrito al leer el nuevo final
+	final.store(f + 1, memory_order_release);
+	return true;
+}
+
+template <typename T>
+void MaxQueueSPSC<T>::Incorporar(){
+	final_visto = final.load(memory_order_acquire);
+
+	// Los elementos eliminados antes de incorporarlos ya no cuentan
+	size_t c = cabeza.load(memory_order_relaxed);
+	if (incorporado < c)
+		incorporado = c;
+
+	for (; incorporado < final_visto; incorporado++){
+		const T &elem = buffer[incorporado & mascara];
+
+		// Descartamos los del final que no son mayores que el nuevo: ya no pueden ser el máximo
+		while (mono_fin != mono_ini && !(elem < buffer[monotona[(mono_fin - 1) & mascara] & mascara]))
+			mono_fin--;
+		monotona[mono_fin & mascara] = incorporado;
+		mono_fin++;
+	}
+}
+
+template <typename T>
+bool MaxQueueSPSC<T>::front(pair<T,T>& frente){
+	Incorporar();
+
+	size_t c = cabeza.load(memory_order_relaxed);
+	if (c == final_visto)
+		return false;
+
+	frente.first = buffer[c & mascara];
+	frente.second = buffer[monotona[mono_ini & mascara] & mascara];
+	return true;
+}
+
+template <typename T>
+bool MaxQueueSPSC<T>::pop(){
+	size_t c = cabeza.load(memory_order_relaxed);
+
+	if (c == final_visto){
+		final_visto = final.load(memory_order_acquire);
+		if (c == final_visto)
+			return false;
+	}
+
+	// Si el frente era el máximo, deja de serlo
+	if (mono_ini != mono_fin && monotona[mono_ini & mascara] == c)
+		mono_ini++;
+
+	// Liberamos la posición: el productor ya puede reutilizarla
+	cabeza.store(c + 1, memory_order_release);
+	return true;
+}
+
+template <typename T>
+size_t MaxQueueSPSC<T>::size() const{
+	size_t c = cabeza.load(memory_order_acquire);
+	size_t f = final.load(memory_order_acquire);
+	return (f > c) ? f - c : 0;
+}
+
+template <typename T>
+bool MaxQueueSPSC<T>::empty() const{
+	return size() == 0;
+}
+
+template <typename T>
+size_t MaxQueueSPSC<T>::capacity() const{
+	return mascara + 1;
+}
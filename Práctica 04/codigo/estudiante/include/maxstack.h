@@ -7,65 +7,29 @@
 #ifndef MAXSTACK_H
 #define MAXSTACK_H
 
-#include <queue>
-#include <utility>
-using namespace std;
+#include "aggregatestack.h"
+#include "monoide.h"
 
 /**
  * @brief TDA MaxStack
  *
  * Una instancia @e c del tipo de datos abstracto @c MaxStack
  * es una estructura que almacena una pila de elementos junto con el máximo.
+ *
+ * Es una AggregateStack cuya operación es el máximo: top() devuelve el tope de la pila (first)
+ * y el máximo de la pila (second). push(), pop() y top() son O(1).
+ *
+ * @tparam T Tipo de los elementos. Debe tener operador <
  */
 template <typename T>
-class MaxStack {
-private:
-	/**
-	 * @brief Cola empleada para almacenar la pila.
-	 *
-	 * El tope de la pila es el frente de la cola.
-	 */
-	queue<pair<T,T>> q;
-
-	/**
-	 * @brief Cola auxiliar para gestionar las inserciones.
-	 */
-	queue<pair<T,T>> aux;
-public:
-
-	/**
-	 * @brief Método que consulta el tope de la pila.
-	 * @return El tope de la pila.
-	 */
-	const pair<T,T>& top() const;
-
-
-	/**
-	 * @brief Elimina el tope de la pila.
-	 */
-	void pop();
-
-	/**
-	 * @brief Método que añade en el frente de la pila.
-	 * @param elem Elemento a añadir.
-	 */
-	void push(const T& elem);
-
-	/**
-	 * @brief Método que calcula el número de elementos de una pila.
-	 * @return El número de elementos de la pila.
-	 */
-	int size() const;
-
-
-	/**
-	 * @brief Método que comprueba si la pila está vacía.
-	 * @return @retval true si la pila está vacía.
-	 * @return @retval false si la pila no está vacía.
-	 */
-	bool empty() const;
-
-};
+using MaxStack = AggregateStack<T, Maximo<T>>;
 
+// Quien enlaza con la biblioteca maxstack usa las instancias ya compiladas en ella
+// en lugar de generarlas en cada unidad de compilación
+#ifdef MAXSTACK_INSTANCIAS_EXTERNAS
+#define MAXSTACK_EXTERNA(T) extern template class AggregateStack<T, Maximo<T>>;
+TIPOS_ARITMETICOS(MAXSTACK_EXTERNA)
+#undef MAXSTACK_EXTERNA
+#endif
 
-#endif // MAXSTACK_H
\ No newline at end of file
+#endif // MAXSTACK_H
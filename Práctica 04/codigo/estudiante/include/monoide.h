@@ -0,0 +1,126 @@
+/**
+ * @file monoide.h
+ * @brief  Operaciones de agregación para AggregateQueue y AggregateStack
+ * @author Arturo Olivares Martos
+ *
+ * Cada operación es una estructura sin datos con una función estática
+ * @code
+ * static T Combinar(const T& a, const T& b);
+ * @endcode
+ * que debe ser asociativa. @a a es siempre el agregado de los elementos más antiguos y @a b el de
+ * los más recientes, así que también se admiten operaciones no conmutativas.
+ *
+ * Como la operación es un parámetro de plantilla y no un puntero a función, el compilador
+ * conoce Combinar() al instanciar la estructura y puede expandirla en línea.
+ */
+
+#ifndef MONOIDE_H
+#define MONOIDE_H
+
+#include <utility>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @brief Máximo de los elementos
+ * @tparam T Tipo de los elementos. Debe tener operador <
+ */
+template <typename T>
+struct Maximo {
+	/**
+	 * @brief Combina dos agregados.
+	 * @param a Agregado de los elementos más antiguos.
+	 * @param b Agregado de los elementos más recientes.
+	 * @return El mayor de los dos. Si son iguales, @a a.
+	 */
+	static T Combinar(const T& a, const T& b) {
+		return (a < b) ? b : a;
+	}
+};
+
+/**
+ * @brief Mínimo de los elementos
+ * @tparam T Tipo de los elementos. Debe tener operador <
+ */
+template <typename T>
+struct Minimo {
+	/**
+	 * @brief Combina dos agregados.
+	 * @param a Agregado de los elementos más antiguos.
+	 * @param b Agregado de los elementos más recientes.
+	 * @return El menor de los dos. Si son iguales, @a a.
+	 */
+	static T Combinar(const T& a, const T& b) {
+		return (b < a) ? b : a;
+	}
+};
+
+/**
+ * @brief Suma de los elementos
+ * @tparam T Tipo de los elementos. Debe tener operador +
+ */
+template <typename T>
+struct Suma {
+	/**
+	 * @brief Combina dos agregados.
+	 * @param a Agregado de los elementos más antiguos.
+	 * @param b Agregado de los elementos más recientes.
+	 * @return La suma de los dos.
+	 */
+	static T Combinar(const T& a, const T& b) {
+		return a + b;
+	}
+};
+
+/**
+ * @brief Máximo común divisor de los elementos
+ * @tparam T Tipo entero no negativo. Se toma mcd(0, x) = x
+ */
+template <typename T>
+struct Mcd {
+	/**
+	 * @brief Combina dos agregados.
+	 * @param a Agregado de los elementos más antiguos.
+	 * @param b Agregado de los elementos más recientes.
+	 * @return El máximo común divisor de los dos, por el algoritmo de Euclides.
+	 */
+	static T Combinar(T a, T b) {
+		while (b != 0) {
+			T r = a % b;
+			a = b;
+			b = r;
+		}
+		return a;
+	}
+};
+
+/**
+ * @brief Posición del máximo de los elementos
+ *
+ * Los elementos son pares (valor, posición). El agregado es el par con mayor valor;
+ * si hay varios, el más antiguo.
+ *
+ * @tparam T Tipo de los valores. Debe tener operador <
+ */
+template <typename T>
+struct ArgMaximo {
+	/**
+	 * @brief Combina dos agregados.
+	 * @param a Agregado de los elementos más antiguos.
+	 * @param b Agregado de los elementos más recientes.
+	 * @return El par con mayor valor. Si los valores son iguales, @a a.
+	 */
+	static pair<T,size_t> Combinar(const pair<T,size_t>& a, const pair<T,size_t>& b) {
+		return (a.first < b.first) ? b : a;
+	}
+};
+
+/**
+ * @brief Aplica la macro @a X a cada tipo aritmético para el que las bibliotecas maxstack y maxqueue
+ * tienen compiladas las instancias de MaxStack y MaxQueue
+ */
+#define TIPOS_ARITMETICOS(X) \
+	X(int) X(unsigned) X(long) X(unsigned long) X(long long) X(unsigned long long) X(float) X(double)
+
+#endif // MONOIDE_H
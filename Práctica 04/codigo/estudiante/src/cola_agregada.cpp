@@ -0,0 +1,71 @@
+/**
+ * @file cola_agregada.cpp
+ * @brief Fichero de ejemplo para el uso de la clase AggregateQueue con distintas operaciones.
+ *
+ * Mantiene a la vez varias colas de enteros con los mismos elementos, cada una con una operación
+ * de monoide.h: máximo, mínimo, suma, máximo común divisor y posición del máximo.
+ * Por cada entero recibido como parámetro lo añade a las colas.
+ * Por cada punto recibido como parámetro muestra el frente y el agregado de cada cola
+ * y elimina el frente.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./cola_agregada 12 18 . 6 30 . . .
+ * @endcode
+ *
+ * La salida será:
+ * @code{.sh}
+ * frente 12: max 18, min 12, suma 30, mcd 6, argmax 1
+ * frente 18: max 30, min 6, suma 54, mcd 6, argmax 3
+ * frente 6: max 30, min 6, suma 36, mcd 6, argmax 3
+ * frente 30: max 30, min 30, suma 30, mcd 30, argmax 3
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+#include <iostream>
+#include <cstdlib>
+#include "aggregatequeue.h"
+#include "monoide.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]){
+
+	AggregateQueue<int, Maximo<int>> maximo;
+	AggregateQueue<int, Minimo<int>> minimo;
+	AggregateQueue<long long, Suma<long long>> suma;
+	AggregateQueue<int, Mcd<int>> mcd;
+	AggregateQueue<pair<int,size_t>, ArgMaximo<int>> argmax;
+
+	size_t posicion = 0;
+
+	for(int i = 1; i < argc; i++){
+		if (argv[i][0] == '.'){
+			if (maximo.empty()){
+				cerr << "La cola está vacía" << endl;
+				return 1;
+			}
+			cout << "frente " << maximo.front().first
+				 << ": max " << maximo.front().second
+				 << ", min " << minimo.front().second
+				 << ", suma " << suma.front().second
+				 << ", mcd " << mcd.front().second
+				 << ", argmax " << argmax.front().second.second << endl;
+
+			maximo.pop();
+			minimo.pop();
+			suma.pop();
+			mcd.pop();
+			argmax.pop();
+		} else {
+			int elem = atoi(argv[i]);
+			maximo.push(elem);
+			minimo.push(elem);
+			suma.push(elem);
+			mcd.push(elem);
+			argmax.push(pair<int,size_t>(elem, posicion++));
+		}
+	}
+	return 0;
+}
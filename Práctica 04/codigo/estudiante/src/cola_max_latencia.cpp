@@ -0,0 +1,127 @@
+/**
+ * @file cola_max_latencia.cpp
+ * @brief Fichero usado para medir la latencia de cada operación de MaxQueue con y sin capacidad fija
+ *
+ * Calcula el máximo en ventana deslizante de una secuencia de enteros aleatorios: por cada muestra,
+ * si la cola ya tiene @e w elementos elimina el frente, y después añade la muestra. Se mide el tiempo
+ * de cada push() y de cada pop() por separado, y se muestran la mediana, los percentiles 99 y 99.9
+ * y el máximo, en nanosegundos (incluyen el coste de leer el reloj).
+ *
+ * Compara, para ventanas de 1024 y 65536 elementos:
+ *  - MaxQueue<int>, que crece según hace falta y vuelca una pila en otra cuando se vacía la de salida.
+ *  - MaxQueue<int, w>, de capacidad fija, que nunca reserva memoria.
+ *  - MaxQueue<int, w, DESCARTAR_ANTIGUO>, en la que push() elimina él mismo el frente.
+ *
+ * Las colas empiezan vacías, así que también se miden las reservas de memoria mientras se llenan.
+ *
+ * @param NumeroDeMuestras Número de muestras de la secuencia. Opcional, por defecto 10^6.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./cola_max_latencia 1000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "maxqueue.h"
+
+using namespace std;
+
+/**
+ * @brief Muestra la mediana, los percentiles 99 y 99.9 y el máximo de unas latencias
+ * @param cola Nombre de la cola
+ * @param operacion Nombre de la operación
+ * @param latencias Latencias, en nanosegundos. Se reordenan
+ */
+void MostrarPercentiles(const char *cola, const char *operacion, vector<long long> &latencias) {
+	if (latencias.empty())
+		return;
+
+	size_t n = latencias.size();
+	size_t posiciones[] = {n / 2, n * 99 / 100, n * 999 / 1000};
+	long long valores[3];
+	for (int k = 0; k < 3; k++) {
+		nth_element(latencias.begin(), latencias.begin() + posiciones[k], latencias.end());
+		valores[k] = latencias[posiciones[k]];
+	}
+
+	cout << cola << "\t" << operacion << "\t" << valores[0] << "\t" << valores[1] << "\t" << valores[2]
+		 << "\t" << *max_element(latencias.begin(), latencias.end()) << endl;
+}
+
+/**
+ * @brief Mide la latencia de push() y pop() calculando el máximo en ventana deslizante
+ * @tparam Cola Tipo de cola
+ * @param datos Secuencia
+ * @param w Tamaño de la ventana
+ * @param descarta Si push() elimina el frente él mismo cuando la cola está llena
+ * @param nombre Nombre de la cola, para mostrarlo
+ */
+template <class Cola>
+void Medir(const vector<int> &datos, int w, bool descarta, const char *nombre) {
+	typedef chrono::steady_clock reloj;
+
+	Cola *cola = new Cola;
+	vector<long long> lat_push, lat_pop;
+	lat_push.reserve(datos.size());
+	lat_pop.reserve(datos.size());
+
+	for (size_t i = 0; i < datos.size(); i++) {
+		if (!descarta && cola->size() == w) {
+			reloj::time_point t0 = reloj::now();
+			cola->pop();
+			reloj::time_point t1 = reloj::now();
+			lat_pop.push_back(chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count());
+		}
+
+		reloj::time_point t0 = reloj::now();
+		cola->push(datos[i]);
+		reloj::time_point t1 = reloj::now();
+		lat_push.push_back(chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count());
+	}
+
+	delete cola;
+
+	MostrarPercentiles(nombre, "push", lat_push);
+	MostrarPercentiles(nombre, "pop", lat_pop);
+}
+
+/**
+ * @brief Mide las tres colas con una ventana de tamaño @a W
+ * @tparam W Tamaño de la ventana y capacidad de las colas fijas
+ * @param datos Secuencia
+ */
+template <size_t W>
+void MedirVentana(const vector<int> &datos) {
+	cout << "ventana " << W << endl;
+	Medir<MaxQueue<int>>(datos, W, false, "MaxQueue<int>");
+	Medir<MaxQueue<int, W>>(datos, W, false, "MaxQueue<int,w>");
+	Medir<MaxQueue<int, W, DESCARTAR_ANTIGUO>>(datos, W, true, "MaxQueue<int,w,DESCARTAR_ANTIGUO>");
+}
+
+int main(int argc, char *argv[]) {
+	long long n = (argc > 1) ? atoll(argv[1]) : 1000000;
+
+	if (argc > 2 || n <= 0) {
+		cerr << "Uso: cola_max_latencia [NumeroDeMuestras]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	vector<int> datos(n);
+	for (long long i = 0; i < n; i++)
+		datos[i] = rand();
+
+	cout << "Muestras: " << n << " (latencias en nanosegundos)" << endl;
+	cout << "cola\toperacion\tp50\tp99\tp999\tmax" << endl;
+	MedirVentana<1024>(datos);
+	MedirVentana<65536>(datos);
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file cola_max_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de MaxQueue como máximo en ventana deslizante
+ *
+ * Genera una secuencia de enteros aleatorios y calcula el máximo de cada ventana de @e w muestras:
+ * por cada muestra la añade al final de la cola, elimina el frente si la cola tiene más de @e w
+ * elementos y consulta el máximo.
+ *
+ * Compara MaxQueue, implementada con dos pilas (O(1) amortizado por operación), con
+ * MaxQueue_noeff, la implementación anterior, que en cada inserción vacía la pila en otra y
+ * la vuelve a llenar (O(w) por inserción). Para cada tamaño de ventana, de 10 a 10^6, muestra
+ * las muestras procesadas por segundo con cada una y comprueba que obtienen los mismos máximos.
+ *
+ * Como MaxQueue_noeff es O(w) por muestra, con ella sólo se procesan las muestras necesarias para
+ * hacer unas 2*10^8 copias de elementos, y a partir de ventanas de 10^5 no se mide.
+ *
+ * @param NumeroDeMuestras Número de muestras de la secuencia. Opcional, por defecto 10^7.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./cola_max_medida 10000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <stack>
+#include <vector>
+#include "maxqueue.h"
+
+using namespace std;
+
+/**
+ * @brief Implementación anterior de MaxQueue, con una pila y una pila auxiliar
+ *
+ * El frente de la cola es el tope de la pila. Cada inserción vuelca la pila en la auxiliar,
+ * apila el nuevo elemento y vuelve a apilar los demás, actualizando los máximos.
+ */
+template <typename T>
+class MaxQueue_noeff {
+private:
+	/**
+	 * @brief Pila empleada para almacenar la cola.
+	 */
+	stack<pair<T,T>> s;
+
+	/**
+	 * @brief Pila auxiliar para gestionar las inserciones.
+	 */
+	stack<pair<T,T>> aux;
+
+public:
+	/**
+	 * @brief Método que consulta el frente de la cola.
+	 * @return El frente de la cola.
+	 */
+	const pair<T,T>& front() const {return s.top();}
+
+	/**
+	 * @brief Elimina el frente de la cola.
+	 */
+	void pop() {s.pop();}
+
+	/**
+	 * @brief Método que calcula el número de elementos de una cola.
+	 * @return El número de elementos de la cola.
+	 */
+	int size() const {return s.size();}
+
+	/**
+	 * @brief Método que añade en el final de la cola.
+	 * @param elem Elemento a añadir.
+	 */
+	void push(const T& elem) {
+		while (!s.empty()) {
+			aux.push(s.top());
+			s.pop();
+		}
+
+		s.push(pair<T,T>(elem, elem));
+
+		while (!aux.empty() && (aux.top().second < elem)) {
+			s.push(pair<T,T>(aux.top().first, elem));
+			aux.pop();
+		}
+
+		while (!aux.empty()) {
+			s.push(aux.top());
+			aux.pop();
+		}
+	}
+};
+
+/**
+ * @brief Calcula el máximo de cada ventana de una secuencia con una cola con máximo
+ * @tparam Cola MaxQueue o MaxQueue_noeff
+ * @param datos Secuencia
+ * @param n Número de muestras a procesar
+ * @param w Tamaño de la ventana
+ * @param suma Parámetro de salida con la suma de los máximos de todas las ventanas
+ * @return Tiempo empleado, en segundos
+ */
+template <class Cola>
+double VentanaDeslizante(const vector<int> &datos, int n, int w, long long &suma) {
+	Cola cola;
+	suma = 0;
+
+	clock_t tini = clock();
+	for (int i = 0; i < n; i++) {
+		cola.push(datos[i]);
+		if (cola.size() > w)
+			cola.pop();
+		suma += cola.front().second;
+	}
+	clock_t tfin = clock();
+
+	return (tfin - tini) / (double) CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[]) {
+	int n = (argc > 1) ? atoi(argv[1]) : 10000000;
+
+	if (argc > 2 || n <= 0) {
+		cerr << "Uso: cola_max_medida [NumeroDeMuestras]" << endl;
+		return 1;
+	}
+
+	const double COPIAS_NOEFF = 2e8;   // Trabajo máximo de MaxQueue_noeff en cada ventana
+	const int VENTANA_MAX_NOEFF = 10000;
+
+	srand(1);
+	vector<int> datos(n);
+	for (int i = 0; i < n; i++)
+		datos[i] = rand();
+
+	cout << "Muestras: " << n << " (muestras por segundo)" << endl;
+	cout << "ventana\tMaxQueue\tMaxQueue_noeff" << endl;
+
+	for (int w = 10; w <= 1000000; w *= 10) {
+		long long suma;
+		double t = VentanaDeslizante<MaxQueue<int>>(datos, n, w, suma);
+		cout << w << "\t" << n / t << "\t";
+
+		if (w <= VENTANA_MAX_NOEFF) {
+			// Procesamos con ambas las mismas muestras para comparar los máximos
+			int n_noeff = min(n, (int) (COPIAS_NOEFF / w));
+			long long suma_eff, suma_noeff;
+			VentanaDeslizante<MaxQueue<int>>(datos, n_noeff, w, suma_eff);
+			double t_noeff = VentanaDeslizante<MaxQueue_noeff<int>>(datos, n_noeff, w, suma_noeff);
+			cout << n_noeff / t_noeff << (suma_eff == suma_noeff ? "" : "\t(los maximos no coinciden)");
+		}
+		else
+			cout << "-";
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file cola_max_spsc_medida.cpp
+ * @brief Fichero usado para medir el rendimiento de MaxQueueSPSC frente a una MaxQueue protegida con un cerrojo
+ *
+ * Un hilo productor añade @e n enteros aleatorios a la cola y otro hilo consumidor los va eliminando,
+ * consultando antes el frente y el máximo. Se mide el tiempo hasta que el consumidor ha eliminado todos.
+ *
+ * Se compara MaxQueueSPSC, que no usa cerrojos, con una MaxQueue en la que cada operación se hace
+ * bajo un mutex compartido por los dos hilos, que es como había que usarla hasta ahora.
+ * Para que ambas guarden como mucho los mismos elementos, el productor de la MaxQueue también
+ * espera cuando la cola alcanza la capacidad.
+ *
+ * Los resultados se muestran en millones de elementos por segundo. Con un único núcleo
+ * los dos hilos se turnan, así que lo que se mide es sobre todo el coste de cada operación.
+ *
+ * @param NumeroDeElementos Número de elementos. Opcional, por defecto 10^7.
+ * @param Capacidad Capacidad de la cola. Opcional, por defecto 1024.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./cola_max_spsc_medida 10000000 1024
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include "maxqueue.h"
+#include "maxqueue_spsc.h"
+
+using namespace std;
+
+/**
+ * @brief MaxQueue con todas sus operaciones protegidas por un mutex
+ *
+ * Ofrece la misma interfaz que MaxQueueSPSC, para poder medir ambas con el mismo código.
+ */
+class MaxQueueMutex {
+private:
+	/**
+	 * @brief Cola con máximo.
+	 */
+	MaxQueue<int> cola;
+
+	/**
+	 * @brief Cerrojo que protege la cola.
+	 */
+	mutable mutex cerrojo;
+
+	/**
+	 * @brief Número máximo de elementos.
+	 */
+	size_t capacidad;
+
+public:
+	/**
+	 * @brief Constructor de la clase.
+	 * @param capacidad Número máximo de elementos.
+	 */
+	explicit MaxQueueMutex(size_t capacidad) : capacidad(capacidad) {}
+
+	/**
+	 * @brief Añade en el final de la cola si no está llena.
+	 * @param elem Elemento a añadir.
+	 * @return Si se ha añadido.
+	 */
+	bool push(const int &elem) {
+		lock_guard<mutex> guarda(cerrojo);
+		if ((size_t) cola.size() >= capacidad)
+			return false;
+		cola.push(elem);
+		return true;
+	}
+
+	/**
+	 * @brief Consulta el frente de la cola y su máximo.
+	 * @param frente Parámetro de salida con el frente y el máximo.
+	 * @return Si la cola tenía algún elemento.
+	 */
+	bool front(pair<int,int> &frente) {
+		lock_guard<mutex> guarda(cerrojo);
+		if (cola.empty())
+			return false;
+		frente = cola.front();
+		return true;
+	}
+
+	/**
+	 * @brief Elimina el frente de la cola.
+	 * @return Si se ha eliminado.
+	 */
+	bool pop() {
+		lock_guard<mutex> guarda(cerrojo);
+		if (cola.empty())
+			return false;
+		cola.pop();
+		return true;
+	}
+};
+
+/**
+ * @brief Añade los datos a la cola, esperando cuando está llena
+ * @tparam Cola MaxQueueSPSC<int> o MaxQueueMutex
+ * @param cola Cola compartida
+ * @param datos Elementos a añadir
+ */
+template <class Cola>
+void Productor(Cola &cola, const vector<int> &datos) {
+	for (size_t i = 0; i < datos.size(); i++)
+		while (!cola.push(datos[i]))
+			this_thread::yield();
+}
+
+/**
+ * @brief Mide el tiempo de pasar todos los datos de un hilo a otro a través de una cola
+ * @tparam Cola MaxQueueSPSC<int> o MaxQueueMutex
+ * @param datos Elementos a añadir
+ * @param capacidad Capacidad de la cola
+ * @param suma Parámetro de salida con la suma de los máximos consultados
+ * @return Tiempo empleado, en segundos
+ */
+template <class Cola>
+double Medir(const vector<int> &datos, size_t capacidad, long long &suma) {
+	Cola cola(capacidad);
+	suma = 0;
+
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	thread productor(Productor<Cola>, ref(cola), cref(datos));
+
+	pair<int,int> frente;
+	for (size_t eliminados = 0; eliminados < datos.size(); ) {
+		if (cola.front(frente)) {
+			suma += frente.second;
+			cola.pop();
+			eliminados++;
+		}
+		else
+			this_thread::yield();
+	}
+
+	productor.join();
+	chrono::steady_clock::time_point tfin = chrono::steady_clock::now();
+
+	return chrono::duration<double>(tfin - tini).count();
+}
+
+int main(int argc, char *argv[]) {
+	long long n = (argc > 1) ? atoll(argv[1]) : 10000000;
+	long long capacidad = (argc > 2) ? atoll(argv[2]) : 1024;
+
+	if (argc > 3 || n <= 0 || capacidad <= 0) {
+		cerr << "Uso: cola_max_spsc_medida [NumeroDeElementos] [Capacidad]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	vector<int> datos(n);
+	for (long long i = 0; i < n; i++)
+		datos[i] = rand();
+
+	// La capacidad efectiva de MaxQueueSPSC es una potencia de 2: usamos la misma en ambas
+	size_t cap = MaxQueueSPSC<int>(capacidad).capacity();
+
+	long long suma_spsc, suma_mutex;
+	double t_spsc = Medir<MaxQueueSPSC<int>>(datos, cap, suma_spsc);
+	double t_mutex = Medir<MaxQueueMutex>(datos, cap, suma_mutex);
+
+	cout << "Elementos: " << n << ", capacidad: " << cap << " (millones de elementos por segundo)" << endl;
+	cout << "MaxQueueSPSC:\t" << n / t_spsc / 1e6 << endl;
+	cout << "MaxQueue+mutex:\t" << n / t_mutex / 1e6 << endl;
+	cout << "Hilos disponibles: " << thread::hardware_concurrency() << endl;
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file cola_max_spsc_prueba.cpp
+ * @brief Prueba de estrés de MaxQueueSPSC con un productor y un consumidor concurrentes.
+ *
+ * Un hilo productor añade a una MaxQueueSPSC pequeña una secuencia pseudoaleatoria de enteros,
+ * reintentando cuando está llena. El hilo principal, que hace de consumidor, va eliminando
+ * elementos (a veces varios seguidos, a veces ninguno) y comprueba cada frente:
+ *  - El elemento del frente es el siguiente de la secuencia.
+ *  - El máximo está entre el de los elementos publicados antes de consultarlo y el de los
+ *    publicados después. Ambos se calculan con una MaxQueue a partir de la misma secuencia.
+ *
+ * Al terminar muestra el número de comprobaciones y de errores. Devuelve 0 si no hay errores.
+ *
+ * @param NumeroDeElementos Número de elementos que añade el productor. Opcional, por defecto 10^7.
+ * @param Capacidad Capacidad de la cola. Opcional, por defecto 64.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./cola_max_spsc_prueba 10000000 64
+ * Comprobaciones: 10000000, errores: 0
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <thread>
+#include "maxqueue.h"
+#include "maxqueue_spsc.h"
+
+using namespace std;
+
+/**
+ * @brief Elemento número @a i de la secuencia que añade el productor
+ *
+ * Es una función de @a i para que el consumidor pueda calcularla sin comunicarse con el productor.
+ *
+ * @param i Número del elemento
+ * @return Valor del elemento, entre 0 y 9999
+ */
+int Elemento(size_t i) {
+	unsigned long long x = i * 0x9E3779B97F4A7C15ull;
+	x ^= x >> 29;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 32;
+	return (int) (x % 10000);
+}
+
+/**
+ * @brief Añade a la cola los elementos de la secuencia
+ * @param cola Cola compartida
+ * @param n Número de elementos a añadir
+ */
+void Productor(MaxQueueSPSC<int> &cola, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		while (!cola.push(Elemento(i)))
+			this_thread::yield();
+}
+
+int main(int argc, char *argv[]) {
+	long long n = (argc > 1) ? atoll(argv[1]) : 10000000;
+	long long capacidad = (argc > 2) ? atoll(argv[2]) : 64;
+
+	if (argc > 3 || n <= 0 || capacidad <= 0) {
+		cerr << "Uso: cola_max_spsc_prueba [NumeroDeElementos] [Capacidad]" << endl;
+		return 1;
+	}
+
+	MaxQueueSPSC<int> cola(capacidad);
+	thread productor(Productor, ref(cola), (size_t) n);
+
+	// Referencia: los elementos de la secuencia desde el frente hasta el último que sabemos publicado
+	MaxQueue<int> referencia;
+	size_t cabeza = 0, publicados = 0;
+	long long comprobaciones = 0, errores = 0;
+	unsigned semilla = 1;
+
+	while (cabeza < (size_t) n) {
+		// Publicados antes de consultar el frente: al menos estos están en la cola
+		size_t antes = cabeza + cola.size();
+		for (; publicados < antes; publicados++)
+			referencia.push(Elemento(publicados));
+		int minimo = referencia.empty() ? -1 : referencia.front().second;
+
+		pair<int,int> frente;
+		if (!cola.front(frente)) {
+			this_thread::yield();
+			continue;
+		}
+
+		// Publicados después: como mucho estos estaban en la cola al consultarla
+		size_t despues = cabeza + cola.size();
+		for (; publicados < despues; publicados++)
+			referencia.push(Elemento(publicados));
+		int maximo = referencia.front().second;
+
+		comprobaciones++;
+		if (frente.first != Elemento(cabeza) || frente.second < minimo || frente.second > maximo) {
+			if (errores < 10)
+				cerr << "Error en el elemento " << cabeza << ": (" << frente.first << ", " << frente.second
+					 << "), se esperaba (" << Elemento(cabeza) << ", [" << minimo << ", " << maximo << "])" << endl;
+			errores++;
+		}
+
+		// Eliminamos entre 0 y 3 elementos
+		semilla = semilla * 1103515245u + 12345u;
+		int eliminar = (semilla >> 16) % 4;
+		for (int k = 0; k < eliminar && cabeza < (size_t) n && cola.pop(); k++) {
+			if (publicados == cabeza)
+				referencia.push(Elemento(publicados++));
+			referencia.pop();
+			cabeza++;
+		}
+	}
+
+	productor.join();
+
+	cout << "Comprobaciones: " << comprobaciones << ", errores: " << errores << endl;
+	return (errores == 0) ? 0 : 1;
+}
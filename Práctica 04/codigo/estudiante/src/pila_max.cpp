@@ -14,16 +14,15 @@
  *
  * La salida será:
  * @code{.sh}
- * (1, 2)
- * (2, 4)
- * (3, 4)
+ * (2, 2)
  * (4, 4)
+ * (3, 3)
+ * (1, 1)
  * @endcode
  */
 
 #include <iostream>
 #include "maxstack.h"
-#include "maxstack.cpp"
 
 using namespace std;
 
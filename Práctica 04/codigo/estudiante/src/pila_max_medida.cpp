@@ -0,0 +1,173 @@
+/**
+ * @file pila_max_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de MaxStack
+ *
+ * Realiza una secuencia aleatoria de operaciones sobre una pila de enteros: en cada paso
+ * inserta o elimina (con la misma probabilidad) un elemento y consulta el tope y el máximo.
+ * La pila nunca pasa de una profundidad máxima: si la alcanza, se elimina.
+ *
+ * Compara MaxStack, implementada sobre un vector (O(1) por operación), con MaxStack_noeff,
+ * la implementación anterior, que en cada inserción rota toda la cola que guarda la pila
+ * (O(n) por inserción). Para cada profundidad máxima, de 10 a 10^6, muestra las operaciones
+ * por segundo con cada una y comprueba que obtienen los mismos resultados.
+ *
+ * Como MaxStack_noeff es O(n) por inserción, con ella sólo se hacen las operaciones necesarias
+ * para unas 2*10^8 copias de elementos, y a partir de profundidades de 10^5 no se mide.
+ *
+ * @param NumeroDeOperaciones Número de operaciones. Opcional, por defecto 10^7.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./pila_max_medida 10000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <queue>
+#include <vector>
+#include "maxstack.h"
+
+using namespace std;
+
+/**
+ * @brief Implementación anterior de MaxStack, con una cola y una cola auxiliar
+ *
+ * El tope de la pila es el frente de la cola. Cada inserción vuelca la cola en la auxiliar,
+ * añade el nuevo elemento y vuelve a añadir los demás detrás de él.
+ * A diferencia de la original, no consulta el frente de la cola si está vacía.
+ */
+template <typename T>
+class MaxStack_noeff {
+private:
+	/**
+	 * @brief Cola empleada para almacenar la pila.
+	 */
+	queue<pair<T,T>> q;
+
+	/**
+	 * @brief Cola auxiliar para gestionar las inserciones.
+	 */
+	queue<pair<T,T>> aux;
+
+public:
+	/**
+	 * @brief Método que consulta el tope de la pila.
+	 * @return El tope de la pila.
+	 */
+	const pair<T,T>& top() const {return q.front();}
+
+	/**
+	 * @brief Elimina el tope de la pila.
+	 */
+	void pop() {q.pop();}
+
+	/**
+	 * @brief Método que calcula el número de elementos de una pila.
+	 * @return El número de elementos de la pila.
+	 */
+	int size() const {return q.size();}
+
+	/**
+	 * @brief Método que comprueba si la pila está vacía.
+	 * @return Si la pila está vacía.
+	 */
+	bool empty() const {return q.empty();}
+
+	/**
+	 * @brief Método que añade en el frente de la pila.
+	 * @param elem Elemento a añadir.
+	 */
+	void push(const T& elem) {
+		T new_max = (q.empty() || q.front().second < elem) ? elem : q.front().second;
+
+		while (!q.empty()) {
+			aux.push(q.front());
+			q.pop();
+		}
+
+		q.push(pair<T,T>(elem, new_max));
+
+		while (!aux.empty()) {
+			q.push(aux.front());
+			aux.pop();
+		}
+	}
+};
+
+/**
+ * @brief Realiza una secuencia de operaciones sobre una pila con máximo
+ * @tparam Pila MaxStack o MaxStack_noeff
+ * @param datos Elementos a insertar
+ * @param inserta Para cada operación, si es una inserción (true) o una eliminación (false)
+ * @param n Número de operaciones a realizar
+ * @param profundidad Profundidad máxima de la pila
+ * @param suma Parámetro de salida con la suma de los topes y máximos consultados
+ * @return Tiempo empleado, en segundos
+ */
+template <class Pila>
+double Operaciones(const vector<int> &datos, const vector<bool> &inserta, int n, int profundidad, long long &suma) {
+	Pila pila;
+	suma = 0;
+
+	clock_t tini = clock();
+	for (int i = 0; i < n; i++) {
+		if (pila.empty() || (inserta[i] && pila.size() < profundidad))
+			pila.push(datos[i]);
+		else
+			pila.pop();
+
+		if (!pila.empty())
+			suma += pila.top().first + pila.top().second;
+	}
+	clock_t tfin = clock();
+
+	return (tfin - tini) / (double) CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[]) {
+	int n = (argc > 1) ? atoi(argv[1]) : 10000000;
+
+	if (argc > 2 || n <= 0) {
+		cerr << "Uso: pila_max_medida [NumeroDeOperaciones]" << endl;
+		return 1;
+	}
+
+	const double COPIAS_NOEFF = 2e8;   // Trabajo máximo de MaxStack_noeff en cada profundidad
+	const int PROFUNDIDAD_MAX_NOEFF = 10000;
+
+	srand(1);
+	vector<int> datos(n);
+	vector<bool> inserta(n);
+	for (int i = 0; i < n; i++) {
+		datos[i] = rand() % 1000000;
+		// Algo más de inserciones que de eliminaciones, para que la pila llegue a la profundidad máxima
+		inserta[i] = rand() % 8 < 5;
+	}
+
+	cout << "Operaciones: " << n << " (operaciones por segundo)" << endl;
+	cout << "profundidad\tMaxStack\tMaxStack_noeff" << endl;
+
+	for (int profundidad = 10; profundidad <= 1000000; profundidad *= 10) {
+		long long suma;
+		double t = Operaciones<MaxStack<int>>(datos, inserta, n, profundidad, suma);
+		cout << profundidad << "\t" << n / t << "\t";
+
+		if (profundidad <= PROFUNDIDAD_MAX_NOEFF) {
+			// Hacemos con ambas las mismas operaciones para comparar los resultados
+			int n_noeff = min(n, (int) (COPIAS_NOEFF / profundidad));
+			long long suma_eff, suma_noeff;
+			Operaciones<MaxStack<int>>(datos, inserta, n_noeff, profundidad, suma_eff);
+			double t_noeff = Operaciones<MaxStack_noeff<int>>(datos, inserta, n_noeff, profundidad, suma_noeff);
+			cout << n_noeff / t_noeff << (suma_eff == suma_noeff ? "" : "\t(los resultados no coinciden)");
+		}
+		else
+			cout << "-";
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file pilas_colas_medida.cpp
+ * @brief Microbenchmark de MaxStack y MaxQueue
+ *
+ * Mide el tiempo medio, en nanosegundos, de cada operación de MaxStack y MaxQueue con enteros
+ * y con doubles. Cada prueba repite muchas veces un ciclo que llena la estructura hasta un
+ * tamaño dado, consultando el tope o el frente tras cada inserción, y después la vacía.
+ *
+ * Se compila dos veces:
+ *  - pilas_colas_medida, con la biblioteca de sólo cabeceras: las operaciones se pueden expandir en línea.
+ *  - pilas_colas_medida_lib, enlazado con las bibliotecas maxstack y maxqueue: usa sus instancias ya
+ *    compiladas, así que cada operación es una llamada a función, pero el programa compila antes.
+ *
+ * El objetivo @c medir de CMake ejecuta ambos.
+ *
+ * @param NumeroDeOperaciones Número de inserciones en cada prueba. Opcional, por defecto 10^7.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./pilas_colas_medida 10000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include "maxstack.h"
+#include "maxqueue.h"
+
+using namespace std;
+
+/**
+ * @brief Mide el tiempo medio de push(), top() y pop() de una MaxStack
+ * @tparam T Tipo de los elementos
+ * @param datos Elementos a insertar
+ * @param tam Número de elementos a los que se llena la pila en cada ciclo
+ * @param suma Parámetro de salida con la suma de los máximos consultados
+ * @return Nanosegundos por operación
+ */
+template <typename T>
+double MedirPila(const vector<T> &datos, size_t tam, T &suma) {
+	MaxStack<T> pila;
+	suma = T();
+
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	for (size_t i = 0; i < datos.size(); ) {
+		size_t fin = (datos.size() - i < tam) ? datos.size() : i + tam;
+		for (; i < fin; i++) {
+			pila.push(datos[i]);
+			suma += pila.top().second;
+		}
+		while (!pila.empty())
+			pila.pop();
+	}
+	chrono::steady_clock::time_point tfin = chrono::steady_clock::now();
+
+	// Cada elemento se inserta, se consulta y se elimina una vez
+	return chrono::duration<double, nano>(tfin - tini).count() / (3.0 * datos.size());
+}
+
+/**
+ * @brief Mide el tiempo medio de push(), front() y pop() de una MaxQueue
+ * @tparam T Tipo de los elementos
+ * @param datos Elementos a insertar
+ * @param tam Número de elementos a los que se llena la cola en cada ciclo
+ * @param suma Parámetro de salida con la suma de los máximos consultados
+ * @return Nanosegundos por operación
+ */
+template <typename T>
+double MedirCola(const vector<T> &datos, size_t tam, T &suma) {
+	MaxQueue<T> cola;
+	suma = T();
+
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	for (size_t i = 0; i < datos.size(); ) {
+		size_t fin = (datos.size() - i < tam) ? datos.size() : i + tam;
+		for (; i < fin; i++) {
+			cola.push(datos[i]);
+			suma += cola.front().second;
+		}
+		while (!cola.empty())
+			cola.pop();
+	}
+	chrono::steady_clock::time_point tfin = chrono::steady_clock::now();
+
+	return chrono::duration<double, nano>(tfin - tini).count() / (3.0 * datos.size());
+}
+
+/**
+ * @brief Mide ambas estructuras con varios tamaños
+ * @tparam T Tipo de los elementos
+ * @param datos Elementos a insertar
+ * @param nombre Nombre del tipo, para mostrarlo
+ */
+template <typename T>
+void Medir(const vector<T> &datos, const char *nombre) {
+	for (size_t tam = 16; tam <= 1048576; tam *= 256) {
+		T suma_pila, suma_cola;
+		double t_pila = MedirPila(datos, tam, suma_pila);
+		double t_cola = MedirCola(datos, tam, suma_cola);
+		cout << nombre << "\t" << tam << "\t" << t_pila << "\t" << t_cola << endl;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	long long n = (argc > 1) ? atoll(argv[1]) : 10000000;
+
+	if (argc > 2 || n <= 0) {
+		cerr << "Uso: pilas_colas_medida [NumeroDeOperaciones]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	vector<int> enteros(n);
+	vector<double> reales(n);
+	for (long long i = 0; i < n; i++) {
+		enteros[i] = rand() % 1000;
+		reales[i] = enteros[i] * 0.5;
+	}
+
+#ifdef MAXQUEUE_INSTANCIAS_EXTERNAS
+	cout << "Instancias de las bibliotecas maxstack y maxqueue" << endl;
+#else
+	cout << "Biblioteca de sólo cabeceras" << endl;
+#endif
+	cout << "Operaciones: " << n << " (nanosegundos por operación)" << endl;
+	cout << "tipo\ttamaño\tMaxStack\tMaxQueue" << endl;
+	Medir(enteros, "int");
+	Medir(reales, "double");
+
+	return 0;
+}
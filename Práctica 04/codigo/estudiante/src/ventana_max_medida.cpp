@@ -0,0 +1,112 @@
+/**
+ * @file ventana_max_medida.cpp
+ * @brief Fichero usado para medir sliding_max() frente a MaxQueue como máximo en ventana deslizante
+ *
+ * Genera una secuencia de números aleatorios y calcula el máximo de cada ventana de @e w muestras
+ * de tres formas:
+ *  - Con una MaxQueue, añadiendo las muestras una a una como en cola_max_medida.cpp.
+ *  - Con sliding_max() en un solo hilo.
+ *  - Con sliding_max() en tantos hilos como núcleos.
+ *
+ * Para cada tamaño de ventana, de 10 a 10^6, muestra los millones de muestras procesadas por segundo
+ * con cada una y comprueba que los resultados son idénticos a los de MaxQueue. Se mide con enteros
+ * y con números de coma flotante.
+ *
+ * @param NumeroDeMuestras Número de muestras de la secuencia. Opcional, por defecto 10^7.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./ventana_max_medida 10000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "maxqueue.h"
+
+using namespace std;
+
+/**
+ * @brief Calcula el máximo de cada ventana añadiendo las muestras una a una a una MaxQueue
+ * @tparam T Tipo de las muestras
+ * @param datos Secuencia
+ * @param w Tamaño de la ventana
+ * @param out Parámetro de salida con el máximo de la ventana que acaba en cada muestra
+ */
+template <typename T>
+void VentanaMaxQueue(const vector<T> &datos, size_t w, vector<T> &out) {
+	MaxQueue<T> cola;
+	for (size_t i = 0; i < datos.size(); i++) {
+		cola.push(datos[i]);
+		if ((size_t) cola.size() > w)
+			cola.pop();
+		out[i] = cola.front().second;
+	}
+}
+
+/**
+ * @brief Mide las tres formas de calcular el máximo en ventana para cada tamaño de ventana
+ * @tparam T Tipo de las muestras
+ * @param datos Secuencia
+ * @param nombre Nombre del tipo, para mostrarlo
+ */
+template <typename T>
+void Medir(const vector<T> &datos, const char *nombre) {
+	size_t n = datos.size();
+	vector<T> referencia(n), out(n);
+
+	cout << nombre << endl;
+	cout << "ventana\tMaxQueue\tsliding_max(1)\tsliding_max(" << thread::hardware_concurrency() << ")" << endl;
+
+	for (size_t w = 10; w <= 1000000; w *= 10) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		VentanaMaxQueue(datos, w, referencia);
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		sliding_max(datos.data(), n, w, out.data(), 1);
+		chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+		bool iguales = memcmp(referencia.data(), out.data(), n * sizeof(T)) == 0;
+		fill(out.begin(), out.end(), T());
+		chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+		sliding_max(datos.data(), n, w, out.data());
+		chrono::steady_clock::time_point t4 = chrono::steady_clock::now();
+		iguales = iguales && memcmp(referencia.data(), out.data(), n * sizeof(T)) == 0;
+
+		cout << w << "\t" << n / chrono::duration<double>(t1 - t0).count() / 1e6
+			 << "\t" << n / chrono::duration<double>(t2 - t1).count() / 1e6
+			 << "\t" << n / chrono::duration<double>(t4 - t3).count() / 1e6
+			 << (iguales ? "" : "\t(los maximos no coinciden)") << endl;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	long long n = (argc > 1) ? atoll(argv[1]) : 10000000;
+
+	if (argc > 2 || n <= 0) {
+		cerr << "Uso: ventana_max_medida [NumeroDeMuestras]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	vector<int> enteros(n);
+	vector<float> reales(n);
+	for (long long i = 0; i < n; i++) {
+		enteros[i] = rand();
+		// Con pocos valores distintos hay muchos empates, incluidos 0 y -0
+		reales[i] = (rand() % 2001 - 1000) * 0.5f;
+		if (reales[i] == 0 && rand() % 2)
+			reales[i] = -0.0f;
+	}
+
+	cout << "Muestras: " << n << " (millones de muestras por segundo)" << endl;
+	Medir(enteros, "int");
+	Medir(reales, "float");
+
+	return 0;
+}
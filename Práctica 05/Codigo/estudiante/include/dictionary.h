@@ -12,6 +12,9 @@
 #include <set>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include "vectorpalabras.h"
+#include "triepalabras.h"
 
 using namespace std;
 
@@ -20,14 +23,106 @@ using namespace std;
  *
  * Una instancia @e d del tipo de dato abstracto Dictionary sobre el tipo @c string es un objeto
  * formado por un conjunto de palabras de tipo @c string ordenadas alfabéticamente no repetidas.
+ *
+ * Las palabras se guardan en un set<string> mientras se modifica el diccionario. Cuando ya no se van
+ * a modificar, como tras cargarlo de un fichero, se puede congelar con freeze() en una representación
+ * de sólo lectura que ocupa menos y en la que las búsquedas son más rápidas (ver Representacion).
+ * Todas las operaciones se pueden usar con cualquier representación; insertar o borrar una palabra
+ * en un diccionario congelado lo vuelve a pasar al conjunto.
+ *
+ * wordsOfLength() y getOcurrences() usan índices que se construyen al cargar o congelar el
+ * diccionario y que se mantienen al insertar y borrar, así que las consultas no modifican nada.
  */
 
 class Dictionary {
+public:
+	/**
+	 * @brief Representación de las palabras del diccionario
+	 */
+	enum Representacion {
+		CONJUNTO,           ///< set<string>: admite inserciones y borrados en O(log n)
+		VECTOR_ORDENADO,    ///< VectorPalabras: sólo lectura, búsqueda binaria en un vector contiguo
+		TRIE                ///< TriePalabras: sólo lectura, los prefijos comunes se guardan una vez
+	};
+
 private:
 	/**
 	 * @brief Conjunto de palabras ordenadas alfabéticamente no repetidas.
+	 *
+	 * Vacío si el diccionario está congelado.
 	 */
     set <string> words;
+
+	/**
+	 * @brief Representación actual de las palabras.
+	 */
+	Representacion representacion;
+
+	/**
+	 * @brief Palabras si la representación es VECTOR_ORDENADO. Si no, vacío.
+	 */
+	VectorPalabras vector_ordenado;
+
+	/**
+	 * @brief Palabras si la representación es TRIE. Si no, vacío.
+	 */
+	TriePalabras trie;
+
+	/**
+	 * @brief Orden de los iteradores del conjunto: el de las palabras a las que apuntan.
+	 */
+	struct OrdenIteradores {
+		bool operator()(set<string>::iterator a, set<string>::iterator b) const {return *a < *b;}
+	};
+
+	/**
+	 * @brief Índice por longitud si la representación es CONJUNTO: la posición i tiene las palabras
+	 * de longitud i, en orden.
+	 */
+	vector<set<set<string>::iterator, OrdenIteradores>> longitudes_conjunto;
+
+	/**
+	 * @brief Índice por longitud si el diccionario está congelado: las posiciones de las palabras
+	 * ordenadas por longitud y, con la misma longitud, alfabéticamente.
+	 *
+	 * Las de longitud i van de longitudes_inicio[i] a longitudes_inicio[i+1].
+	 */
+	vector<uint32_t> longitudes_palabras;
+
+	/**
+	 * @brief Comienzo de las palabras de cada longitud en @a longitudes_palabras, más uno final.
+	 */
+	vector<uint32_t> longitudes_inicio;
+
+	/**
+	 * @brief Apariciones de cada carácter, indexado como unsigned char, en todas las palabras.
+	 */
+	size_t apariciones[256];
+
+	/**
+	 * @brief Construye el índice de palabras por longitud de la representación actual recorriendo todas las palabras.
+	 */
+	void IndexarLongitudes();
+
+	/**
+	 * @brief Suma o resta a las apariciones de cada carácter las de una palabra.
+	 * @param s  Palabra.
+	 * @param signo  1 si se ha insertado, -1 si se ha borrado.
+	 */
+	void ContarCaracteres(const string &s, int signo);
+
+	/**
+	 * @brief Elimina todas las palabras y el índice por longitud, pero no las apariciones de cada carácter.
+	 * @post La representación es CONJUNTO.
+	 */
+	void VaciarPalabras();
+
+	/**
+	 * @brief Pasa las palabras de la representación congelada al conjunto.
+	 * @post La representación es CONJUNTO.
+	 */
+	void Descongelar();
+
 public:
 	/**
 	 * @brief Constructor por defecto de la clase.
@@ -44,8 +139,19 @@ public:
 	 */
     Dictionary(const Dictionary& othr);
 
+	/**
+	 * @brief Operador de asignación.
+	 * @param othr  Diccionario a copiar.
+	 * @return Referencia a este diccionario.
+	 */
+	Dictionary& operator=(const Dictionary& othr);
+
 	/**
 	 * @brief Constructor de la clase a partir de un fichero.
+	 *
+	 * Si no se puede abrir el fichero, muestra un mensaje de error y crea un diccionario vacío.
+	 * Para saber si se ha cargado, usar LoadDictionary().
+	 *
 	 * @param file_name Nombre del fichero.
 	 */
 	Dictionary	(const string & file_name);
@@ -61,6 +167,9 @@ public:
 
 	/**
 	 * @brief Inserta una palabra en el diccionario.
+	 *
+	 * Si está congelado y la palabra no existía, se pasa antes a la representación CONJUNTO, en O(n).
+	 *
 	 * @param s  Palabra a insertar.
 	 * @retval true Si la palabra se ha insertado (no existía).
 	 * @retval false Si la palabra no se ha insertado (ya existía).
@@ -69,6 +178,9 @@ public:
 
 	/**
 	 * @brief Borra un elemento del diccionario.
+	 *
+	 * Si está congelado y la palabra existía, se pasa antes a la representación CONJUNTO, en O(n).
+	 *
 	 * @param s  Palabra a borrar.
 	 * @retval true Si la palabra se ha borrado (ya existía).
 	 * @retval false Si la palabra no se ha borrado.
@@ -80,7 +192,7 @@ public:
 	 *
 	 * Elimina todos los elementos del diccionario, dejándolo vacío.
 	 *
-	 * @post El diccionario es vacío.
+	 * @post El diccionario es vacío y su representación es CONJUNTO.
 	 */
     void clear();
 
@@ -100,6 +212,9 @@ public:
 
 	/**
 	 * @brief Devuelve un vector con las palabras de una longitud dada.
+	 *
+	 * O(número de palabras devueltas).
+	 *
 	 * @param length  Longitud de las palabras a buscar.
 	 * @return  Vector con las palabras de la longitud dada.
 	 */
@@ -107,6 +222,9 @@ public:
 
 	/**
 	 * @brief Devuelve el número de ocurrencias de un carácter en el diccionario.
+	 *
+	 * O(1).
+	 *
 	 * @param c  Carácter a buscar.
 	 * @return  Número de ocurrencias del carácter en el diccionario.
 	 */
@@ -137,16 +255,29 @@ public:
 
 	/**
 	 * @brief Clase para iterar sobre el diccionario
+	 *
+	 * Si el diccionario está congelado, la palabra actual se copia en el iterador al avanzar,
+	 * porque la representación no guarda las palabras como string.
 	 */
 	class iterator{
 		private:
+			const Dictionary *dic;
 			set<string>::iterator it;
+			size_t pos;
+			string palabra;
+			void Leer();
 		public:
-			iterator & operator++(){++it;return *this;}
-			iterator & operator--(){--it;return *this;}
-			bool operator==(const iterator &i) const{return it==i.it;}
-			bool operator!=(const iterator &i) const{return it!=i.it;}
-			const string& operator* (){return *it;}
+			iterator & operator++(){
+				if (dic->representacion == CONJUNTO) ++it; else {++pos; Leer();}
+				return *this;
+			}
+			iterator & operator--(){
+				if (dic->representacion == CONJUNTO) --it; else {--pos; Leer();}
+				return *this;
+			}
+			bool operator==(const iterator &i) const{return it==i.it && pos==i.pos;}
+			bool operator!=(const iterator &i) const{return it!=i.it || pos!=i.pos;}
+			const string& operator* (){return (dic->representacion == CONJUNTO) ? *it : palabra;}
 			friend class Dictionary;
 	};
 
@@ -156,7 +287,10 @@ public:
 	 */
 	iterator begin() const {
 		iterator i;
+		i.dic = this;
 		i.it = words.begin();
+		i.pos = 0;
+		i.Leer();
 		return i;
 	}
 
@@ -166,17 +300,47 @@ public:
 	 */
 	iterator end() const {
 		iterator i;
+		i.dic = this;
 		i.it = words.end();
+		i.pos = (representacion == CONJUNTO) ? 0 : size();
 		return i;
 	}
 
-private:
+	/**
+	 * @brief Congela el diccionario en una representación de sólo lectura, o lo descongela.
+	 *
+	 * Es O(n), incluida la reconstrucción del índice por longitud, y deja de ocupar memoria la
+	 * representación anterior. Conviene tras cargar todas las palabras, si después sólo se van a consultar.
+	 *
+	 * @param r  Representación nueva. CONJUNTO descongela el diccionario.
+	 * @retval true Si se ha cambiado la representación.
+	 * @retval false Si hay demasiados caracteres para VectorPalabras (VectorPalabras::MAX_CARACTERES).
+	 * No se cambia la representación.
+	 */
+	bool freeze(Representacion r = VECTOR_ORDENADO);
 
 	/**
-	 * @brief Carga el diccionario desde un fichero.
+	 * @brief Devuelve la representación de las palabras del diccionario.
+	 * @return  La representación actual.
+	 */
+	Representacion getRepresentation() const {return representacion;}
+
+	/**
+	 * @brief Carga el diccionario desde un fichero, sustituyendo su contenido.
+	 *
+	 * Las palabras del fichero son las secuencias de caracteres separadas por blancos, como las
+	 * que lee operator>>. Se hace en bloque: el fichero se proyecta en memoria, se separan las
+	 * palabras sin copiarlas, se ordenan y se eliminan las repetidas repartiendo el fichero entre
+	 * varios hilos, y se copian en orden en un VectorPalabras: el diccionario queda congelado con
+	 * la representación VECTOR_ORDENADO, sin reservar memoria para cada palabra. Al final se
+	 * construyen el índice por longitud y las apariciones de cada carácter.
+	 *
 	 * @param file_name  Nombre del fichero.
+	 * @param hilos  Número de hilos. Si es 0, tantos como núcleos, siempre que cada uno tenga trabajo suficiente.
+	 * @retval true Si se ha cargado.
+	 * @retval false Si no se ha podido abrir el fichero. Se muestra un mensaje de error y el diccionario queda vacío.
 	 */
-	void LoadDictionary(const string &file_name);
+	bool LoadDictionary(const string &file_name, unsigned hilos = 0);
 };
 
 
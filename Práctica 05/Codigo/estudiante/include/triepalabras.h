@@ -0,0 +1,122 @@
+/**
+ * @file triepalabras.h
+ * @brief Trie compacto de palabras
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef __TRIE_PALABRAS_H__
+#define __TRIE_PALABRAS_H__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "vectorpalabras.h"
+
+using namespace std;
+
+/**
+ * @brief Trie compacto (árbol radix) de palabras, de sólo lectura
+ *
+ * Es una de las representaciones de Dictionary tras congelarlo (Dictionary::freeze()).
+ * Cada nodo representa el prefijo formado por las etiquetas del camino desde la raíz, y los nodos
+ * con un solo hijo que no son final de palabra se funden con él, así que cada etiqueta puede
+ * tener varios caracteres. Los prefijos comunes se guardan una sola vez.
+ *
+ * Los nodos están en un vector por niveles, de forma que los hijos de un nodo son consecutivos y
+ * van justo detrás de los del nodo anterior: basta guardar el primer hijo de cada nodo. El primer
+ * carácter de la etiqueta de cada nodo está además en otro vector, así que elegir el hijo por el
+ * que seguir sólo recorre unos pocos bytes contiguos.
+ *
+ * No se comparten los sufijos (no es un DAWG): así cada nodo tiene un único padre y se puede
+ * reconstruir la palabra de un nodo final subiendo hasta la raíz, que es como se recorren en orden.
+ */
+class TriePalabras {
+private:
+	/**
+	 * @brief Nodo del trie
+	 */
+	struct Nodo {
+		uint32_t etiqueta;      ///< Comienzo de la etiqueta en @a etiquetas
+		uint32_t tam : 31;      ///< Número de caracteres de la etiqueta
+		uint32_t terminal : 1;  ///< Si el prefijo del nodo es una palabra
+		uint32_t primer_hijo;   ///< Índice del primer hijo. Los hijos llegan hasta el primer hijo del nodo siguiente
+		uint32_t padre;         ///< Índice del padre. El de la raíz es ella misma
+	};
+
+	/**
+	 * @brief Nodos por niveles. El primero es la raíz, con etiqueta vacía.
+	 */
+	vector<Nodo> nodos;
+
+	/**
+	 * @brief Primer carácter de la etiqueta de cada nodo. El de la raíz no se usa.
+	 */
+	vector<unsigned char> primeros;
+
+	/**
+	 * @brief Caracteres de todas las etiquetas, seguidos.
+	 */
+	string etiquetas;
+
+	/**
+	 * @brief Nodos finales de palabra, en el orden de sus palabras.
+	 */
+	vector<uint32_t> terminales;
+
+public:
+	/**
+	 * @brief Constructor por defecto. Crea un trie vacío.
+	 */
+	TriePalabras();
+
+	/**
+	 * @brief Construye el trie con las palabras de un vector, sustituyendo su contenido
+	 * @param v Vector de palabras
+	 */
+	void Construir(const VectorPalabras &v);
+
+	/**
+	 * @brief Busca una palabra
+	 * @param s Palabra
+	 * @retval true Si está en el trie.
+	 * @retval false Si no está.
+	 */
+	bool Existe(const string &s) const;
+
+	/**
+	 * @brief Número de palabras
+	 * @return El número de palabras
+	 */
+	size_t Tamanio() const { return terminales.size(); }
+
+	/**
+	 * @brief Longitud de una palabra
+	 *
+	 * Sube desde su nodo hasta la raíz: es O(profundidad del nodo).
+	 *
+	 * @param i Índice de la palabra
+	 * @return El número de caracteres de la palabra i-ésima en orden
+	 * @pre i < Tamanio()
+	 */
+	size_t Longitud(size_t i) const;
+
+	/**
+	 * @brief Consulta una palabra
+	 *
+	 * La reconstruye subiendo desde su nodo hasta la raíz: es O(longitud).
+	 *
+	 * @param i Índice de la palabra
+	 * @return La palabra i-ésima en orden
+	 * @pre i < Tamanio()
+	 */
+	string Palabra(size_t i) const;
+
+	/**
+	 * @brief Elimina todas las palabras y libera su memoria
+	 */
+	void Vaciar();
+};
+
+#endif
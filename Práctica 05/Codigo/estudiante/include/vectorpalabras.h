@@ -0,0 +1,172 @@
+/**
+ * @file vectorpalabras.h
+ * @brief Vector ordenado de palabras guardadas en un único bloque de caracteres
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef __VECTOR_PALABRAS_H__
+#define __VECTOR_PALABRAS_H__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Vector ordenado de palabras, sin repetir, de sólo lectura
+ *
+ * Es una de las representaciones de Dictionary tras congelarlo (Dictionary::freeze()).
+ * Los caracteres de todas las palabras están seguidos en una sola cadena, y de cada palabra sólo se
+ * guarda dónde empieza en ella y sus 8 primeros caracteres empaquetados en un entero. Frente a un
+ * set<string>, no hay un nodo ni una reserva de memoria por palabra, y la búsqueda binaria recorre
+ * el vector de prefijos, que es contiguo: sólo va a la cadena cuando hay palabras con el mismo prefijo.
+ *
+ * Se construye añadiendo las palabras en orden con Anadir().
+ *
+ * @invariant Las palabras están ordenadas como string y no hay repetidas.
+ */
+class VectorPalabras {
+public:
+	/**
+	 * @brief Tipo de las posiciones en la cadena de caracteres.
+	 *
+	 * De 32 bits para que el índice ocupe poco: el total de caracteres no puede llegar a MAX_CARACTERES.
+	 */
+	typedef uint32_t Posicion;
+
+	/**
+	 * @brief Máximo número de caracteres, contando todas las palabras, que se pueden guardar.
+	 */
+	static const size_t MAX_CARACTERES = UINT32_MAX;
+
+private:
+	/**
+	 * @brief Caracteres de todas las palabras, seguidos y en orden.
+	 */
+	string caracteres;
+
+	/**
+	 * @brief Comienzo de cada palabra en @a caracteres, más uno final con el total de caracteres.
+	 *
+	 * La palabra i ocupa [inicio[i], inicio[i+1]).
+	 */
+	vector<Posicion> inicio;
+
+	/**
+	 * @brief 8 primeros caracteres de cada palabra, el primero en el byte más significativo,
+	 * completados con ceros.
+	 *
+	 * Comparar dos prefijos es comparar esos caracteres como los compara string.
+	 */
+	vector<uint64_t> prefijos;
+
+	/**
+	 * @brief Compara una palabra del vector con otra cadena
+	 * @param i Índice de la palabra
+	 * @param s Cadena
+	 * @param n Número de caracteres de la cadena
+	 * @return Negativo, cero o positivo si la palabra es menor, igual o mayor que la cadena
+	 * @pre Los prefijos coinciden
+	 */
+	int Comparar(size_t i, const char *s, size_t n) const;
+
+public:
+	/**
+	 * @brief Constructor por defecto. Crea un vector vacío.
+	 */
+	VectorPalabras();
+
+	/**
+	 * @brief Empaqueta los 8 primeros caracteres de una cadena
+	 * @param s Cadena
+	 * @param n Número de caracteres de la cadena
+	 * @return Los caracteres, el primero en el byte más significativo, completados con ceros
+	 */
+	static uint64_t Prefijo(const char *s, size_t n);
+
+	/**
+	 * @brief Reserva memoria para las palabras que se van a añadir
+	 * @param palabras Número de palabras
+	 * @param caracteres Número total de caracteres
+	 */
+	void Reservar(size_t palabras, size_t caracteres);
+
+	/**
+	 * @brief Añade una palabra al final
+	 * @param s Caracteres de la palabra
+	 * @param n Número de caracteres
+	 * @pre La palabra es mayor que todas las que ya hay.
+	 * @pre El total de caracteres no llega a MAX_CARACTERES.
+	 */
+	void Anadir(const char *s, size_t n);
+
+	/**
+	 * @brief Libera la memoria sobrante tras añadir todas las palabras
+	 */
+	void Ajustar();
+
+	/**
+	 * @brief Busca una palabra
+	 * @param s Palabra
+	 * @retval true Si está en el vector.
+	 * @retval false Si no está.
+	 */
+	bool Existe(const string &s) const;
+
+	/**
+	 * @brief Cuenta las apariciones de cada carácter en todas las palabras
+	 *
+	 * Recorre una sola vez la cadena con todos los caracteres.
+	 *
+	 * @param apariciones Parámetro de salida con las apariciones de cada carácter, indexado como unsigned char
+	 */
+	void Apariciones(size_t apariciones[256]) const;
+
+	/**
+	 * @brief Número de palabras
+	 * @return El número de palabras
+	 */
+	size_t Tamanio() const { return prefijos.size(); }
+
+	/**
+	 * @brief Número total de caracteres de las palabras
+	 * @return El número de caracteres
+	 */
+	size_t Caracteres() const { return caracteres.size(); }
+
+	/**
+	 * @brief Consulta una palabra
+	 * @param i Índice de la palabra
+	 * @return La palabra i-ésima en orden
+	 * @pre i < Tamanio()
+	 */
+	string Palabra(size_t i) const {
+		return caracteres.substr(inicio[i], inicio[i+1] - inicio[i]);
+	}
+
+	/**
+	 * @brief Primer carácter de una palabra
+	 * @param i Índice de la palabra
+	 * @return Puntero al primer carácter de la palabra i-ésima, seguido de los de las siguientes
+	 * @pre i < Tamanio()
+	 */
+	const char *Datos(size_t i) const { return caracteres.data() + inicio[i]; }
+
+	/**
+	 * @brief Longitud de una palabra
+	 * @param i Índice de la palabra
+	 * @return El número de caracteres de la palabra i-ésima
+	 * @pre i < Tamanio()
+	 */
+	size_t Longitud(size_t i) const { return inicio[i+1] - inicio[i]; }
+
+	/**
+	 * @brief Elimina todas las palabras y libera su memoria
+	 */
+	void Vaciar();
+};
+
+#endif
@@ -20,7 +20,9 @@ int main(int argc, char* argv[]) {
 
     char char_to_find = *argv[2]; // Como es un puntero a char que guarda el caracter, deferenciamos
 
-    Dictionary dic(argv[1]);
+    Dictionary dic;
+    if (!dic.LoadDictionary(argv[1]))
+        return 1;
 
     cout << "El carácter " << char_to_find << " aparece " << dic.getOcurrences(char_to_find) << " veces en el diccionario "
          << argv[0] << "." << endl;
@@ -0,0 +1,116 @@
+/**
+ * @file carga_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de la carga de un diccionario
+ *
+ * Genera un fichero con palabras aleatorias, desordenadas y con repeticiones, y compara el tiempo de
+ * cargarlo como se hacía antes (extracciones con operator>> de un flujo, insertando cada palabra en
+ * el conjunto) con Dictionary::LoadDictionary(), con uno y con varios hilos. Comprueba que los tres
+ * diccionarios tienen las mismas palabras.
+ *
+ * El fichero se crea en el directorio actual y se borra al terminar.
+ *
+ * @param NumeroDePalabras Número de palabras del fichero. Opcional, por defecto 5000000.
+ * @param NumeroDeHilos Número de hilos de la carga en paralelo. Opcional, por defecto los que tenga la máquina.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./carga_medida 5000000 4
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <string>
+#include "dictionary.h"
+
+using namespace std;
+
+#define FICHERO_DICCIONARIO "carga_medida_diccionario.txt"
+
+/**
+ * @brief Devuelve los segundos transcurridos desde un instante
+ * @param tini Instante inicial
+ * @return Segundos transcurridos
+ */
+double Segundos(chrono::steady_clock::time_point tini) {
+	return chrono::duration<double>(chrono::steady_clock::now() - tini).count();
+}
+
+/**
+ * @brief Comprueba si dos diccionarios tienen las mismas palabras
+ * @param a Primer diccionario
+ * @param b Segundo diccionario
+ * @return True si son iguales, false en caso contrario
+ */
+bool Iguales(const Dictionary &a, const Dictionary &b) {
+	if (a.size() != b.size())
+		return false;
+	for (Dictionary::iterator i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j)
+		if (*i != *j)
+			return false;
+	return true;
+}
+
+int main (int argc, char* argv[]) {
+	int npalabras = (argc > 1) ? atoi(argv[1]) : 5000000;
+	int nhilos = (argc > 2) ? atoi(argv[2]) : (int) thread::hardware_concurrency();
+	if (nhilos <= 0)
+		nhilos = 1;
+
+	if (argc > 3 || npalabras <= 0) {
+		cerr << "Uso: carga_medida [NumeroDePalabras] [NumeroDeHilos]" << endl;
+		return 1;
+	}
+
+	// Generamos el fichero: palabras de 2 a 14 letras, con la mitad de distintas que de palabras,
+	// así que la mayoría aparecen repetidas
+	srand(1);
+	int distintas = npalabras / 2 + 1;
+	ofstream fichero(FICHERO_DICCIONARIO);
+	for (int i = 0; i < npalabras; i++) {
+		unsigned semilla = rand() % distintas;
+		string palabra(2 + semilla % 13, 'a');
+		for (size_t j = 0; j < palabra.size(); j++) {
+			semilla = semilla * 1103515245u + 12345u;
+			palabra[j] = 'a' + (semilla >> 16) % 26;
+		}
+		fichero << palabra << "\n";
+	}
+	fichero.close();
+
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	ifstream is(FICHERO_DICCIONARIO);
+	Dictionary flujo;
+	is >> flujo;
+	is.close();
+	double t_flujo = Segundos(tini);
+
+	tini = chrono::steady_clock::now();
+	Dictionary secuencial;
+	secuencial.LoadDictionary(FICHERO_DICCIONARIO, 1);
+	double t_secuencial = Segundos(tini);
+
+	tini = chrono::steady_clock::now();
+	Dictionary paralelo;
+	paralelo.LoadDictionary(FICHERO_DICCIONARIO, nhilos);
+	double t_paralelo = Segundos(tini);
+
+	remove(FICHERO_DICCIONARIO);
+
+	// Mostramos resultados (segundos)
+	cout << "Palabras: " << npalabras << " (" << flujo.size() << " distintas)" << endl;
+	cout << "flujo:\t\t\t" << t_flujo << endl;
+	cout << "LoadDictionary:\t\t" << t_secuencial << endl;
+	cout << "LoadDictionary(" << nhilos << "):\t" << t_paralelo << endl;
+	if (!Iguales(flujo, secuencial) || !Iguales(flujo, paralelo))
+		cout << "Los diccionarios no coinciden" << endl;
+
+	return 0;
+}
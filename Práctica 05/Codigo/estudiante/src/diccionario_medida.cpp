@@ -0,0 +1,191 @@
+/**
+ * @file diccionario_medida.cpp
+ * @brief Fichero usado para medir la memoria y las búsquedas de cada representación de Dictionary
+ *
+ * Carga un diccionario de un fichero y lo pasa a cada una de las representaciones
+ * (Dictionary::Representacion): el set<string>, el vector ordenado y el trie. De cada una muestra
+ * la memoria que ocupa y el tiempo medio, en nanosegundos, de Dictionary::exists(), con la mitad
+ * de búsquedas de palabras que están en el diccionario y la otra mitad de palabras que no están.
+ *
+ * Después mide, en microsegundos, Dictionary::getOcurrences() con cada letra minúscula y
+ * Dictionary::wordsOfLength() con las longitudes de 1 a 20: con los índices, que se construyen al
+ * cargar y congelar el diccionario, y recorriendo todas las palabras en cada consulta, como se
+ * hacía antes.
+ *
+ * La memoria es la que queda reservada con malloc tras construir el diccionario, incluida la que
+ * se pierde en cada reserva; sólo se puede medir con la biblioteca de C de GNU.
+ *
+ * @param Fichero Fichero con las palabras.
+ * @param NumeroDeBusquedas Número de búsquedas de cada prueba. Opcional, por defecto 10^6.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./diccionario_medida ../data/diccionario.txt 1000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "dictionary.h"
+
+using namespace std;
+
+/**
+ * @brief Devuelve la memoria reservada con malloc en este momento
+ * @return Bytes reservados, o 0 si no se puede medir
+ */
+size_t MemoriaReservada() {
+#ifdef __GLIBC__
+	struct mallinfo2 info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief Número de ocurrencias de un carácter en el diccionario, recorriendo todas las palabras
+ *
+ * Es como se implementaba Dictionary::getOcurrences() antes de tener un índice.
+ *
+ * @param dic Diccionario
+ * @param c Carácter a buscar
+ * @return Número de ocurrencias del carácter en el diccionario
+ */
+int getOcurrences_noeff(const Dictionary &dic, char c) {
+	int cont = 0;
+	for (Dictionary::iterator it = dic.begin(); it != dic.end(); ++it)
+		cont += count_ocurrences(c, *it);
+	return cont;
+}
+
+/**
+ * @brief Palabras de una longitud dada, recorriendo todas las palabras
+ *
+ * Es como se implementaba Dictionary::wordsOfLength() antes de tener un índice.
+ *
+ * @param dic Diccionario
+ * @param length Longitud de las palabras a buscar
+ * @return Vector con las palabras de la longitud dada
+ */
+vector<string> wordsOfLength_noeff(const Dictionary &dic, int length) {
+	vector<string> v_ret;
+	for (Dictionary::iterator it = dic.begin(); it != dic.end(); ++it)
+		if ((int) (*it).length() == length)
+			v_ret.push_back(*it);
+	return v_ret;
+}
+
+/**
+ * @brief Mide las consultas de palabras por longitud y de ocurrencias de cada letra
+ * @param dic Diccionario
+ * @param suma Parámetro de salida que acumula los resultados, para que no se eliminen las consultas
+ * @return Microsegundos de: ocurrencias con índice y sin índice, palabras por longitud con índice
+ * y sin índice
+ */
+vector<double> MedirConsultas(const Dictionary &dic, size_t &suma) {
+	vector<double> t;
+	for (int vez = 0; vez < 2; vez++) {
+		chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+		for (char c = 'a'; c <= 'z'; c++)
+			suma += (vez == 0) ? dic.getOcurrences(c) : getOcurrences_noeff(dic, c);
+		t.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - tini).count());
+	}
+	for (int vez = 0; vez < 2; vez++) {
+		chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+		for (int l = 1; l <= 20; l++)
+			suma += (vez == 0) ? dic.wordsOfLength(l).size() : wordsOfLength_noeff(dic, l).size();
+		t.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - tini).count());
+	}
+	return t;
+}
+
+/**
+ * @brief Mide una representación del diccionario
+ * @param fichero Fichero con las palabras
+ * @param r Representación
+ * @param nombre Nombre de la representación, para mostrarlo
+ * @param busquedas Palabras a buscar
+ * @param consultas Parámetro de salida al que se añade el tiempo de las consultas (ver MedirConsultas())
+ */
+void Medir(const string &fichero, Dictionary::Representacion r, const char *nombre,
+           const vector<string> &busquedas, vector<vector<double>> &consultas) {
+	size_t antes = MemoriaReservada();
+	Dictionary dic;
+	dic.LoadDictionary(fichero);
+	dic.freeze(r);
+	size_t memoria = MemoriaReservada() - antes;
+
+	size_t encontradas = 0;
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	for (size_t i = 0; i < busquedas.size(); i++)
+		encontradas += dic.exists(busquedas[i]);
+	chrono::steady_clock::time_point tfin = chrono::steady_clock::now();
+	double ns = chrono::duration<double, nano>(tfin - tini).count() / busquedas.size();
+
+	cout << nombre << "\t" << memoria / 1048576.0 << "\t" << (double) memoria / dic.size() << "\t"
+	     << ns << "\t" << encontradas << endl;
+
+	consultas.push_back(MedirConsultas(dic, encontradas));
+}
+
+int main(int argc, char *argv[]) {
+	long long nbusquedas = (argc > 2) ? atoll(argv[2]) : 1000000;
+
+	if (argc < 2 || argc > 3 || nbusquedas <= 0) {
+		cerr << "Uso: diccionario_medida <Fichero> [NumeroDeBusquedas]" << endl;
+		return 1;
+	}
+
+	// Las búsquedas se toman del propio diccionario: la mitad tal cual y la otra mitad con
+	// un carácter cambiado, así que casi ninguna de estas está
+	Dictionary dic;
+	if (!dic.LoadDictionary(argv[1]))
+		return 1;
+	if (dic.empty()) {
+		cerr << "El diccionario está vacío" << endl;
+		return 1;
+	}
+	vector<string> palabras;
+	for (Dictionary::iterator it = dic.begin(); it != dic.end(); ++it)
+		palabras.push_back(*it);
+	size_t npalabras = dic.size();
+	dic.clear();
+
+	srand(1);
+	vector<string> busquedas(nbusquedas);
+	for (long long i = 0; i < nbusquedas; i++) {
+		busquedas[i] = palabras[rand() % palabras.size()];
+		if (i % 2 == 1)
+			busquedas[i][rand() % busquedas[i].size()] ^= 0x20;
+	}
+	vector<string>().swap(palabras);
+
+	cout << "Palabras: " << npalabras << ", búsquedas: " << nbusquedas << endl;
+	cout << "representación\tMiB\tbytes/palabra\tns/búsqueda\tencontradas" << endl;
+	const char *nombres[3] = {"set<string>", "vector", "trie"};
+	Dictionary::Representacion representaciones[3] = {Dictionary::CONJUNTO, Dictionary::VECTOR_ORDENADO, Dictionary::TRIE};
+	vector<vector<double>> consultas;
+	for (int r = 0; r < 3; r++)
+		Medir(argv[1], representaciones[r], nombres[r], busquedas, consultas);
+
+	cout << endl << "Consultas (microsegundos): getOcurrences con 26 letras, wordsOfLength con 20 longitudes" << endl;
+	cout << "representación	ocurrencias	sin índice	longitud	sin índice" << endl;
+	for (int r = 0; r < 3; r++) {
+		cout << nombres[r];
+		for (size_t k = 0; k < consultas[r].size(); k++)
+			cout << "\t" << consultas[r][k];
+		cout << endl;
+	}
+
+	return 0;
+}
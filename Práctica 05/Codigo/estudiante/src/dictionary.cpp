@@ -7,9 +7,14 @@
  */
 
 #include "dictionary.h"
+#include "ficheroMapeado.h"
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include <cstdint>
 
 using namespace std;
 
@@ -23,59 +28,249 @@ ostream& operator<<(ostream& os, const Dictionary& dic){
 istream& operator>>(istream& is, Dictionary& dic) {
     dic.clear();
     string wrd;
+    // Las palabras van directamente al conjunto y el índice por longitud se construye al final, de una vez
     while (is >> wrd)
-        dic.insert(wrd);
+        if (dic.words.insert(wrd).second)
+            dic.ContarCaracteres(wrd, 1);
+    dic.IndexarLongitudes();
 
     return is;
 }
 
-Dictionary::Dictionary() {}
+Dictionary::Dictionary() : representacion(CONJUNTO) {
+    clear();
+}
+
+Dictionary::Dictionary(const Dictionary &othr) : representacion(CONJUNTO) {
+    *this = othr;
+}
+
+Dictionary& Dictionary::operator=(const Dictionary &othr) {
+    if (this != &othr) {
+        VaciarPalabras();
+        this->words = othr.words;
+        this->representacion = othr.representacion;
+        this->vector_ordenado = othr.vector_ordenado;
+        this->trie = othr.trie;
 
-Dictionary::Dictionary(const Dictionary &othr) {
-    this->words = othr.words;
+        // El índice por longitud del conjunto apunta a las palabras del otro diccionario y se
+        // reconstruye. El de un diccionario congelado son posiciones y sirve tal cual
+        if (othr.representacion == CONJUNTO)
+            IndexarLongitudes();
+        else {
+            this->longitudes_palabras = othr.longitudes_palabras;
+            this->longitudes_inicio = othr.longitudes_inicio;
+        }
+
+        copy(othr.apariciones, othr.apariciones + 256, this->apariciones);
+    }
+    return *this;
 }
 
-bool Dictionary::exists(const string &s) const {return (bool)words.count(s);}
+bool Dictionary::exists(const string &s) const {
+    switch (representacion) {
+        case VECTOR_ORDENADO:
+            return vector_ordenado.Existe(s);
+        case TRIE:
+            return trie.Existe(s);
+        default:
+            return (bool)words.count(s);
+    }
+}
 
 bool Dictionary::insert(const string &s) {
+    if (representacion != CONJUNTO) {
+        if (exists(s))
+            return false;
+        Descongelar();
+    }
     pair<set<string>::iterator, bool> ret = words.insert(s);
+    if (ret.second) {
+        ContarCaracteres(s, 1);
+        if (longitudes_conjunto.size() <= s.size())
+            longitudes_conjunto.resize(s.size() + 1);
+        longitudes_conjunto[s.size()].insert(ret.first);
+    }
     return ret.second;
 }
 
 bool Dictionary::erase(const std::string &s) {
-    return (bool) this->words.erase(s);
+    if (representacion != CONJUNTO) {
+        if (!exists(s))
+            return false;
+        Descongelar();
+    }
+    set<string>::iterator it = words.find(s);
+    if (it == words.end())
+        return false;
+
+    ContarCaracteres(s, -1);
+    longitudes_conjunto[s.size()].erase(it);
+    this->words.erase(it);
+    return true;
+}
+
+void Dictionary::ContarCaracteres(const string &s, int signo) {
+    for (size_t i = 0; i < s.size(); i++)
+        if (signo > 0)
+            apariciones[(unsigned char) s[i]]++;
+        else
+            apariciones[(unsigned char) s[i]]--;
+}
+
+void Dictionary::VaciarPalabras() {
+    this->words.clear();
+    this->vector_ordenado.Vaciar();
+    this->trie.Vaciar();
+    this->representacion = CONJUNTO;
+
+    vector<set<set<string>::iterator, OrdenIteradores>>().swap(this->longitudes_conjunto);
+    vector<uint32_t>().swap(this->longitudes_palabras);
+    vector<uint32_t>().swap(this->longitudes_inicio);
+}
+
+void Dictionary::clear() {
+    VaciarPalabras();
+
+    fill(apariciones, apariciones + 256, 0);
+}
+
+bool Dictionary::empty() const {return this->size() == 0;}
+
+unsigned int Dictionary::size() const {
+    switch (representacion) {
+        case VECTOR_ORDENADO:
+            return vector_ordenado.Tamanio();
+        case TRIE:
+            return trie.Tamanio();
+        default:
+            return this->words.size();
+    }
+}
+
+void Dictionary::iterator::Leer() {
+    if (dic->representacion == VECTOR_ORDENADO && pos < dic->vector_ordenado.Tamanio())
+        palabra = dic->vector_ordenado.Palabra(pos);
+    else if (dic->representacion == TRIE && pos < dic->trie.Tamanio())
+        palabra = dic->trie.Palabra(pos);
+}
+
+void Dictionary::Descongelar() {
+    if (representacion == CONJUNTO)
+        return;
+
+    // Las palabras salen en orden: cada inserción al final del conjunto es O(1) amortizado
+    set<string> conjunto;
+    for (Dictionary::iterator it = this->begin(); it != this->end(); ++it)
+        conjunto.insert(conjunto.end(), *it);
+
+    VaciarPalabras();
+    words.swap(conjunto);
+    IndexarLongitudes();
 }
 
-void Dictionary::clear() {this->words.clear();}
+bool Dictionary::freeze(Representacion r) {
+    if (r == representacion)
+        return true;
+    if (r == CONJUNTO) {
+        Descongelar();
+        return true;
+    }
+
+    // Tanto VECTOR_ORDENADO como TRIE se construyen a partir de un VectorPalabras
+    if (representacion != VECTOR_ORDENADO) {
+        size_t caracteres = 0;
+        for (Dictionary::iterator it = this->begin(); it != this->end(); ++it)
+            caracteres += (*it).size();
+        if (caracteres >= VectorPalabras::MAX_CARACTERES)
+            return false;
 
-bool Dictionary::empty() const {return this->words.empty();}
+        VectorPalabras v;
+        v.Reservar(size(), caracteres);
+        for (Dictionary::iterator it = this->begin(); it != this->end(); ++it)
+            v.Anadir((*it).data(), (*it).size());
+
+        VaciarPalabras();
+        swap(vector_ordenado, v);
+        representacion = VECTOR_ORDENADO;
+        IndexarLongitudes();
+    }
+
+    // Las palabras siguen en las mismas posiciones, así que el índice por longitud sigue sirviendo
+    if (r == TRIE) {
+        trie.Construir(vector_ordenado);
+        vector_ordenado.Vaciar();
+    }
 
-unsigned int Dictionary::size() const {return this->words.size();}
+    representacion = r;
+    return true;
+}
+
+void Dictionary::IndexarLongitudes() {
+    if (representacion == CONJUNTO) {
+        // Las palabras salen en orden: cada inserción al final de su longitud es O(1) amortizado
+        longitudes_conjunto.clear();
+        for (set<string>::iterator it = words.begin(); it != words.end(); ++it) {
+            if (longitudes_conjunto.size() <= it->size())
+                longitudes_conjunto.resize(it->size() + 1);
+            longitudes_conjunto[it->size()].insert(longitudes_conjunto[it->size()].end(), it);
+        }
+    }
+    else {
+        // Ordenación por recuento de las posiciones según la longitud de su palabra. Se recorren
+        // en orden, así que las de cada longitud quedan ordenadas alfabéticamente
+        size_t n = size(), maxima = 0;
+        vector<uint32_t> longitudes(n);
+        for (size_t i = 0; i < n; i++) {
+            longitudes[i] = (representacion == VECTOR_ORDENADO) ? vector_ordenado.Longitud(i) : trie.Longitud(i);
+            maxima = max(maxima, (size_t) longitudes[i]);
+        }
+
+        longitudes_inicio.assign(maxima + 2, 0);
+        for (size_t i = 0; i < n; i++)
+            longitudes_inicio[longitudes[i] + 1]++;
+        for (size_t l = 1; l < longitudes_inicio.size(); l++)
+            longitudes_inicio[l] += longitudes_inicio[l - 1];
+
+        vector<uint32_t> siguiente(longitudes_inicio.begin(), longitudes_inicio.end() - 1);
+        longitudes_palabras.resize(n);
+        for (size_t i = 0; i < n; i++)
+            longitudes_palabras[siguiente[longitudes[i]]++] = i;
+    }
+}
 
 vector<string> Dictionary::wordsOfLength(int length) const {
     vector<string> v_ret;
-	for (Dictionary::iterator it = this->begin(); it != this->end(); ++it)
-        if ((*it).length() == length) v_ret.push_back(*it);
+    if (length < 0)
+        return v_ret;
+
+    size_t l = length;
+    if (representacion == CONJUNTO) {
+        if (l < longitudes_conjunto.size())
+            for (set<set<string>::iterator, OrdenIteradores>::const_iterator it = longitudes_conjunto[l].begin();
+                 it != longitudes_conjunto[l].end(); ++it)
+                v_ret.push_back(**it);
+    }
+    else if (l + 1 < longitudes_inicio.size()) {
+        v_ret.reserve(longitudes_inicio[l + 1] - longitudes_inicio[l]);
+        for (size_t k = longitudes_inicio[l]; k < longitudes_inicio[l + 1]; k++) {
+            size_t i = longitudes_palabras[k];
+            v_ret.push_back((representacion == VECTOR_ORDENADO) ? vector_ordenado.Palabra(i) : trie.Palabra(i));
+        }
+    }
 
     return v_ret;
 }
 
 int count_ocurrences(char c, const string& word, size_t pos) {
     int cont = 0;
-    size_t s = word.find(c,pos);
-    if (s != string::npos) {
+    for (size_t s = word.find(c, pos); s != string::npos; s = word.find(c, s + 1))
         cont++;
-        cont += count_ocurrences(c,word,s+1);
-    }
     return cont;
 }
 
 int Dictionary::getOcurrences(char c) const {
-    int cont = 0;
-    for (Dictionary::iterator it = this->begin(); it != this->end(); ++it)
-        cont += count_ocurrences(c,*it);
-
-    return cont;
+    return apariciones[(unsigned char) c];
 }
 
 void Dictionary::anade(const Dictionary &dic) {
@@ -85,17 +280,221 @@ void Dictionary::anade(const Dictionary &dic) {
 }
 
 
-Dictionary::Dictionary(const string & file_name){
+Dictionary::Dictionary(const string & file_name) : representacion(CONJUNTO) {
 	LoadDictionary(file_name);
 }
 
 
-void Dictionary::LoadDictionary(const std::string &file_name) {
-	ifstream is;
-	is.open(file_name);
-	if (!is.is_open()) {
-		cerr << "Error opening the file " << file_name;
-		exit(1);
-	}
-	is >> *this;
+/**
+ * @brief Palabra de un fichero proyectado en memoria, sin copiar
+ *
+ * Guarda además sus 8 primeros caracteres en un entero, de forma que comparar los enteros es
+ * comparar esos caracteres. Así la mayoría de las comparaciones al ordenar no tienen que ir a
+ * buscar la palabra al fichero.
+ */
+struct PalabraMapeada {
+    uint64_t prefijo;   ///< 8 primeros caracteres, el primero en el byte más significativo, completados con ceros
+    const char *ini;    ///< Primer carácter de la palabra
+    size_t tam;         ///< Número de caracteres
+};
+
+/**
+ * @brief Crea una PalabraMapeada
+ * @param ini Primer carácter de la palabra
+ * @param tam Número de caracteres
+ * @return La palabra
+ */
+static inline PalabraMapeada Mapear(const char *ini, size_t tam) {
+    PalabraMapeada palabra = {VectorPalabras::Prefijo(ini, tam), ini, tam};
+    return palabra;
+}
+
+/**
+ * @brief Orden de las palabras: el mismo que el de string (lexicográfico, comparando bytes sin signo)
+ */
+static inline bool operator<(const PalabraMapeada &a, const PalabraMapeada &b) {
+    if (a.prefijo != b.prefijo)
+        return a.prefijo < b.prefijo;
+
+    // Los primeros min(8, tam) caracteres coinciden
+    size_t m = min(a.tam, b.tam);
+    if (m > 8) {
+        int c = memcmp(a.ini + 8, b.ini + 8, m - 8);
+        if (c != 0)
+            return c < 0;
+    }
+    return a.tam < b.tam;
+}
+
+/**
+ * @brief Igualdad de palabras
+ */
+static inline bool operator==(const PalabraMapeada &a, const PalabraMapeada &b) {
+    return a.prefijo == b.prefijo && a.tam == b.tam && (a.tam <= 8 || memcmp(a.ini + 8, b.ini + 8, a.tam - 8) == 0);
+}
+
+/**
+ * @brief Indica si un carácter es un blanco, como lo entiende el operator>> de los flujos
+ *
+ * Los blancos son ' ' y '\t', '\n', '\v', '\f' y '\r', que son consecutivos.
+ */
+static inline bool EsBlanco(char c) {
+    return c == ' ' || (unsigned char) (c - '\t') < 5;
+}
+
+/**
+ * @brief Busca el final de la palabra que empieza en @a p
+ *
+ * Mira los caracteres de 8 en 8 dentro de un entero de 64 bits: todos los blancos son menores
+ * que 33, así que mientras ningún byte lo sea se puede saltar el bloque entero. Sólo el bloque
+ * con el final de la palabra se recorre carácter a carácter.
+ *
+ * @param p Primer carácter de la palabra
+ * @param fin Final del fichero
+ * @return Puntero al primer blanco tras la palabra, o @a fin
+ */
+static const char *FinPalabra(const char *p, const char *fin) {
+    const uint64_t UNOS = 0x0101010101010101ull, ALTOS = 0x8080808080808080ull;
+
+    while (fin - p >= 8) {
+        uint64_t x;
+        memcpy(&x, p, 8);
+        // Es distinto de 0 si y sólo si algún byte de x es menor que 33
+        if (((x - UNOS * 33) & ~x & ALTOS) != 0)
+            break;
+        p += 8;
+    }
+
+    while (p < fin && !EsBlanco(*p))
+        ++p;
+    return p;
+}
+
+/**
+ * @brief Separa las palabras de un trozo del fichero, las ordena y elimina las repetidas
+ * @param ini Comienzo del trozo. Es el comienzo del fichero o va tras un blanco
+ * @param fin Final del trozo. Es el final del fichero o un blanco
+ * @param palabras Parámetro de salida con las palabras ordenadas y sin repetir
+ */
+static void TrozoOrdenado(const char *ini, const char *fin, vector<PalabraMapeada> &palabras) {
+    const char *p = ini;
+    while (true) {
+        while (p < fin && EsBlanco(*p))
+            ++p;
+        if (p >= fin)
+            break;
+
+        const char *q = FinPalabra(p, fin);
+        palabras.push_back(Mapear(p, q - p));
+        p = q;
+    }
+
+    sort(palabras.begin(), palabras.end());
+    palabras.erase(unique(palabras.begin(), palabras.end()), palabras.end());
+}
+
+/**
+ * @brief Mezcla dos trozos ordenados consecutivos de un vector
+ * @param v Vector
+ * @param ini Comienzo del primer trozo
+ * @param medio Comienzo del segundo trozo
+ * @param fin Final del segundo trozo
+ */
+static void MezclarTrozos(vector<PalabraMapeada> &v, size_t ini, size_t medio, size_t fin) {
+    inplace_merge(v.begin() + ini, v.begin() + medio, v.begin() + fin);
+}
+
+bool Dictionary::LoadDictionary(const std::string &file_name, unsigned hilos) {
+    const size_t MIN_POR_HILO = 1 << 20;   // Bytes: por debajo no compensa crear el hilo
+
+    clear();
+
+    FicheroMapeado fichero;
+    if (!fichero.Abrir(file_name)) {
+        cerr << "Error opening the file " << file_name << endl;
+        return false;
+    }
+
+    const char *ini = fichero.begin(), *fin = fichero.end();
+    size_t tam = fichero.size();
+
+    if (hilos == 0) {
+        hilos = thread::hardware_concurrency();
+        if (hilos > tam / MIN_POR_HILO)
+            hilos = tam / MIN_POR_HILO;
+        if (hilos == 0)
+            hilos = 1;
+    }
+
+    // Partimos el fichero en trozos que no corten palabras: cada corte se lleva al siguiente blanco
+    vector<const char *> cortes(hilos + 1);
+    cortes[0] = ini;
+    cortes[hilos] = fin;
+    for (unsigned h = 1; h < hilos; h++) {
+        const char *c = ini + tam / hilos * h;
+        if (c < cortes[h-1])
+            c = cortes[h-1];
+        while (c < fin && !EsBlanco(*c))
+            ++c;
+        cortes[h] = c;
+    }
+
+    // Cada hilo separa, ordena y elimina las repetidas de su trozo
+    vector<vector<PalabraMapeada>> trozos(hilos);
+    vector<thread> trabajadores;
+    for (unsigned h = 1; h < hilos; h++)
+        trabajadores.push_back(thread(TrozoOrdenado, cortes[h], cortes[h+1], ref(trozos[h])));
+    TrozoOrdenado(cortes[0], cortes[1], trozos[0]);
+    for (size_t h = 0; h < trabajadores.size(); h++)
+        trabajadores[h].join();
+
+    // Juntamos los trozos y los mezclamos por parejas, también en paralelo, hasta que queda uno.
+    // limites[h] es el comienzo del trozo h
+    vector<PalabraMapeada> palabras;
+    palabras.swap(trozos[0]);
+    vector<size_t> limites(1, 0);
+    limites.push_back(palabras.size());
+    for (unsigned h = 1; h < hilos; h++) {
+        palabras.insert(palabras.end(), trozos[h].begin(), trozos[h].end());
+        limites.push_back(palabras.size());
+        vector<PalabraMapeada>().swap(trozos[h]);
+    }
+
+    for (unsigned paso = 1; paso < hilos; paso *= 2) {
+        vector<thread> mezcladores;
+        for (unsigned k = 2 * paso; k + paso < hilos; k += 2 * paso)
+            mezcladores.push_back(thread(MezclarTrozos, ref(palabras), limites[k], limites[k + paso],
+                                         limites[min(k + 2 * paso, hilos)]));
+        MezclarTrozos(palabras, limites[0], limites[paso], limites[min(2 * paso, hilos)]);
+        for (size_t m = 0; m < mezcladores.size(); m++)
+            mezcladores[m].join();
+    }
+
+    // Cada trozo ya no tenía repetidas, pero puede haberlas entre trozos distintos
+    palabras.erase(unique(palabras.begin(), palabras.end()), palabras.end());
+
+    // Las palabras ya están en orden: se copian seguidas en el vector y el diccionario queda congelado.
+    // Si no caben, se insertan en el conjunto, también en orden, así que cada una es O(1) amortizado
+    size_t caracteres = 0;
+    for (size_t i = 0; i < palabras.size(); i++)
+        caracteres += palabras[i].tam;
+
+    if (caracteres < VectorPalabras::MAX_CARACTERES) {
+        vector_ordenado.Reservar(palabras.size(), caracteres);
+        for (size_t i = 0; i < palabras.size(); i++)
+            vector_ordenado.Anadir(palabras[i].ini, palabras[i].tam);
+        representacion = VECTOR_ORDENADO;
+
+        // Los caracteres del vector están seguidos: se cuentan todos en una pasada
+        vector_ordenado.Apariciones(apariciones);
+    }
+    else
+        for (size_t i = 0; i < palabras.size(); i++) {
+            set<string>::iterator it = words.insert(words.end(), string(palabras[i].ini, palabras[i].tam));
+            ContarCaracteres(*it, 1);
+        }
+
+    IndexarLongitudes();
+
+    return true;
 }
@@ -17,7 +17,9 @@ int main(int argc, char* argv[]) {
     }
 
     int word_length = stoi(argv[2]);
-    Dictionary dic(argv[1]);
+    Dictionary dic;
+    if (!dic.LoadDictionary(argv[1]))
+        return 1;
 
     vector<string> wol = dic.wordsOfLength(word_length);
 
@@ -0,0 +1,129 @@
+/**
+ * @file triepalabras.cpp
+ * @brief Implementación de TriePalabras
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "triepalabras.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+TriePalabras::TriePalabras() {}
+
+/**
+ * @brief Palabras de un nodo del trie durante su construcción
+ */
+struct RangoNodo {
+    size_t lo;      ///< Primera palabra del vector que empieza por el prefijo del nodo
+    size_t hi;      ///< Final de esas palabras
+    size_t prof;    ///< Longitud del prefijo del nodo
+};
+
+void TriePalabras::Construir(const VectorPalabras &v) {
+    Vaciar();
+
+    // Las palabras de un nodo son un rango del vector ordenado, y dentro de él las de cada hijo
+    // son un subrango: las que tienen el mismo carácter tras el prefijo. Se recorren los nodos en
+    // el orden en que se crean, que es por niveles, y cada uno crea sus hijos al final
+    vector<RangoNodo> rangos;
+    Nodo raiz = {0, 0, 0, 0, 0};
+    nodos.push_back(raiz);
+    primeros.push_back(0);
+    rangos.push_back({0, v.Tamanio(), 0});
+    terminales.resize(v.Tamanio());
+
+    for (size_t k = 0; k < nodos.size(); k++) {
+        size_t lo = rangos[k].lo, hi = rangos[k].hi, prof = rangos[k].prof;
+        nodos[k].primer_hijo = nodos.size();
+
+        // Al estar ordenadas, si el prefijo es una palabra es la primera
+        if (lo < hi && v.Longitud(lo) == prof) {
+            nodos[k].terminal = 1;
+            terminales[lo] = k;
+            lo++;
+        }
+
+        while (lo < hi) {
+            unsigned char c = v.Datos(lo)[prof];
+
+            // Final de las palabras con el carácter c en la posición prof, por búsqueda binaria
+            size_t a = lo + 1, b = hi;
+            while (a < b) {
+                size_t medio = a + (b - a) / 2;
+                if ((unsigned char) v.Datos(medio)[prof] == c)
+                    a = medio + 1;
+                else
+                    b = medio;
+            }
+
+            // La etiqueta del hijo es el prefijo común de la primera y la última palabra, que es el de todas
+            const char *primera = v.Datos(lo) + prof, *ultima = v.Datos(a - 1) + prof;
+            size_t maximo = min(v.Longitud(lo), v.Longitud(a - 1)) - prof, tam = 1;
+            while (tam < maximo && primera[tam] == ultima[tam])
+                tam++;
+
+            Nodo hijo = {(uint32_t) etiquetas.size(), (uint32_t) tam, 0, 0, (uint32_t) k};
+            nodos.push_back(hijo);
+            primeros.push_back(c);
+            etiquetas.append(primera, tam);
+            rangos.push_back({lo, a, prof + tam});
+            lo = a;
+        }
+    }
+
+    nodos.shrink_to_fit();
+    primeros.shrink_to_fit();
+    etiquetas.shrink_to_fit();
+}
+
+bool TriePalabras::Existe(const string &s) const {
+    if (nodos.empty())
+        return false;
+
+    size_t k = 0, pos = 0;
+    while (pos < s.size()) {
+        // Los hijos de k están ordenados por su primer carácter, que es distinto en cada uno
+        size_t ini = nodos[k].primer_hijo;
+        size_t fin = (k + 1 < nodos.size()) ? nodos[k + 1].primer_hijo : nodos.size();
+        const void *hijo = memchr(primeros.data() + ini, (unsigned char) s[pos], fin - ini);
+        if (hijo == nullptr)
+            return false;
+
+        k = (const unsigned char *) hijo - primeros.data();
+        size_t tam = nodos[k].tam;
+        if (s.size() - pos < tam || memcmp(s.data() + pos, etiquetas.data() + nodos[k].etiqueta, tam) != 0)
+            return false;
+        pos += tam;
+    }
+    return nodos[k].terminal;
+}
+
+size_t TriePalabras::Longitud(size_t i) const {
+    size_t tam = 0;
+    for (size_t k = terminales[i]; k != 0; k = nodos[k].padre)
+        tam += nodos[k].tam;
+    return tam;
+}
+
+string TriePalabras::Palabra(size_t i) const {
+    size_t tam = Longitud(i);
+
+    // Se rellena de atrás hacia delante, de la hoja a la raíz
+    string palabra(tam, '\0');
+    for (size_t k = terminales[i]; k != 0; k = nodos[k].padre) {
+        tam -= nodos[k].tam;
+        palabra.replace(tam, nodos[k].tam, etiquetas, nodos[k].etiqueta, nodos[k].tam);
+    }
+    return palabra;
+}
+
+void TriePalabras::Vaciar() {
+    vector<Nodo>().swap(nodos);
+    vector<unsigned char>().swap(primeros);
+    string().swap(etiquetas);
+    vector<uint32_t>().swap(terminales);
+}
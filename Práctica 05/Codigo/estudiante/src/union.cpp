@@ -19,7 +19,9 @@ int main(int argc, char* argv[]) {
         exit(1);
     }
 
-    Dictionary dic1(argv[1]), dic2(argv[2]);
+    Dictionary dic1, dic2;
+    if (!dic1.LoadDictionary(argv[1]) || !dic2.LoadDictionary(argv[2]))
+        return 1;
 
     dic1.anade(dic2); // Unimos sobre dic1
 
@@ -0,0 +1,99 @@
+/**
+ * @file vectorpalabras.cpp
+ * @brief Implementación de VectorPalabras
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "vectorpalabras.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+VectorPalabras::VectorPalabras() : inicio(1, 0) {}
+
+uint64_t VectorPalabras::Prefijo(const char *s, size_t n) {
+    uint64_t prefijo = 0;
+    for (size_t k = 0; k < 8; k++)
+        prefijo = (prefijo << 8) | (k < n ? (unsigned char) s[k] : 0);
+    return prefijo;
+}
+
+void VectorPalabras::Apariciones(size_t apariciones[256]) const {
+    // Cuatro tablas que se alternan: dos caracteres iguales seguidos incrementan contadores
+    // distintos y no tienen que esperar el uno al otro
+    vector<size_t> tablas(4 * 256, 0);
+    const unsigned char *s = (const unsigned char *) caracteres.data();
+    size_t n = caracteres.size(), i = 0;
+    for (; i + 4 <= n; i += 4) {
+        tablas[s[i]]++;
+        tablas[256 + s[i + 1]]++;
+        tablas[512 + s[i + 2]]++;
+        tablas[768 + s[i + 3]]++;
+    }
+    for (; i < n; i++)
+        tablas[s[i]]++;
+
+    for (size_t c = 0; c < 256; c++)
+        apariciones[c] = tablas[c] + tablas[256 + c] + tablas[512 + c] + tablas[768 + c];
+}
+
+void VectorPalabras::Reservar(size_t palabras, size_t caracteres) {
+    this->caracteres.reserve(caracteres);
+    inicio.reserve(palabras + 1);
+    prefijos.reserve(palabras);
+}
+
+void VectorPalabras::Anadir(const char *s, size_t n) {
+    caracteres.append(s, n);
+    inicio.push_back(caracteres.size());
+    prefijos.push_back(Prefijo(s, n));
+}
+
+void VectorPalabras::Ajustar() {
+    caracteres.shrink_to_fit();
+    inicio.shrink_to_fit();
+    prefijos.shrink_to_fit();
+}
+
+int VectorPalabras::Comparar(size_t i, const char *s, size_t n) const {
+    // Los primeros min(8, longitudes) caracteres coinciden
+    size_t tam = Longitud(i), m = min(tam, n);
+    if (m > 8) {
+        int c = memcmp(Datos(i) + 8, s + 8, m - 8);
+        if (c != 0)
+            return c;
+    }
+    return (tam < n) ? -1 : (tam > n);
+}
+
+bool VectorPalabras::Existe(const string &s) const {
+    // Primero se buscan las palabras con el mismo prefijo sin salir del vector de prefijos, y sólo
+    // entre ellas, que suelen ser una o ninguna, se comparan los caracteres
+    uint64_t clave = Prefijo(s.data(), s.size());
+    vector<uint64_t>::const_iterator ini = lower_bound(prefijos.begin(), prefijos.end(), clave);
+    if (ini == prefijos.end() || *ini != clave)
+        return false;
+    size_t lo = ini - prefijos.begin();
+    size_t hi = upper_bound(ini, prefijos.end(), clave) - prefijos.begin();
+
+    while (lo < hi) {
+        size_t medio = lo + (hi - lo) / 2;
+        int c = Comparar(medio, s.data(), s.size());
+        if (c == 0)
+            return true;
+        if (c < 0)
+            lo = medio + 1;
+        else
+            hi = medio;
+    }
+    return false;
+}
+
+void VectorPalabras::Vaciar() {
+    string().swap(caracteres);
+    vector<Posicion>(1, 0).swap(inicio);
+    vector<uint64_t>().swap(prefijos);
+}
@@ -12,8 +12,12 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <iostream>
 #include "ruta.h"
+#include "pais.h"
+#include "arbolR.h"
+#include "ficheroMapeado.h"
 
 using namespace std;
 
@@ -24,6 +28,21 @@ using namespace std;
  * que representa un conjunto de rutas aéreas. Este conjunto
  * es un mapa que contiene como clave el código de la ruta
  * y como valor la ruta.
+ *
+ * Sobre las rutas se mantienen dos índices para las consultas:
+ * - Un índice invertido de los puntos por los que pasa cada ruta, agrupados en celdas
+ *   de TAM_CELDA grados.
+ * - Un árbol R sobre las cajas envolventes de las rutas.
+ *
+ * Al cargar rutas de un fichero los dos índices se construyen de una vez, en una sola pasada por
+ * las rutas. insertarRuta() y eliminarRuta() los mantienen al día: las paradas de una ruta nueva
+ * se añaden a un índice pequeño aparte, y las de una ruta borrada se marcan como borradas en el
+ * principal. Cuando los cambios acumulados superan una fracción de las rutas, los índices se
+ * reconstruyen enteros. Las consultas no modifican nada, así que se pueden hacer a la vez desde
+ * varios hilos.
+ *
+ * Si se modifican los puntos de una ruta a través de un iterador, hay que volver a insertarla
+ * (eliminarRuta() e insertarRuta()) para que los índices la tengan en cuenta.
  */
 class AlmacenRutas {
 private:
@@ -34,6 +53,133 @@ private:
 	 */
 	map<string, Ruta> rutas;
 
+	/**
+	 * @brief Aparición de un punto en una ruta, para el índice invertido
+	 */
+	struct Parada {
+		long long celda;    ///< Clave de la celda que contiene al punto
+		Punto punto;        ///< Punto de la ruta
+		const Ruta *ruta;   ///< Ruta, dentro de @a rutas. Nulo si se ha borrado
+	};
+
+	/**
+	 * @brief Índice invertido principal: las paradas de las rutas que había en la última
+	 * reconstrucción, ordenadas por celda
+	 */
+	vector<Parada> paradas;
+
+	/**
+	 * @brief Paradas de las rutas insertadas desde la última reconstrucción, ordenadas por celda
+	 */
+	vector<Parada> paradas_nuevas;
+
+	/**
+	 * @brief Árbol R sobre las cajas de las rutas que había en la última reconstrucción
+	 */
+	ArbolR arbol;
+
+	/**
+	 * @brief Ruta de cada caja del árbol, por su identificador. Nulo si se ha borrado
+	 */
+	vector<const Ruta *> rutas_arbol;
+
+	/**
+	 * @brief Rutas insertadas desde la última reconstrucción, que no están en el árbol
+	 */
+	vector<const Ruta *> rutas_nuevas;
+
+	/**
+	 * @brief Rutas insertadas o borradas desde la última reconstrucción
+	 */
+	size_t cambios = 0;
+
+	/**
+	 * @brief Tamaño, en grados, de las celdas del índice invertido
+	 *
+	 * Es mayor que el doble de la tolerancia de Punto::operator==, así que dos puntos iguales
+	 * siempre están en la misma celda o en celdas vecinas.
+	 */
+	static const double TAM_CELDA;
+
+	/**
+	 * @brief Calcula la clave de la celda del índice invertido que contiene a un punto
+	 * @param lat Latitud
+	 * @param lon Longitud
+	 * @return Clave de la celda
+	 */
+	static long long Celda(double lat, double lon);
+
+	/**
+	 * @brief Lee una ruta de un texto con el formato de operator>>
+	 * @param lector Lector situado al comienzo de la ruta
+	 * @param ruta Ruta leída
+	 * @retval true Si se ha leído una ruta
+	 * @retval false Si no quedan rutas o la ruta no tiene el formato esperado
+	 */
+	static bool LeerRuta(Lector &lector, Ruta &ruta);
+
+	/**
+	 * @brief Lee todas las rutas de un texto con el formato de operator>>, sin la cadena mágica
+	 * @param ini Comienzo del texto
+	 * @param fin Final del texto
+	 * @param rutas Vector al que se añaden las rutas leídas, en el orden del texto
+	 * @retval true Si se ha llegado al final del texto
+	 * @retval false Si se ha encontrado una ruta mal formada
+	 */
+	static bool LeerRutas(const char *ini, const char *fin, vector<Ruta> &rutas);
+
+	/**
+	 * @brief Añade al almacén las rutas de un texto con el formato de operator>>, sin la cadena mágica
+	 *
+	 * El texto se divide en tantos trozos como hilos, cortando siempre al principio de una línea
+	 * que empiece una ruta (que no empiece por '('). Cada hilo lee su trozo y, al terminar,
+	 * las rutas se mueven al almacén en el orden del texto.
+	 *
+	 * @param ini Comienzo del texto
+	 * @param fin Final del texto
+	 * @param num_hilos Número de hilos
+	 * @retval true Si se ha leído todo el texto
+	 * @retval false Si se ha encontrado una ruta mal formada
+	 */
+	bool Parsear(const char *ini, const char *fin, int num_hilos);
+
+	/**
+	 * @brief Añade al almacén las rutas del cuerpo de un fichero binario
+	 * @param cuerpo Comienzo del cuerpo, alineado a 8 bytes
+	 * @param tam Tamaño del cuerpo en bytes
+	 * @retval true Si el cuerpo es coherente
+	 * @retval false En caso contrario
+	 * @see GuardarBinario()
+	 */
+	bool LeerBinario(const char *cuerpo, size_t tam);
+
+	/**
+	 * @brief Añade una ruta al mapa sin actualizar los índices
+	 * @param ruta Ruta a añadir
+	 * @return Ruta dentro del mapa, o nulo si ya había una con su código
+	 */
+	const Ruta *Anadir(Ruta &&ruta);
+
+	/**
+	 * @brief Añade a los índices una ruta del mapa y, si se han acumulado muchos cambios, los reconstruye
+	 * @param ruta Ruta dentro de @a rutas
+	 */
+	void Indexar(const Ruta &ruta);
+
+	/**
+	 * @brief Quita de los índices una ruta del mapa, antes de borrarla
+	 *
+	 * No reconstruye los índices aunque se hayan acumulado muchos cambios: la ruta sigue en el mapa.
+	 *
+	 * @param ruta Ruta dentro de @a rutas
+	 */
+	void Desindexar(const Ruta &ruta);
+
+	/**
+	 * @brief Reconstruye los dos índices con todas las rutas, en una sola pasada
+	 */
+	void Reindexar();
+
 public:
 
 	/**
@@ -47,6 +193,42 @@ public:
 	 */
 	AlmacenRutas(const map<string, Ruta> &rutas);
 
+	/**
+	 * @brief Constructor de copia de la clase
+	 *
+	 * Los índices del otro almacén se refieren a sus rutas, así que no se copian: se construyen
+	 * de nuevo sobre las rutas copiadas.
+	 *
+	 * @param otro Almacén a copiar
+	 */
+	AlmacenRutas(const AlmacenRutas &otro) : rutas(otro.rutas) {
+		Reindexar();
+	}
+
+	/**
+	 * @brief Constructor de movimiento de la clase. Los índices siguen siendo válidos
+	 */
+	AlmacenRutas(AlmacenRutas &&) = default;
+
+	/**
+	 * @brief Operador de asignación. Como en el constructor de copia, no se copian los índices
+	 * @param otro Almacén a copiar
+	 * @return Referencia a este almacén
+	 */
+	AlmacenRutas & operator=(const AlmacenRutas &otro) {
+		if (this != &otro) {
+			rutas = otro.rutas;
+			Reindexar();
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Operador de asignación con movimiento. Los índices siguen siendo válidos
+	 * @return Referencia a este almacén
+	 */
+	AlmacenRutas & operator=(AlmacenRutas &&) = default;
+
 	/**
 	 * @brief Método que devuelve la ruta correspondiente a un código
 	 * @param codigo Código de la ruta
@@ -69,12 +251,74 @@ public:
 	 */
 	void insertarRuta(const Ruta &ruta);
 
+	/**
+	 * @brief Método que añade una ruta al almacén, sin copiarla
+	 * @param ruta Ruta a añadir
+	 */
+	void insertarRuta(Ruta &&ruta);
+
+	/**
+	 * @brief Añade al almacén las rutas de un fichero
+	 *
+	 * El fichero tiene el mismo formato que lee operator>>, pero se proyecta en memoria
+	 * y se lee directamente, sin pasar por flujos, repartiéndolo entre varios hilos.
+	 *
+	 * También acepta los ficheros escritos con GuardarBinario(), que se reconocen por su cabecera
+	 * y se leen sin analizar ningún texto (en ese caso no se usan hilos).
+	 *
+	 * @param nombre Nombre del fichero
+	 * @param num_hilos Número de hilos. Opcional, por defecto 1
+	 * @retval true Si se ha leído el fichero completo
+	 * @retval false Si no se ha podido abrir o no tiene el formato esperado
+	 */
+	bool CargarFichero(const string &nombre, int num_hilos = 1);
+
+	/**
+	 * @brief Guarda el almacén en un fichero binario, que puede leerse con CargarFichero()
+	 *
+	 * Tras la cabecera (ver formatoBinario.h), el cuerpo contiene, con enteros de 64 bits:
+	 * el número de rutas, el número total de puntos y el tamaño de la tabla de cadenas;
+	 * el comienzo de los puntos de cada ruta y el de su código en la tabla de cadenas (uno más
+	 * que rutas, para marcar el final); la latitud y la longitud de todos los puntos, como reales
+	 * de doble precisión; y la tabla de cadenas con los códigos. Las rutas están ordenadas por código.
+	 *
+	 * @param nombre Nombre del fichero
+	 * @retval true Si se ha podido escribir
+	 * @retval false En caso contrario
+	 */
+	bool GuardarBinario(const string &nombre) const;
+
 	/**
 	 * @brief Método que elimina una ruta del almacén
 	 * @param codigo Código de la ruta a eliminar
 	 */
 	void eliminarRuta(string codigo);
 
+	/**
+	 * @brief Busca las rutas que pasan por un punto
+	 * @param punto Punto (se compara con Punto::operator==)
+	 * @return Códigos de las rutas, ordenados y sin repetir
+	 */
+	vector<string> rutasPorPunto(const Punto &punto) const;
+
+	/**
+	 * @brief Busca las rutas que hacen escala en un país
+	 * @param pais País
+	 * @return Códigos de las rutas que pasan por el punto del país, ordenados y sin repetir
+	 */
+	vector<string> rutasPorPais(const Pais &pais) const;
+
+	/**
+	 * @brief Busca las rutas que atraviesan una caja
+	 *
+	 * Una ruta atraviesa la caja si alguno de sus tramos, tomado como un segmento recto sobre
+	 * el plano latitud/longitud (como se dibuja en el mapa), tiene algún punto dentro de ella.
+	 *
+	 * @param caja Caja
+	 * @return Códigos de las rutas, ordenados
+	 */
+	vector<string> rutasEnCaja(const Caja &caja) const;
+
 	/**
 	 * @brief Método que devuelve el número de rutas del almacén
 	 * @return Número de rutas del almacén
@@ -274,6 +518,11 @@ ostream & operator<<(ostream& os, const AlmacenRutas& ar);
 
 /**
  * @brief Sobrecarga del operador de entrada
+ *
+ * Lee el resto del flujo de una vez y lo analiza con el mismo código que AlmacenRutas::CargarFichero(),
+ * con un solo hilo. Si el texto no empieza por la cadena mágica o tiene una ruta mal formada, activa
+ * failbit en el flujo; en el segundo caso el almacén se queda con las rutas anteriores a ella.
+ *
  * @param is  Stream de entrada
  * @param ar  Almacén de rutas
  * @return  Stream de entrada
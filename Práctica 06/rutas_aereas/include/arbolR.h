@@ -0,0 +1,104 @@
+/**
+ * @file arbolR.h
+ * @brief Fichero cabecera del TDA ArbolR
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_ARBOLR_H
+#define PRACTICAFINAL_ARBOLR_H
+
+#include <vector>
+#include "punto.h"
+
+using namespace std;
+
+/**
+ * @brief TDA ArbolR
+ *
+ * Una instancia del tipo de datos abstracto @c ArbolR es un árbol R estático sobre un conjunto
+ * de cajas, identificadas por su posición en el vector con el que se construye. Permite obtener
+ * las cajas que cortan a una caja dada sin compararlas todas.
+ *
+ * Se construye de una vez con el método Sort-Tile-Recursive (STR): las cajas se ordenan por
+ * la longitud de su centro, se reparten en franjas y cada franja se ordena por latitud y se
+ * agrupa en hojas de hasta CAPACIDAD cajas; los niveles superiores se forman igual sobre los nodos
+ * del nivel inferior. Los nodos de cada nivel se guardan contiguos en un vector.
+ *
+ * Las longitudes no se tratan como circulares: una caja que cruce el antimeridiano debe
+ * darse como la caja que va de su longitud mínima a su longitud máxima.
+ */
+class ArbolR {
+private:
+	/**
+	 * @brief Número máximo de hijos de cada nodo
+	 */
+	static const int CAPACIDAD = 16;
+
+	/**
+	 * @brief Nodo del árbol
+	 */
+	struct Nodo {
+		Caja caja;     ///< Caja que envuelve a todos sus hijos
+		int primero;   ///< Posición del primer hijo en el nivel inferior (o en @a ids, si es una hoja)
+		int num;       ///< Número de hijos
+	};
+
+	/**
+	 * @brief Niveles del árbol: niveles[0] son las hojas y niveles.back() contiene sólo la raíz
+	 */
+	vector<vector<Nodo> > niveles;
+
+	/**
+	 * @brief Identificadores de las cajas, en el orden en que las agrupan las hojas
+	 */
+	vector<int> ids;
+
+	/**
+	 * @brief Cajas con las que se construyó el árbol, indexadas por su identificador
+	 */
+	vector<Caja> cajas;
+
+	/**
+	 * @brief Busca a partir de un nodo las cajas que cortan a una dada
+	 * @param nivel Nivel del nodo
+	 * @param nodo Posición del nodo en su nivel
+	 * @param c Caja buscada
+	 * @param resultado Vector al que se añaden los identificadores encontrados
+	 */
+	void Buscar(int nivel, int nodo, const Caja &c, vector<int> &resultado) const;
+
+public:
+	/**
+	 * @brief Constructor por defecto de la clase. Crea un árbol vacío
+	 */
+	ArbolR(){}
+
+	/**
+	 * @brief Construye el árbol sobre un conjunto de cajas, descartando el que hubiera
+	 * @param cajas Cajas; el identificador de cada una es su posición. Las cajas vacías no se indexan
+	 */
+	void Construir(const vector<Caja> &cajas);
+
+	/**
+	 * @brief Vacía el árbol
+	 */
+	void clear();
+
+	/**
+	 * @brief Devuelve el número de cajas indexadas
+	 * @return Número de cajas
+	 */
+	int size() const {return ids.size();}
+
+	/**
+	 * @brief Busca las cajas que cortan a una dada
+	 * @param c Caja buscada
+	 * @return Identificadores de las cajas que la cortan, sin un orden determinado
+	 */
+	vector<int> Buscar(const Caja &c) const;
+};
+
+#endif //PRACTICAFINAL_ARBOLR_H
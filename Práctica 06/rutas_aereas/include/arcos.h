@@ -0,0 +1,132 @@
+/**
+ * @file arcos.h
+ * @brief Fichero cabecera del TDA LoteArcos
+ *
+ * Permite dibujar sobre un mapa los arcos de círculo máximo que siguen los vuelos.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_ARCOS_H
+#define PRACTICAFINAL_ARCOS_H
+
+#include <vector>
+#include "punto.h"
+#include "ruta.h"
+#include "almacenRutas.h"
+#include "geodesia.h"
+#include "imagen.h"
+#include "mapaTeselado.h"
+
+using namespace std;
+
+/**
+ * @brief Número de segmentos rectos con los que se aproxima cada arco, por defecto
+ */
+#define TRAMOS_ARCO 64
+
+/**
+ * @brief Segmento recto en coordenadas continuas de un mapa
+ * @see Imagen::DibujarLinea()
+ */
+struct Segmento {
+	double f0;  ///< Fila del primer extremo
+	double c0;  ///< Columna del primer extremo
+	double f1;  ///< Fila del segundo extremo
+	double c1;  ///< Columna del segundo extremo
+};
+
+/**
+ * @brief TDA LoteArcos
+ *
+ * Una instancia del tipo de datos abstracto @c LoteArcos es un conjunto de tramos de vuelo
+ * (pares origen-destino) que se dibujan juntos sobre un mapa en proyección equirectangular,
+ * como los de Punto::coordenadasMapa().
+ *
+ * Cada tramo se dibuja como el arco de círculo máximo (la ruta más corta) entre sus extremos,
+ * aproximado por segmentos rectos. Los puntos de los arcos se calculan para todos los tramos a la vez
+ * con LotePuntos::puntosIntermedios(). Los segmentos que cruzan el antimeridiano se parten en
+ * dos, uno que acaba en el borde derecho del mapa y otro que empieza en el izquierdo.
+ *
+ * Para dibujar, el mapa se divide en teselas de TAM_TESELA x TAM_TESELA píxeles y cada segmento
+ * se asigna a las teselas que toca. Luego cada tesela se recorre una sola vez, dibujando todos sus
+ * segmentos recortados a ella: así se trabaja siempre sobre una zona pequeña del mapa y, como las
+ * teselas no se solapan, se pueden repartir entre varios hilos. Son las mismas teselas que las de
+ * MapaTeselado, por lo que también se puede dibujar en paralelo sobre un mapa teselado.
+ */
+class LoteArcos {
+private:
+	/**
+	 * @brief Origen de cada tramo
+	 */
+	LotePuntos origenes;
+
+	/**
+	 * @brief Destino de cada tramo
+	 */
+	LotePuntos destinos;
+
+public:
+	/**
+	 * @brief Constructor por defecto de la clase. Crea un lote sin tramos
+	 */
+	LoteArcos(){}
+
+	/**
+	 * @brief Devuelve el número de tramos del lote
+	 * @return Número de tramos
+	 */
+	size_t size() const {return origenes.size();}
+
+	/**
+	 * @brief Elimina todos los tramos del lote
+	 */
+	void clear();
+
+	/**
+	 * @brief Añade un tramo al lote
+	 * @param origen Origen del tramo
+	 * @param destino Destino del tramo
+	 */
+	void Anadir(const Punto &origen, const Punto &destino);
+
+	/**
+	 * @brief Añade al lote los tramos entre cada par de puntos consecutivos de una ruta
+	 * @param ruta Ruta
+	 */
+	void Anadir(const Ruta &ruta);
+
+	/**
+	 * @brief Añade al lote los tramos de todas las rutas de un almacén
+	 * @param almacen Almacén de rutas
+	 */
+	void Anadir(const AlmacenRutas &almacen);
+
+	/**
+	 * @brief Calcula los segmentos que aproximan los arcos de todos los tramos en un mapa
+	 * @param filas Número de filas del mapa
+	 * @param columnas Número de columnas del mapa
+	 * @param tramos Número de segmentos por arco (más los que añadan los cruces del antimeridiano)
+	 * @param segmentos Parámetro de salida con los segmentos
+	 * @pre @a tramos > 0
+	 */
+	void Segmentos(int filas, int columnas, int tramos, vector<Segmento> &segmentos) const;
+
+	/**
+	 * @brief Dibuja los arcos de todos los tramos sobre un mapa
+	 * @tparam Lienzo Imagen o MapaTeselado
+	 * @param mapa Mapa sobre el que se dibuja
+	 * @param color Color de los arcos
+	 * @param tramos Número de segmentos por arco. Por defecto TRAMOS_ARCO
+	 * @param num_hilos Número de hilos entre los que se reparten las teselas. Por defecto 1
+	 * @param regiones Si no es nulo, se le añaden las teselas del mapa en las que se ha dibujado
+	 * @pre @a tramos > 0
+	 * @see Imagen::DibujarLinea()
+	 */
+	template <class Lienzo>
+	void Dibujar(Lienzo &mapa, const Pixel &color, int tramos = TRAMOS_ARCO, int num_hilos = 1,
+				 vector<Region> *regiones = 0) const;
+};
+
+#endif //PRACTICAFINAL_ARCOS_H
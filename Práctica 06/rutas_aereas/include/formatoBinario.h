@@ -0,0 +1,101 @@
+/**
+ * @file formatoBinario.h
+ * @brief Fichero cabecera con las utilidades comunes de los formatos binarios
+ *
+ * Los ficheros binarios de Paises y AlmacenRutas comienzan con una CabeceraBinaria seguida
+ * del cuerpo. El cuerpo se compone de enteros de 64 bits y de reales de doble precisión,
+ * siempre alineados a 8 bytes, y termina con la tabla de cadenas. Así se puede usar
+ * directamente desde la proyección en memoria del fichero, sin analizar ningún texto.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_FORMATOBINARIO_H
+#define PRACTICAFINAL_FORMATOBINARIO_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "ficheroMapeado.h"
+
+using namespace std;
+
+/**
+ * @brief Versión actual de los formatos binarios
+ */
+#define VERSION_BINARIA 1
+
+/**
+ * @brief Cabecera de los ficheros binarios
+ */
+struct CabeceraBinaria {
+	char magia[8];          ///< Identifica el tipo de fichero (sin '\0' final)
+	uint32_t version;       ///< Versión del formato
+	uint32_t orden_bytes;   ///< 0x01020304 escrito en el orden de bytes de la máquina que generó el fichero
+	uint64_t tam_cuerpo;    ///< Tamaño del cuerpo en bytes
+	uint64_t suma;          ///< Suma de comprobación del cuerpo
+};
+
+/**
+ * @brief Calcula la suma de comprobación de un bloque de bytes
+ *
+ * Es FNV-1a de 64 bits aplicado a palabras de 8 bytes en lugar de a bytes sueltos.
+ *
+ * @param datos Comienzo del bloque
+ * @param tam Tamaño del bloque en bytes
+ * @return Suma de comprobación
+ */
+uint64_t SumaComprobacion(const char *datos, size_t tam);
+
+/**
+ * @brief Indica si un fichero proyectado en memoria empieza con una cadena mágica
+ * @param fichero Fichero proyectado
+ * @param magia Cadena mágica de 8 caracteres
+ * @return True si el fichero empieza con esa cadena, false en caso contrario
+ */
+bool EsBinario(const FicheroMapeado &fichero, const char *magia);
+
+/**
+ * @brief Comprueba la cabecera de un fichero binario y devuelve su cuerpo
+ * @param fichero Fichero proyectado
+ * @param magia Cadena mágica de 8 caracteres
+ * @param cuerpo Comienzo del cuerpo
+ * @param tam Tamaño del cuerpo en bytes
+ * @retval true Si la cabecera es correcta y la suma de comprobación coincide
+ * @retval false En caso contrario
+ */
+bool AbrirBinario(const FicheroMapeado &fichero, const char *magia, const char *&cuerpo, size_t &tam);
+
+/**
+ * @brief Escribe un fichero binario: la cabecera y, a continuación, el cuerpo
+ * @param nombre Nombre del fichero
+ * @param magia Cadena mágica de 8 caracteres
+ * @param cuerpo Cuerpo del fichero
+ * @retval true Si se ha podido escribir
+ * @retval false En caso contrario
+ */
+bool GuardarFicheroBinario(const string &nombre, const char *magia, const vector<char> &cuerpo);
+
+/**
+ * @brief Añade un array a un cuerpo binario
+ * @param cuerpo Cuerpo al que se añade
+ * @param datos Comienzo del array
+ * @param n Número de elementos
+ */
+template <class T>
+void AnadirBinario(vector<char> &cuerpo, const T *datos, size_t n) {
+	cuerpo.insert(cuerpo.end(), (const char *) datos, (const char *) (datos + n));
+}
+
+/**
+ * @brief Añade un array a un cuerpo binario
+ * @param cuerpo Cuerpo al que se añade
+ * @param datos Array
+ */
+template <class T>
+void AnadirBinario(vector<char> &cuerpo, const vector<T> &datos) {
+	AnadirBinario(cuerpo, datos.data(), datos.size());
+}
+
+#endif //PRACTICAFINAL_FORMATOBINARIO_H
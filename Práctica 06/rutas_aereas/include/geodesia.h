@@ -0,0 +1,126 @@
+/**
+ * @file geodesia.h
+ * @brief Fichero cabecera del TDA LotePuntos
+ *
+ * Cálculos sobre la esfera terrestre (distancias, rumbos y puntos intermedios) para muchos
+ * pares de puntos a la vez. Para un único par están los métodos de Punto.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_GEODESIA_H
+#define PRACTICAFINAL_GEODESIA_H
+
+#include <vector>
+#include "punto.h"
+
+using namespace std;
+
+/**
+ * @brief TDA LotePuntos
+ *
+ * Una instancia del tipo de datos abstracto @c LotePuntos es una secuencia de puntos guardada como
+ * estructura de arrays: un array con las latitudes, otro con las longitudes (ambas en radianes) y
+ * otros cuatro con sus senos y cosenos, que se calculan una sola vez al añadir cada punto.
+ *
+ * Las operaciones por lotes trabajan elemento a elemento sobre dos lotes del mismo tamaño con bucles
+ * sin ramas ni dependencias entre iteraciones, de forma que el compilador pueda vectorizarlos
+ * (geodesia.cpp se compila con las opciones necesarias para usar las funciones trigonométricas vectoriales).
+ * Los senos y cosenos precalculados evitan además calcular el seno y el coseno de un mismo ángulo,
+ * que el compilador junta en una llamada a sincos que no sabe vectorizar.
+ */
+class LotePuntos {
+private:
+	vector<double> lat;      ///< Latitudes, en radianes
+	vector<double> lon;      ///< Longitudes, en radianes
+	vector<double> sin_lat;  ///< Seno de las latitudes
+	vector<double> cos_lat;  ///< Coseno de las latitudes
+	vector<double> sin_lon;  ///< Seno de las longitudes
+	vector<double> cos_lon;  ///< Coseno de las longitudes
+
+public:
+	/**
+	 * @brief Constructor por defecto de la clase. Crea un lote vacío
+	 */
+	LotePuntos(){}
+
+	/**
+	 * @brief Constructor de la clase
+	 * @param puntos Puntos del lote
+	 */
+	LotePuntos(const vector<Punto> &puntos);
+
+	/**
+	 * @brief Devuelve el número de puntos del lote
+	 * @return Número de puntos
+	 */
+	size_t size() const {return lat.size();}
+
+	/**
+	 * @brief Reserva memoria para un número de puntos
+	 * @param n Número de puntos
+	 */
+	void reserve(size_t n);
+
+	/**
+	 * @brief Añade un punto al final del lote
+	 * @param p Punto
+	 */
+	void push_back(const Punto &p);
+
+	/**
+	 * @brief Vacía el lote
+	 */
+	void clear();
+
+	/**
+	 * @brief Devuelve las latitudes de los puntos del lote
+	 * @return Latitudes, en radianes
+	 */
+	const vector<double> & getLatitudes() const {return lat;}
+
+	/**
+	 * @brief Devuelve las longitudes de los puntos del lote
+	 * @return Longitudes, en radianes
+	 */
+	const vector<double> & getLongitudes() const {return lon;}
+
+	/**
+	 * @brief Devuelve un punto del lote
+	 * @param i Posición del punto
+	 * @return Punto, con las coordenadas en grados
+	 * @pre i < size()
+	 */
+	Punto operator[](size_t i) const;
+
+	/**
+	 * @brief Calcula la distancia ortodrómica entre cada punto de este lote y el correspondiente de otro
+	 * @param otro Lote con los otros extremos
+	 * @param resultado Array de size() elementos donde se guardan las distancias, en kilómetros
+	 * @pre otro.size() == size()
+	 * @see Punto::distancia()
+	 */
+	void distancias(const LotePuntos &otro, double *resultado) const;
+
+	/**
+	 * @brief Calcula el rumbo inicial desde cada punto de este lote hasta el correspondiente de otro
+	 * @param otro Lote con los destinos
+	 * @param resultado Array de size() elementos donde se guardan los rumbos, en grados en [0, 360)
+	 * @pre otro.size() == size()
+	 * @see Punto::rumbo()
+	 */
+	void rumbos(const LotePuntos &otro, double *resultado) const;
+
+	/**
+	 * @brief Calcula el punto que está a una fracción del arco de círculo máximo entre cada par de puntos
+	 * @param otro Lote con los destinos
+	 * @param fraccion Fracción del camino recorrida: 0 es el origen y 1 el destino
+	 * @param resultado Lote donde se guardan los puntos intermedios (se sustituye su contenido)
+	 * @pre otro.size() == size(), y ningún par de puntos es antípoda (el círculo máximo no estaría definido)
+	 * @see Punto::puntoIntermedio()
+	 */
+	void puntosIntermedios(const LotePuntos &otro, double fraccion, LotePuntos &resultado) const;
+};
+
+#endif //PRACTICAFINAL_GEODESIA_H
@@ -15,6 +15,8 @@
 using namespace std;
 #include <vector>
 #include <string>
+#include "basicImage.h"
+#include "imagenES.h"
 
 /**
  * @brief Estrucutra para representar un pixel de una imagen.
@@ -45,13 +47,103 @@ struct Pixel{
 	unsigned char transp;
 };
 
+/**
+ * @brief Formato de los píxeles de una Imagen para BasicImage
+ *
+ * Un Pixel ocupa lo mismo que un píxel RGBA y en el mismo orden, así que se lee y escribe tal cual
+ * en los ficheros PAM.
+ */
+template <> struct FormatoPixel<Pixel> {
+	static const int CANALES = 4;
+	static const int MAXIMO = 255;
+	static const bool DIRECTO = sizeof(Pixel) == 4;
+
+	static Rgba8 ARgba(const Pixel &p) {
+		Rgba8 c = {p.r, p.g, p.b, p.transp};
+		return c;
+	}
+
+	static Pixel DeRgba(const Rgba8 &c) {
+		Pixel p = {c.r, c.g, c.b, c.a};
+		return p;
+	}
+
+	static void Empaquetar(const Pixel *p, int n, unsigned char *muestras) {
+		memcpy(muestras, p, n * sizeof(Pixel));
+	}
+
+	static void Desempaquetar(const unsigned char *muestras, int n, Pixel *p) {
+		memcpy(p, muestras, n * sizeof(Pixel));
+	}
+};
+
+/**
+ * @brief Formato de las máscaras: un gris de 8 bits que es la transparencia del píxel
+ *
+ * Convirtiendo una Imagen a este formato se obtiene su máscara.
+ */
+struct FormatoMascara : public FormatoPixel<Gris8> {
+	static Gris8 DeRgba(const Rgba8 &c) {
+		return c.a;
+	}
+};
+
 /**
  * @brief Enumerado para representar el tipo de pegado de una imagen sobre otra
  *
+ * En todos los casos, los píxeles totalmente transparentes de la imagen pegada no modifican el fondo.
+ *
  * OPACO: Se pega la imagen sin transparencia
- * BLENDING: Se pega la imagen con transparencia
+ * BLENDING: Se pega la media de la imagen y el fondo
+ * SOBRE: Se pega la imagen sobre el fondo según su transparencia (composición "over"), con los
+ * colores sin premultiplicar: transparencia = a + af*(1-a), color = (imagen*a + fondo*af*(1-a)) / transparencia
+ * ADITIVO: Se suma al fondo el color de la imagen, ponderado por su transparencia
+ * MULTIPLICATIVO: Se multiplica el fondo por el color de la imagen, ponderado por su transparencia
+ */
+enum Tipo_Pegado {OPACO, BLENDING, SOBRE, ADITIVO, MULTIPLICATIVO};
+
+/**
+ * @brief Enumerado para representar cómo se obtiene el color de un píxel al rotar una imagen
+ *
+ * VECINO: Se toma el píxel más cercano de la imagen original
+ * BILINEAL: Se interpolan los cuatro píxeles más cercanos de la imagen original
+ */
+enum Tipo_Interpolacion {VECINO, BILINEAL};
+
+/**
+ * @brief Enumerado para representar en qué formato se escribe una imagen en disco
+ *
+ * SOLO_PPM: Sólo el color, en un fichero PPM. Se pierde la transparencia
+ * PPM_MASCARA: El color en un fichero PPM y la transparencia en otro PGM (ver Imagen::NombreMascara())
+ * PAM_RGBA: Color y transparencia en un único fichero PAM (P7) con 4 canales
+ * AUTOMATICO: SOLO_PPM si la imagen es opaca y PPM_MASCARA si no
  */
-enum Tipo_Pegado {OPACO, BLENDING};
+enum Tipo_Salida {SOLO_PPM, PPM_MASCARA, PAM_RGBA, AUTOMATICO};
+
+/**
+ * @brief Estructura para representar una región rectangular de una imagen.
+ */
+struct Region{
+	/**
+	 * @brief Fila superior de la región
+	 */
+	int fila;
+
+	/**
+	 * @brief Columna izquierda de la región
+	 */
+	int columna;
+
+	/**
+	 * @brief Número de filas de la región
+	 */
+	int filas;
+
+	/**
+	 * @brief Número de columnas de la región
+	 */
+	int columnas;
+};
 
 
 /**
@@ -59,35 +151,32 @@ enum Tipo_Pegado {OPACO, BLENDING};
  *
  * Una instancia del tipo de datos abstracto @c Imagen es un objeto
  * que representa una imagen. Este conjunto
- * es un vector de vectores de píxeles.
+ * es una matriz de píxeles.
  *
+ * Los píxeles se guardan en un BasicImage<Pixel>, el núcleo de imagen que comparte con la clase Image
+ * de la práctica 3: un único bloque de memoria con un puntero a cada fila. Él se encarga de la memoria,
+ * de las copias (y de mover las imágenes sin copiarlas) y de la lectura y escritura en disco.
  */
 class Imagen {
 
 private:
     /**
-     * @brief Matriz dinámica donde alojaremos los píxeles de la imagen
-     */
-    Pixel **data;
-    /**
-     * @brief Número de filas de la imagen
-     */
-    int nf;
-    /**
-     * @brief Número de columnas de la imagen
-     */
-    int nc;
-    /**
-     * @brief Método privado que borra la imagen
-     */
-    void borrar();
-    /**
-     * @brief Método privado que copia una imagen
-     * @param img Imagen a copiar
+     * @brief Matriz de píxeles de la imagen
      */
-    void copiar(const Imagen &img);
+    BasicImage<Pixel> pixeles;
 
     Pixel media_pixeles(const Pixel &p1, const Pixel &p2) const;
+
+    /**
+     * @brief Método privado que calcula el tamaño de la imagen rotada
+     * @param coseno Coseno del ángulo de rotación
+     * @param seno Seno del ángulo de rotación
+     * @param row_min Parámetro de salida con la menor fila de la imagen rotada respecto de la original
+     * @param col_min Parámetro de salida con la menor columna de la imagen rotada respecto de la original
+     * @param filas Parámetro de salida con el número de filas de la imagen rotada
+     * @param columnas Parámetro de salida con el número de columnas de la imagen rotada
+     */
+    void DimensionesRotada(double coseno, double seno, double &row_min, double &col_min, int &filas, int &columnas) const;
 public:
 
 	/**
@@ -101,7 +190,7 @@ public:
 	 * @brief Constructor con parámetros
 	 *
 	 * Crea una imagen con el número de filas y columnas indicadas.
-	 * Los píxeles se inicializan a 0,0,0,0 (negro y transparente).
+	 * Los píxeles se inicializan a 255,255,255,255 (blanco y opaco).
 	 *
 	 * @param filas Número de filas de la imagen
 	 * @param columnas Número de columnas de la imagen
@@ -110,13 +199,6 @@ public:
 	 */
 	Imagen(int filas, int columnas);
 
-
-    /**
-     * @brief Constructor de copia de una imagen
-     * @param img
-     */
-    Imagen(const Imagen &img);
-
 	/**
 	 * @brief Operador de acceso
 	 *
@@ -141,22 +223,48 @@ public:
 	 * @brief Método que informa del número de filas de la imagen
 	 * @return Número de filas de la imagen
 	 */
-	int getFilas() const {return nf;};
+	int getFilas() const {return pixeles.getFilas();};
 
 	/**
 	 * @brief Método que informa del número de columnas de la imagen
 	 * @return Número de columnas de la imagen
 	 */
-	int getColumnas() const{return nc;};
+	int getColumnas() const{return pixeles.getColumnas();};
 
 	/**
 	 * @brief Método que escribe una imagen en disco en el archivo dado por @a nombre.
+	 *
+	 * Se escribe con un EscritorImagen, sin copiar la imagen completa: en PAM los píxeles se escriben
+	 * desde donde están y en PPM se convierten por lotes.
+	 *
 	 * @param img_path archivo donde guardar la imagen.
+	 * @param ts formato de salida. Por defecto AUTOMATICO, que sólo escribe la máscara si hace falta.
+	 * @see Tipo_Salida
+	 */
+	void EscribirImagen (const char img_path[], Tipo_Salida ts=AUTOMATICO) const;
+
+	/**
+	 * @brief Método que indica si todos los píxeles de la imagen son opacos (transparencia 255)
+	 * @return true si la imagen es opaca
+	 */
+	bool EsOpaca() const;
+
+	/**
+	 * @brief Método que devuelve el nombre del archivo en el que EscribirImagen() guarda la máscara
+	 *
+	 * Es el de la imagen con el prefijo "mascara_" delante del nombre del fichero y la extensión
+	 * .pgm: para "./output/R1_Mapa.ppm" es "./output/mascara_R1_Mapa.pgm".
+	 *
+	 * @param img_path archivo donde se guarda la imagen.
+	 * @return Nombre del archivo de la máscara, de tipo PGM.
 	 */
-	void EscribirImagen (const char img_path[]) const;
+	static string NombreMascara(const char img_path[]);
 
 	/**
 	 * @brief Método que lee una imagen del disco desde el archivo dado por @a nombre.
+	 *
+	 * La imagen puede ser PPM o PAM. En este último caso, si tiene 4 canales, el cuarto es la transparencia.
+	 *
 	 * @param img_path archivo desde donde leer la imagen.
 	 * @param nombre_mascara archivo donde se encuentra la máscara, en caso de que haya.
 	 */
@@ -169,13 +277,15 @@ public:
 
 	/**
 	 * @brief Método que pega una imagen sobre otra
+	 *
+	 * La zona de pegado se recorta a los límites de la imagen actual antes de empezar,
+	 * por lo que la imagen a pegar puede salirse de ella.
+	 *
 	 * @param i Fila superior donde empieza el pegado de la imagen
 	 * @param j Columna izquierda donde empieza el pegado de la imagen
 	 * @param img Imagen a pegar
 	 * @param tp Tipo de pegado. Por defecto es OPACO
-	 * @pre @a 0<=i,j
-	 * @pre @a 0<=i+img.getFilas()<=getFilas()
-	 * @pre @a 0<=j+img.getColumnas()<=getColumnas()
+	 * @see Tipo_Pegado
 	 */
 	void PutImagen(int i, int j, const Imagen &img, Tipo_Pegado tp=OPACO);
 
@@ -193,19 +303,169 @@ public:
 	 */
 	Imagen ExtraerImagen(int i, int j, int nf, int nc) const;
 
-    /**
-     * @brief Operador de asignación
-     * @param img Imagen a asignar
-     * @return
-     */
-    Imagen &operator=(const Imagen &img);
+	/**
+	 * @brief Método que copia una región de otra imagen sobre la misma región de la imagen actual
+	 *
+	 * La región se recorta a los límites de ambas imágenes, por lo que puede salirse de ellas.
+	 *
+	 * @param origen Imagen de la que se copian los píxeles
+	 * @param reg Región a copiar
+	 * @pre @a origen tiene las mismas dimensiones que la imagen actual
+	 */
+	void CopiarRegion(const Imagen &origen, const Region &reg);
+
+	/**
+	 * @brief Método que dibuja un segmento con antialiasing (algoritmo de Xiaolin Wu)
+	 *
+	 * Los extremos se dan en coordenadas continuas, en las que el píxel (i,j) ocupa el cuadrado
+	 * [i,i+1)x[j,j+1). En cada paso por el eje en el que el segmento avanza más se pintan los dos
+	 * píxeles entre los que pasa, componiendo el color sobre el fondo (como en SOBRE) con su
+	 * transparencia multiplicada por la parte del píxel que cubre el segmento.
+	 *
+	 * Sólo se modifican los píxeles de la imagen que estén dentro de @a recorte. Como el recorte no
+	 * cambia qué píxeles se pintan ni con qué cobertura, un segmento dibujado por partes con varios
+	 * recortes que no se solapan queda igual que dibujado de una vez.
+	 *
+	 * @param f0 Fila del primer extremo
+	 * @param c0 Columna del primer extremo
+	 * @param f1 Fila del segundo extremo
+	 * @param c1 Columna del segundo extremo
+	 * @param color Color del segmento. Su transparencia es la del segmento en los píxeles que cubre por completo
+	 * @param recorte Si no es nulo, región fuera de la cual no se pinta
+	 */
+	void DibujarLinea(double f0, double c0, double f1, double c1, const Pixel &color, const Region *recorte=0);
 
 	/**
 	 * @brief Método que rota una imagen
+	 *
+	 * Recorre la imagen rotada y, para cada píxel, calcula el de la imagen original del que procede.
+	 * Las funciones trigonométricas se calculan una sola vez y, dentro de cada fila, las coordenadas
+	 * de origen se obtienen sumando un incremento constante en aritmética de punto fijo.
+	 * Los píxeles que no proceden de la imagen original quedan transparentes. Con BILINEAL los
+	 * colores se interpolan ponderados por su transparencia, así que el color de los píxeles
+	 * transparentes no aparece en los bordes.
+	 *
 	 * @param rads Radianes a rotar la imagen
+	 * @param ti Tipo de interpolación. Por defecto es VECINO
 	 * @return Imagen rotada
 	 */
-    Imagen Rota(double rads) const;
+    Imagen Rota(double rads, Tipo_Interpolacion ti=VECINO) const;
+
+	/**
+	 * @brief Método que rota una imagen (versión no eficiente)
+	 *
+	 * Recalcula las funciones trigonométricas para cada píxel. Se mantiene para poder
+	 * comparar su eficiencia con la de Rota().
+	 *
+	 * @param rads Radianes a rotar la imagen
+	 * @return Imagen rotada
+	 */
+    Imagen Rota_noeff(double rads) const;
+};
+
+/**
+ * @brief Clase que escribe una imagen en disco a partir de sus píxeles, dados por tramos
+ *
+ * Los píxeles se dan en orden, por filas, en tramos de cualquier longitud, así que la imagen no
+ * tiene por qué estar en un único bloque de memoria (como las filas de un MapaTeselado, repartidas
+ * en teselas). Los ficheros se escriben con FicheroSalida:
+ * - En PAM los tramos se escriben desde donde están, sin copiarlos, así que no deben cambiar
+ *   hasta Cerrar().
+ * - En PPM se convierten a RGB (y la transparencia a la máscara) en un búfer de tamaño fijo,
+ *   que se escribe cada vez que se llena.
+ *
+ * Si la imagen cabe en el búfer, o es PAM y está en pocos tramos, cada fichero se escribe con una
+ * sola llamada a writev. Si algo falla no se deja ningún fichero a medias.
+ */
+class EscritorImagen {
+private:
+	/**
+	 * @brief Píxeles que caben en el búfer de conversión
+	 */
+	static const int TAM_LOTE = 1 << 16;
+
+	/**
+	 * @brief Nombre de la imagen
+	 */
+	string nombre;
+
+	/**
+	 * @brief Nombre de la máscara
+	 */
+	string nombre_mascara;
+
+	/**
+	 * @brief Fichero de la imagen
+	 */
+	FicheroSalida imagen;
+
+	/**
+	 * @brief Fichero de la máscara, si se escribe
+	 */
+	FicheroSalida mascara;
+
+	/**
+	 * @brief Formato de salida: SOLO_PPM, PPM_MASCARA o PAM_RGBA
+	 */
+	Tipo_Salida ts;
+
+	/**
+	 * @brief Cabeceras de la imagen y la máscara, que deben existir hasta escribirlas
+	 */
+	string cabecera, cabecera_mascara;
+
+	/**
+	 * @brief Búfer con los colores convertidos a RGB que aún no se han escrito
+	 */
+	vector<Rgb8> color;
+
+	/**
+	 * @brief Búfer con la máscara de los píxeles que aún no se han escrito
+	 */
+	vector<Gris8> gris;
+
+	/**
+	 * @brief Píxeles del búfer en uso
+	 */
+	int usados;
+
+	/**
+	 * @brief Escribe el búfer y lo deja vacío
+	 */
+	void Vaciar();
+
+public:
+	/**
+	 * @brief Constructor: aún no se escribe ningún fichero
+	 */
+	EscritorImagen() : ts(SOLO_PPM), usados(0) {}
+
+	/**
+	 * @brief Crea los ficheros y les añade la cabecera
+	 *
+	 * @param img_path Archivo donde guardar la imagen. La máscara se guarda como en Imagen::EscribirImagen()
+	 * @param filas Número de filas de la imagen
+	 * @param columnas Número de columnas de la imagen
+	 * @param ts Formato de salida. No puede ser AUTOMATICO
+	 * @retval true Si se han podido crear los ficheros
+	 * @retval false Si no, lo que se indica por la salida de error. No queda ninguno creado
+	 */
+	bool Abrir(const char img_path[], int filas, int columnas, Tipo_Salida ts);
+
+	/**
+	 * @brief Añade los siguientes píxeles de la imagen
+	 * @param p Píxeles. En PAM no deben cambiar hasta Cerrar()
+	 * @param n Número de píxeles
+	 */
+	void Anadir(const Pixel *p, int n);
+
+	/**
+	 * @brief Termina de escribir los ficheros
+	 * @retval true Si se han escrito correctamente
+	 * @retval false Si ha habido algún error, que se indica por la salida de error. Los ficheros se borran
+	 * @pre Se han añadido todos los píxeles de la imagen
+	 */
+	bool Cerrar();
 };
 
 
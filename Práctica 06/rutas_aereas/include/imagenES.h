@@ -2,7 +2,7 @@
   * @file imagenES.h
   * @brief Fichero cabecera para la E/S de imágenes
   *
-  * Permite la E/S de archivos de tipos PGM,PPM
+  * Permite la E/S de archivos de tipos PGM,PPM,PAM
   *
   *
   * @author Arturo Olivares Martos
@@ -13,6 +13,10 @@
 #ifndef _IMAGEN_ES_H_
 #define _IMAGEN_ES_H_
 
+#include <string>
+#include <vector>
+#include <sys/uio.h>
+
 /**
   * @brief Tipo de imagen
   *
@@ -23,7 +27,8 @@
   */
 enum TipoImagen {IMG_DESCONOCIDO, ///< Tipo de imagen desconocido
                  IMG_PGM,         ///< Imagen tipo PGM
-                 IMG_PPM          ///< Imagen tipo PPM
+                 IMG_PPM,         ///< Imagen tipo PPM
+                 IMG_PAM          ///< Imagen tipo PAM (P7), con 3 (RGB) o 4 (RGBA) canales
                 };
 
 
@@ -39,6 +44,20 @@ enum TipoImagen {IMG_DESCONOCIDO, ///< Tipo de imagen desconocido
   */
 TipoImagen LeerTipoImagen(const char nombre[], int& filas, int& columnas);
 
+/**
+  * @brief Consulta el tipo de imagen del archivo, sus dimensiones y sus canales
+  *
+  * @param nombre indica el nombre del archivo de disco a consultar
+  * @param filas Parámetro de salida con las filas de la imagen.
+  * @param columnas Parámetro de salida con las columnas de la imagen.
+  * @param canales Parámetro de salida con las muestras por píxel: 1 en PGM, 3 en PPM
+  * y el DEPTH de la cabecera (3 o 4) en PAM.
+  * @return Devuelve el tipo de la imagen en el archivo
+  *
+  * @see TipoImagen
+  */
+TipoImagen LeerTipoImagen(const char nombre[], int& filas, int& columnas, int& canales);
+
 /**
   * @brief Lee una imagen de tipo PPM sobre memoria reservada
   *
@@ -94,6 +113,92 @@ bool LeerImagenPGM (const char nombre[], int& filas, int& columnas, unsigned cha
   */
 bool EscribirImagenPGM (const char nombre[], const unsigned char datos[], int f, int c);
 
+/**
+  * @brief Escribe una imagen de tipo PAM con 4 canales (TUPLTYPE RGB_ALPHA)
+  *
+  * @param nombre nombre del archivo a escribir
+  * @param datos punteros a los @a f x @a c x 4 bytes que corresponden a los valores
+  *    de los píxeles de la imagen en formato RGBA.
+  * @param f filas de la imagen
+  * @param c columnas de la imagen
+  * @retval true si ha tenido éxito en la escritura.
+  * @retval false si se ha producido algún error en la escritura.
+  */
+bool EscribirImagenPAM (const char nombre[], const unsigned char datos[], int f, int c);
+
+/**
+  * @brief Devuelve la cabecera de una imagen para escribirla
+  *
+  * @param tipo IMG_PGM, IMG_PPM o IMG_PAM (con 4 canales, TUPLTYPE RGB_ALPHA)
+  * @param f filas de la imagen
+  * @param c columnas de la imagen
+  * @return Cabecera, terminada en el separador que precede a los datos
+  */
+std::string CabeceraImagen (TipoImagen tipo, int f, int c);
+
+/**
+  * @brief Fichero de salida que se escribe por partes con writev
+  *
+  * Anadir() sólo apunta dónde están los datos, que deben seguir existiendo hasta que se escriban.
+  * Volcar() escribe todos los apuntados con una llamada a writev (o varias si ésta escribe menos
+  * de lo pedido), y se llama sola al llegar a IOV_MAX partes.
+  *
+  * Si falla alguna escritura, Cerrar() borra el fichero, y también lo borra el destructor si no
+  * se ha llegado a cerrar: un fichero a medio escribir nunca se queda en disco.
+  */
+class FicheroSalida {
+public:
+	/**
+	  * @brief Constructor: el fichero aún no está abierto
+	  */
+	FicheroSalida() : fd(-1), correcto(false) {}
+
+	/**
+	  * @brief Destructor. Si el fichero no se ha cerrado, lo borra
+	  */
+	~FicheroSalida() { Descartar(); }
+
+	FicheroSalida(const FicheroSalida &) = delete;
+	FicheroSalida & operator=(const FicheroSalida &) = delete;
+
+	/**
+	  * @brief Crea el fichero, vaciándolo si ya existía
+	  * @param nombre nombre del fichero
+	  * @retval true si se ha podido crear
+	  */
+	bool Abrir (const char nombre[]);
+
+	/**
+	  * @brief Añade datos a los pendientes de escribir, sin copiarlos
+	  * @param datos datos, que no deben cambiar hasta el siguiente Volcar() o Cerrar()
+	  * @param n número de bytes
+	  */
+	void Anadir (const void *datos, size_t n);
+
+	/**
+	  * @brief Escribe los datos pendientes
+	  * @retval true si todas las escrituras hasta ahora han tenido éxito
+	  */
+	bool Volcar ();
+
+	/**
+	  * @brief Escribe los datos pendientes y cierra el fichero, borrándolo si algo ha fallado
+	  * @retval true si el fichero se ha escrito completo
+	  */
+	bool Cerrar ();
+
+	/**
+	  * @brief Cierra el fichero, si está abierto, y lo borra sin escribir lo pendiente
+	  */
+	void Descartar ();
+
+private:
+	int fd;                            ///< Descriptor del fichero, o -1 si no está abierto
+	bool correcto;                     ///< Indica si no ha fallado nada desde Abrir()
+	std::string nombre;                ///< Nombre del fichero, para borrarlo si falla
+	std::vector<struct iovec> partes;  ///< Datos pendientes de escribir
+};
+
 #endif
 
 /* Fin Fichero: imagenES.h */
@@ -0,0 +1,248 @@
+/**
+ * @file mapaTeselado.h
+ * @brief Fichero cabecera del TDA MapaTeselado
+ *
+ * Permite dibujar sobre un mapa grande modificando y copiando sólo las zonas que cambian.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_MAPATESELADO_H
+#define PRACTICAFINAL_MAPATESELADO_H
+
+#include <vector>
+#include <memory>
+#include "imagen.h"
+
+using namespace std;
+
+/**
+ * @brief Lado, en píxeles, de las teselas en las que se divide un mapa
+ */
+#define TAM_TESELA 256
+
+/**
+ * @brief TDA MapaTeselado
+ *
+ * Una instancia del tipo de datos abstracto @c MapaTeselado es una imagen dividida en teselas
+ * de TAM_TESELA x TAM_TESELA píxeles (las de la última fila y columna pueden ser menores).
+ *
+ * Las teselas del mapa original se guardan una sola vez y las comparten todas las copias del mapa.
+ * Cada copia sólo duplica una tesela la primera vez que pinta en ella (copia en escritura), por lo que
+ * copiar el mapa, dibujar una ruta y volver al mapa original con Restaurar() cuesta en proporción a la
+ * zona dibujada y no al tamaño del mapa.
+ *
+ * Ofrece las mismas operaciones de dibujo que Imagen (PutImagen() y DibujarLinea()), de modo que
+ * PintorRutas y LoteArcos pueden pintar sobre cualquiera de los dos. Dos hilos pueden pintar a la vez
+ * sobre el mismo mapa siempre que lo hagan en teselas distintas.
+ *
+ * Al escribirlo a disco no se reconstruye la imagen completa: las filas se van componiendo a partir
+ * de las teselas y escribiendo por lotes. También puede escribirse sólo una región, como la zona
+ * modificada que devuelve Huella(), y elegirse el formato como en Imagen::EscribirImagen().
+ */
+class MapaTeselado {
+private:
+	/**
+	 * @brief Número de filas del mapa
+	 */
+	int nf;
+
+	/**
+	 * @brief Número de columnas del mapa
+	 */
+	int nc;
+
+	/**
+	 * @brief Número de columnas de teselas
+	 */
+	int tc;
+
+	/**
+	 * @brief Teselas del mapa original, por filas, compartidas por todas las copias
+	 */
+	vector<shared_ptr<const Imagen> > base;
+
+	/**
+	 * @brief Indica, para cada tesela del mapa original, si es opaca
+	 */
+	vector<char> base_opaca;
+
+	/**
+	 * @brief Teselas modificadas en este mapa. Es nulo para las que siguen como en el original
+	 */
+	vector<shared_ptr<Imagen> > propias;
+
+	/**
+	 * @brief Caja de las zonas modificadas desde la última llamada a Restaurar()
+	 *
+	 * Se actualiza al pintar. Como varios hilos pueden pintar a la vez en teselas distintas,
+	 * cada tesela guarda la suya y Huella() las une.
+	 */
+	vector<Region> cajas;
+
+	/**
+	 * @brief Devuelve una tesela para modificarla, duplicándola si aún es la del mapa original
+	 * @param t Índice de la tesela
+	 * @return Referencia a la tesela
+	 */
+	Imagen & Escribir(int t);
+
+	/**
+	 * @brief Anota que se ha modificado un rectángulo de una tesela
+	 * @param t Índice de la tesela
+	 * @param fila Fila superior del rectángulo, en coordenadas del mapa
+	 * @param columna Columna izquierda del rectángulo, en coordenadas del mapa
+	 * @param filas Número de filas del rectángulo
+	 * @param columnas Número de columnas del rectángulo
+	 */
+	void Anotar(int t, int fila, int columna, int filas, int columnas);
+
+	/**
+	 * @brief Calcula las teselas que tocan un rectángulo del mapa
+	 * @param reg Rectángulo, en coordenadas del mapa. Puede salirse del mapa
+	 * @param ti0 Parámetro de salida con la primera fila de teselas
+	 * @param ti1 Parámetro de salida con la última fila de teselas
+	 * @param tj0 Parámetro de salida con la primera columna de teselas
+	 * @param tj1 Parámetro de salida con la última columna de teselas
+	 * @retval true Si el rectángulo toca alguna tesela
+	 * @retval false Si cae fuera del mapa
+	 */
+	bool Teselas(const Region &reg, int &ti0, int &ti1, int &tj0, int &tj1) const;
+
+public:
+	/**
+	 * @brief Constructor por defecto. Crea un mapa vacío
+	 */
+	MapaTeselado();
+
+	/**
+	 * @brief Constructor de la clase. Divide una imagen en teselas
+	 * @param img Imagen con el mapa original
+	 */
+	MapaTeselado(const Imagen &img);
+
+	/**
+	 * @brief Constructor de copia
+	 *
+	 * La copia comparte las teselas del mapa original y empieza sin modificaciones,
+	 * aunque @a otro las tuviera (la copia es del mapa original).
+	 *
+	 * @param otro Mapa a copiar
+	 */
+	MapaTeselado(const MapaTeselado &otro);
+
+	/**
+	 * @brief Operador de asignación. Se comporta como el constructor de copia
+	 * @param otro Mapa a asignar
+	 * @return Referencia al mapa
+	 */
+	MapaTeselado & operator=(const MapaTeselado &otro);
+
+	/**
+	 * @brief Número de filas del mapa
+	 * @return Número de filas
+	 */
+	int getFilas() const {return nf;}
+
+	/**
+	 * @brief Número de columnas del mapa
+	 * @return Número de columnas
+	 */
+	int getColumnas() const {return nc;}
+
+	/**
+	 * @brief Operador de acceso constante
+	 * @param i Fila a acceder
+	 * @param j Columna a acceder
+	 * @return Referencia constante al pixel de la posición (i,j)
+	 * @pre 0 <= @a i < getFilas() y 0 <= @a j < getColumnas()
+	 */
+	const Pixel & operator()(int i, int j) const;
+
+	/**
+	 * @brief Pega una imagen sobre el mapa
+	 * @param i Fila superior donde empieza el pegado de la imagen
+	 * @param j Columna izquierda donde empieza el pegado de la imagen
+	 * @param img Imagen a pegar. Puede salirse del mapa
+	 * @param tp Tipo de pegado. Por defecto es OPACO
+	 * @see Imagen::PutImagen()
+	 */
+	void PutImagen(int i, int j, const Imagen &img, Tipo_Pegado tp=OPACO);
+
+	/**
+	 * @brief Dibuja un segmento con antialiasing
+	 * @param f0 Fila del primer extremo
+	 * @param c0 Columna del primer extremo
+	 * @param f1 Fila del segundo extremo
+	 * @param c1 Columna del segundo extremo
+	 * @param color Color del segmento
+	 * @param recorte Si no es nulo, región fuera de la cual no se pinta
+	 * @see Imagen::DibujarLinea()
+	 */
+	void DibujarLinea(double f0, double c0, double f1, double c1, const Pixel &color, const Region *recorte=0);
+
+	/**
+	 * @brief Devuelve la caja de las zonas modificadas desde la última llamada a Restaurar()
+	 * @return Región modificada. Si no se ha modificado nada tiene 0 filas y 0 columnas
+	 */
+	Region Huella() const;
+
+	/**
+	 * @brief Devuelve el número de teselas que se han duplicado por haberlas modificado
+	 * @return Número de teselas propias
+	 */
+	int TeselasModificadas() const;
+
+	/**
+	 * @brief Deshace todas las modificaciones, dejando el mapa como el original
+	 */
+	void Restaurar();
+
+	/**
+	 * @brief Extrae una región del mapa como imagen
+	 * @param reg Región a extraer
+	 * @return Imagen con la región
+	 * @pre @a reg está dentro del mapa
+	 */
+	Imagen ExtraerImagen(const Region &reg) const;
+
+	/**
+	 * @brief Indica si todos los píxeles de una región del mapa son opacos
+	 *
+	 * Se comprueban las teselas enteras que toca la región. Las del mapa original se comprueban
+	 * una sola vez, al construirlo.
+	 *
+	 * @param reg Región
+	 * @return true si todas las teselas que toca la región son opacas
+	 */
+	bool EsOpaca(const Region &reg) const;
+
+	/**
+	 * @brief Escribe una región del mapa en disco, como Imagen::EscribirImagen()
+	 *
+	 * Las filas se dan por tramos de tesela a un EscritorImagen, sin reconstruir la región
+	 * completa en memoria.
+	 *
+	 * @param img_path Archivo donde guardar la imagen. La máscara se guarda como en Imagen::EscribirImagen()
+	 * @param reg Región a escribir
+	 * @param ts Formato de salida. Por defecto AUTOMATICO, que sólo escribe la máscara si hace falta
+	 * @retval true Si se ha escrito correctamente
+	 * @retval false Si ha habido algún error, que se indica por la salida de error. No se deja
+	 * ningún fichero a medias. Si la región está vacía no se crea ningún fichero
+	 * @pre @a reg está dentro del mapa
+	 */
+	bool EscribirRegion(const char img_path[], const Region &reg, Tipo_Salida ts=AUTOMATICO) const;
+
+	/**
+	 * @brief Escribe el mapa completo en disco, como Imagen::EscribirImagen()
+	 * @param img_path Archivo donde guardar la imagen
+	 * @param ts Formato de salida. Por defecto AUTOMATICO
+	 * @retval true Si se ha escrito correctamente
+	 * @retval false Si ha habido algún error, que se indica por la salida de error
+	 * @see EscribirRegion()
+	 */
+	bool EscribirImagen(const char img_path[], Tipo_Salida ts=AUTOMATICO) const;
+};
+
+#endif //PRACTICAFINAL_MAPATESELADO_H
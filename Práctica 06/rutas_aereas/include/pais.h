@@ -57,13 +57,13 @@ public:
 	 * @brief Devuelve el nombre del país
 	 * @return Nombre del país
 	 */
-	string getNombre() const;
+	const string & getNombre() const;
 
 	/**
 	 * @brief Devuelve la ubicación de la bandera del país en el sistema de archivos
 	 * @return Filename de la bandera en el sistema de archivos
 	 */
-	string getBandera() const;
+	const string & getBandera() const;
 
 	/**
 	 * @brief Devuelve el punto que representa la posición del país en el mapa
@@ -11,6 +11,8 @@
 #define PRACTICAFINAL_PAISES_H
 
 #include <set>
+#include <vector>
+#include <unordered_map>
 #include "pais.h"
 using namespace std;
 
@@ -18,14 +20,140 @@ using namespace std;
  * @brief TDA Paises
  *
  * Una instancia @e p del tipo de datos abstracto @c Paises es un objeto
- * que representa un conjunto de paises.
+ * que representa un conjunto de paises, sin nombres repetidos, que se recorre
+ * ordenado por nombre.
+ *
+ * Los paises se guardan de forma contigua en un vector, y se mantienen varios índices sobre él:
+ * el orden por nombre, dos tablas hash de direccionamiento abierto (por nombre y por bandera)
+ * y una rejilla sobre latitud y longitud para las búsquedas por punto.
  */
 class Paises {
 private:
 	/**
-	 * @brief Conjunto de paises
+	 * @brief Paises, en posiciones contiguas y sin un orden determinado
+	 */
+	vector<Pais> datos;
+
+	/**
+	 * @brief Posiciones de @a datos ordenadas por el nombre del pais
+	 */
+	vector<int> orden;
+
+	/**
+	 * @brief Inversa de @a orden: posicion[i] es la posición de @a i en @a orden
+	 */
+	vector<int> posicion;
+
+	/**
+	 * @brief Tabla hash con direccionamiento abierto (sondeo lineal) de los nombres
+	 *
+	 * Cada casilla contiene una posición de @a datos, o -1 si está vacía.
+	 * Su tamaño es una potencia de 2 y se mantiene al menos el doble de casillas que paises.
+	 */
+	vector<int> hash_nombre;
+
+	/**
+	 * @brief Tabla hash con direccionamiento abierto (sondeo lineal) de las banderas
+	 *
+	 * Igual que @a hash_nombre, pero puede haber varias casillas con la misma bandera.
+	 */
+	vector<int> hash_bandera;
+
+	/**
+	 * @brief Índice espacial de los paises
+	 *
+	 * Rejilla sobre latitud y longitud con celdas de TAM_CELDA grados. A cada celda no vacía
+	 * se le asocian las posiciones de @a datos de los paises cuyo punto cae dentro de ella.
+	 */
+	unordered_map<long long, vector<int> > rejilla;
+
+	/**
+	 * @brief Tamaño, en grados, de las celdas de la rejilla
+	 */
+	static const double TAM_CELDA;
+
+	/**
+	 * @brief Calcula la fila o columna de la rejilla a la que pertenece una coordenada
+	 * @param grados Latitud o longitud
+	 * @return Fila (si es una latitud) o columna (si es una longitud) de la rejilla
+	 */
+	static int Celda(double grados);
+
+	/**
+	 * @brief Calcula la clave de una celda de la rejilla
+	 * @param fila Fila de la celda
+	 * @param columna Columna de la celda
+	 * @return Clave de la celda en @a rejilla
+	 */
+	static long long Clave(int fila, int columna);
+
+	/**
+	 * @brief Función hash de una cadena (FNV-1a)
+	 * @param s Cadena
+	 * @return Valor hash de la cadena
+	 */
+	static size_t Hash(const string &s);
+
+	/**
+	 * @brief Añade una posición de @a datos a una tabla hash
+	 * @param tabla Tabla hash
+	 * @param clave Clave con la que se inserta
+	 * @param pos Posición de @a datos
+	 * @pre Hay casillas vacías en la tabla
+	 */
+	static void InsertarHash(vector<int> &tabla, const string &clave, int pos);
+
+	/**
+	 * @brief Busca un pais por nombre en @a hash_nombre
+	 * @param nombre Nombre del pais
+	 * @return Posición del pais en @a datos, o -1 si no está
+	 */
+	int BuscarNombre(const string &nombre) const;
+
+	/**
+	 * @brief Añade un pais a @a datos y a todos los índices salvo a @a orden
+	 * @param pais Pais a añadir
+	 * @retval true Si se ha añadido
+	 * @retval false Si ya había un pais con ese nombre
+	 */
+	bool Anadir(const Pais &pais);
+
+	/**
+	 * @brief Reconstruye @a orden y @a posicion a partir de @a datos
+	 */
+	void Ordenar();
+
+	/**
+	 * @brief Reconstruye todos los índices a partir de @a datos
 	 */
-	set<Pais> datos;
+	void Reindexar();
+
+	/**
+	 * @brief Añade los paises de un texto con el formato de operator>>, sin ordenarlos
+	 * @param ini Comienzo del texto
+	 * @param fin Final del texto
+	 */
+	void Parsear(const char *ini, const char *fin);
+
+	/**
+	 * @brief Lee un pais de una línea del fichero de paises
+	 * @param ini Comienzo de la línea
+	 * @param fin Final de la línea (sin el salto de línea)
+	 * @param pais Pais leído
+	 * @retval true Si la línea contiene un pais
+	 * @retval false Si es un comentario, está vacía o no tiene el formato esperado
+	 */
+	static bool LeerPais(const char *ini, const char *fin, Pais &pais);
+
+	/**
+	 * @brief Añade los paises del cuerpo de un fichero binario, sin ordenarlos
+	 * @param cuerpo Comienzo del cuerpo, alineado a 8 bytes
+	 * @param tam Tamaño del cuerpo en bytes
+	 * @retval true Si el cuerpo es coherente
+	 * @retval false En caso contrario
+	 * @see GuardarBinario()
+	 */
+	bool LeerBinario(const char *cuerpo, size_t tam);
 
 public:
 	/**
@@ -46,19 +174,27 @@ public:
 	int size() const;
 
 	/**
-	 * @brief Devuelve el conjunto de paises
-	 * @return Conjunto de paises
+	 * @brief Devuelve los paises tal y como están almacenados
+	 * @return Vector de paises, sin un orden determinado
 	 */
-	const set<Pais>& getDatos() const;
+	const vector<Pais>& getDatos() const;
 
 	/**
 	 * @brief Inserta un nuevo pais en el conjunto
+	 *
+	 * Si ya hay un pais con el mismo nombre, no se modifica el conjunto.
+	 * Es O(n) por tener que mantener el orden por nombre; para cargas masivas
+	 * es preferible operator>>, que ordena una sola vez al final.
+	 *
 	 * @param pais Pais a insertar
 	 */
 	void insertar(const Pais &pais);
 
 	/**
 	 * @brief Elimina un pais del conjunto
+	 *
+	 * Es O(n), ya que reconstruye los índices.
+	 *
 	 * @param pais Pais a eliminar
 	 */
 	void eliminar(const Pais &pais);
@@ -68,41 +204,76 @@ public:
      */
     void clear();
 
+	/**
+	 * @brief Añade al conjunto los paises de un fichero
+	 *
+	 * El fichero tiene el mismo formato que lee operator>>, pero se proyecta en memoria
+	 * y se recorre directamente, sin pasar por flujos.
+	 *
+	 * También acepta los ficheros escritos con GuardarBinario(), que se reconocen por su cabecera
+	 * y se leen sin analizar ningún texto.
+	 *
+	 * @param nombre Nombre del fichero
+	 * @retval true Si se ha podido leer el fichero
+	 * @retval false Si no se ha podido abrir o es un fichero binario dañado
+	 */
+	bool CargarFichero(const string &nombre);
+
+	/**
+	 * @brief Guarda los paises en un fichero binario, que puede leerse con CargarFichero()
+	 *
+	 * Tras la cabecera (ver formatoBinario.h), el cuerpo contiene, con enteros de 64 bits:
+	 * el número de paises y el tamaño de la tabla de cadenas; la latitud y la longitud de cada pais,
+	 * como reales de doble precisión; el comienzo de su nombre y de su bandera en la tabla de cadenas
+	 * (con uno más al final para marcar el final); y la tabla de cadenas. Los paises están ordenados por nombre.
+	 *
+	 * @param nombre Nombre del fichero
+	 * @retval true Si se ha podido escribir
+	 * @retval false En caso contrario
+	 */
+	bool GuardarBinario(const string &nombre) const;
+
 	/**
 	 * @brief Clase iterator
 	 *
-	 * Clase que permite iterar sobre los paises
+	 * Clase que permite iterar sobre los paises, ordenados por nombre
 	 */
 	class iterator{
 	private:
 		/**
-		 * @brief Iterador sobre el conjunto de paises
+		 * @brief Paises sobre los que se itera
+		 */
+		const Paises *paises;
+
+		/**
+		 * @brief Posición en Paises::orden
 		 */
-		set<Pais>::iterator it;
+		int pos;
 	public:
 		/**
 		 * @brief Constructor por defecto de la clase
 		 */
-		iterator(){}
+		iterator(): paises(0), pos(0){}
 
 		/**
 		 * @brief Constructor de la clase
-		 * @param i Iterador sobre el conjunto de paises
+		 * @param p Paises sobre los que se itera
+		 * @param i Posición en el orden por nombre
 		 */
-		iterator(set<Pais>::iterator i){it = i;}
+		iterator(const Paises *p, int i): paises(p), pos(i){}
 
 		/**
 		 * @brief Sobrecarga del operador *
 		 * @return Pais apuntado por el iterador
 		 */
-		const Pais& operator*() {return (*it);}
+		const Pais& operator*() {return paises->datos[paises->orden[pos]];}
 
 		/**
 		 * @brief Sobrecarga del operador ++
 		 * @return Iterador apuntando al siguiente pais
 		 */
         iterator& operator++(){
-            ++it;
+            ++pos;
             return *this;
         }
 
@@ -111,7 +282,7 @@ public:
 		 * @return Iterador apuntando al pais anterior
 		 */
 		iterator& operator--(){
-            --it;
+            --pos;
             return *this;
         }
 
@@ -120,14 +291,14 @@ public:
 		 * @param i Iterador con el que comparar
 		 * @return True si son iguales, false en caso contrario
 		 */
-		bool operator==(const iterator &i) const {return it == i.it;}
+		bool operator==(const iterator &i) const {return paises == i.paises && pos == i.pos;}
 
 		/**
 		 * @brief Sobrecarga del operador !=
 		 * @param i Iterador con el que comparar
 		 * @return True si son distintos, false en caso contrario
 		 */
-		bool operator!=(const iterator &i) const {return it != i.it;}
+		bool operator!=(const iterator &i) const {return !(*this == i);}
 
 		friend class Paises;
 	};
@@ -136,28 +307,66 @@ public:
 	 * @brief Devuelve un iterador al principio del conjunto
 	 * @return Iterador al principio del conjunto
 	 */
-	iterator begin() const{return iterator(datos.begin());}
+	iterator begin() const{return iterator(this, 0);}
 
 	/**
 	 * @brief Devuelve un iterador al final del conjunto
 	 * @return Iterador al final del conjunto
 	 */
-	iterator end() const{return iterator(datos.end());}
+	iterator end() const{return iterator(this, orden.size());}
 
 	/**
 	 * @brief Busca un pais en el conjunto
-	 * @param pais Pais a buscar
+	 * @param pais Pais a buscar. Sólo se tiene en cuenta su nombre
 	 * @return Iterador apuntando al pais buscado, o end() si no se encuentra.
 	 */
 	iterator find(const Pais &pais) const;
 
+	/**
+	 * @brief Busca un pais en el conjunto dado su nombre
+	 * @param nombre Nombre del pais a buscar
+	 * @return Iterador apuntando al pais buscado, o end() si no se encuentra.
+	 */
+	iterator findNombre(const string &nombre) const;
+
+	/**
+	 * @brief Busca un pais en el conjunto dado el fichero de su bandera
+	 * @param bandera Fichero de la bandera
+	 * @return Iterador apuntando al primer pais (por nombre) con esa bandera, o end() si no se encuentra.
+	 */
+	iterator findBandera(const string &bandera) const;
+
 	/**
 	 * @brief Busca un pais en el conjunto dado su punto
+	 *
+	 * Emplea el índice espacial, por lo que sólo se comparan los paises cercanos al punto.
+	 *
 	 * @param punto Punto que representa el pais a buscar
 	 * @return Iterador apuntando al primer pais cuyo punto coincide, o end() si no se encuentra.
 	 */
 	iterator find(const Punto &punto) const;
 
+	/**
+	 * @brief Busca el pais más cercano a un punto
+	 *
+	 * La distancia se mide en grados sobre el plano latitud/longitud, como en el mapa.
+	 *
+	 * @param punto Punto de referencia
+	 * @return Iterador apuntando al pais más cercano, o end() si no hay paises.
+	 */
+	iterator masCercano(const Punto &punto) const;
+
+	/**
+	 * @brief Busca los paises que están a menos de una distancia de un punto
+	 *
+	 * La distancia se mide en grados sobre el plano latitud/longitud, como en el mapa.
+	 *
+	 * @param punto Centro de la búsqueda
+	 * @param radio Distancia máxima, en grados
+	 * @return Iteradores a los paises encontrados, ordenados por nombre
+	 */
+	vector<iterator> enRadio(const Punto &punto, double radio) const;
+
 	friend ostream& operator<<(ostream &os, const Paises &paises);
 	friend istream& operator>>(istream &is, Paises &paises);
 };
@@ -0,0 +1,138 @@
+/**
+ * @file pintorRutas.h
+ * @brief Fichero cabecera del TDA PintorRutas
+ *
+ * Permite dibujar las rutas aéreas sobre un mapa del mundo.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_PINTORRUTAS_H
+#define PRACTICAFINAL_PINTORRUTAS_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "imagen.h"
+#include "paises.h"
+#include "almacenRutas.h"
+#include "arcos.h"
+#include "mapaTeselado.h"
+
+using namespace std;
+
+/**
+ * @brief TDA PintorRutas
+ *
+ * Una instancia del tipo de datos abstracto @c PintorRutas es un objeto que sabe
+ * dibujar una ruta sobre un mapa: dibuja el arco de círculo máximo que sigue cada tramo y,
+ * encima, pega la bandera de cada país por el que pasa la ruta y un avión orientado en cada tramo.
+ *
+ * Puede pintar tanto sobre una Imagen como sobre un MapaTeselado; con este último sólo se copian
+ * y modifican las teselas del mapa que toca la ruta.
+ *
+ * Una vez construido (y, opcionalmente, precargadas las banderas) no se modifica,
+ * por lo que varios hilos pueden pintar rutas a la vez con el mismo pintor,
+ * siempre que cada uno lo haga sobre su propio mapa.
+ */
+class PintorRutas {
+private:
+	/**
+	 * @brief Paises en los que se buscan los puntos de las rutas
+	 */
+	const Paises &paises;
+
+	/**
+	 * @brief Imagen del avión, con su máscara
+	 */
+	const Imagen &avion;
+
+	/**
+	 * @brief Directorio con las banderas
+	 */
+	string dir_banderas;
+
+	/**
+	 * @brief Banderas precargadas, indexadas por el nombre de su fichero
+	 */
+	map<string, Imagen> banderas;
+
+	/**
+	 * @brief Color de los arcos de los tramos. Si es totalmente transparente no se dibujan
+	 */
+	Pixel color_arcos;
+
+	/**
+	 * @brief Devuelve la bandera de un país
+	 *
+	 * Si la bandera está precargada se devuelve directamente; si no, se lee de disco sobre @a aux.
+	 *
+	 * @param pais País del que se quiere la bandera
+	 * @param aux Imagen donde leer la bandera si no está precargada
+	 * @return Referencia a la bandera
+	 */
+	const Imagen & Bandera(const Pais &pais, Imagen &aux) const;
+
+	/**
+	 * @brief Pega una imagen en el mapa y anota la región modificada
+	 * @tparam Lienzo Imagen o MapaTeselado
+	 * @param mapa Mapa sobre el que se pega
+	 * @param i Fila superior donde se pega
+	 * @param j Columna izquierda donde se pega
+	 * @param img Imagen a pegar
+	 * @param tp Tipo de pegado
+	 * @param regiones Si no es nulo, se le añade la región modificada
+	 */
+	template <class Lienzo>
+	static void Pegar(Lienzo &mapa, int i, int j, const Imagen &img, Tipo_Pegado tp, vector<Region> *regiones);
+
+public:
+	/**
+	 * @brief Constructor de la clase
+	 * @param paises Paises en los que buscar los puntos de las rutas
+	 * @param dir_banderas Directorio con las banderas
+	 * @param avion Imagen del avión, con su máscara
+	 */
+	PintorRutas(const Paises &paises, const string &dir_banderas, const Imagen &avion);
+
+	/**
+	 * @brief Lee de disco las banderas de todos los países por los que pasan las rutas de un almacén
+	 *
+	 * Así ninguna llamada posterior a Pintar() tiene que acceder a disco.
+	 *
+	 * @param almacen Almacén de rutas
+	 */
+	void PrecargarBanderas(const AlmacenRutas &almacen);
+
+	/**
+	 * @brief Cambia el color de los arcos de los tramos
+	 *
+	 * Por defecto son rojos y opacos. Con un color totalmente transparente no se dibujan.
+	 *
+	 * @param color Nuevo color
+	 */
+	void setColorArcos(const Pixel &color) {color_arcos = color;}
+
+	/**
+	 * @brief Devuelve el color de los arcos de los tramos
+	 * @return Color de los arcos
+	 */
+	const Pixel & getColorArcos() const {return color_arcos;}
+
+	/**
+	 * @brief Dibuja una ruta sobre un mapa
+	 * @tparam Lienzo Imagen o MapaTeselado
+	 * @param ruta Ruta a dibujar
+	 * @param mapa Mapa sobre el que se dibuja
+	 * @param os Si no es nulo, se escriben en él los nombres de los países por los que pasa la ruta
+	 * @param regiones Si no es nulo, se le añaden las regiones del mapa que se han modificado
+	 * @retval true Si se ha dibujado la ruta
+	 * @retval false Si algún punto de la ruta no corresponde a ningún país
+	 */
+	template <class Lienzo>
+	bool Pintar(const Ruta &ruta, Lienzo &mapa, ostream *os = 0, vector<Region> *regiones = 0) const;
+};
+
+#endif //PRACTICAFINAL_PINTORRUTAS_H
@@ -13,6 +13,11 @@
 
 using namespace std;
 
+/**
+ * @brief Radio medio de la Tierra, en kilómetros
+ */
+#define RADIO_TIERRA 6371.0
+
 /**
  * @brief TDA Punto
  *
@@ -53,13 +58,13 @@ public:
 	 * @brief Devuelve la latitud del punto
 	 * @return Latitud del punto
 	 */
-	double getLatitud() const;
+	double getLatitud() const {return latitud;}
 
 	/**
 	 * @brief Devuelve la longitud del punto
 	 * @return Longitud del punto
 	 */
-	double getLongitud() const;
+	double getLongitud() const {return longitud;}
 
 	/**
 	 * @brief Asigna una latitud al punto
@@ -107,10 +112,73 @@ public:
      */
     double angulo_en_mapa(const Punto & p, int num_columnas, int num_filas) const;
 
+	/**
+	 * @brief Distancia sobre la superficie terrestre (ortodrómica) entre dos puntos
+	 *
+	 * Se calcula con la fórmula del semiverseno (haversine), tomando la Tierra como una esfera.
+	 *
+	 * @param p Punto hasta el que se mide la distancia
+	 * @return Distancia en kilómetros
+	 */
+	double distancia(const Punto & p) const;
+
+	/**
+	 * @brief Rumbo inicial para ir hasta otro punto por el círculo máximo
+	 * @param p Punto de destino
+	 * @return Rumbo en grados en [0, 360), medido desde el norte en el sentido de las agujas del reloj
+	 */
+	double rumbo(const Punto & p) const;
+
+	/**
+	 * @brief Punto intermedio del arco de círculo máximo hasta otro punto
+	 * @param p Punto de destino
+	 * @param fraccion Fracción del camino recorrida: 0 es este punto y 1 el destino
+	 * @return Punto intermedio
+	 * @pre Los puntos no son antípodas (el círculo máximo no estaría definido)
+	 */
+	Punto puntoIntermedio(const Punto & p, double fraccion) const;
+
 	friend ostream & operator<<(ostream & os, const Punto & p);
 	friend istream & operator>>(istream & is, Punto & p);
 };
 
+/**
+ * @brief Rectángulo en latitud y longitud que envuelve a un conjunto de puntos
+ *
+ * Si no envuelve a ningún punto, los mínimos son mayores que los máximos.
+ */
+struct Caja {
+	double lat_min;  ///< Latitud mínima
+	double lat_max;  ///< Latitud máxima
+	double lon_min;  ///< Longitud mínima
+	double lon_max;  ///< Longitud máxima
+
+	/**
+	 * @brief Indica si la caja no envuelve a ningún punto
+	 * @return True si está vacía, false en caso contrario
+	 */
+	bool vacia() const {return lat_min > lat_max || lon_min > lon_max;}
+
+	/**
+	 * @brief Indica si un punto está dentro de la caja (o en su borde)
+	 * @param p Punto
+	 * @return True si está dentro, false en caso contrario
+	 */
+	bool contiene(const Punto &p) const {
+		return p.getLatitud() >= lat_min && p.getLatitud() <= lat_max &&
+			   p.getLongitud() >= lon_min && p.getLongitud() <= lon_max;
+	}
+
+	/**
+	 * @brief Indica si dos cajas se cortan (compartir el borde cuenta como cortarse)
+	 * @param c Caja con la que comparar
+	 * @return True si se cortan, false en caso contrario o si alguna está vacía
+	 */
+	bool solapa(const Caja &c) const {
+		return lat_min <= c.lat_max && c.lat_min <= lat_max && lon_min <= c.lon_max && c.lon_min <= lon_max;
+	}
+};
+
 /**
  * @brief Sobrecarga del operador >>
  * @param is Flujo de entrada
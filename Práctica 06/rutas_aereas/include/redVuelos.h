@@ -0,0 +1,209 @@
+/**
+ * @file redVuelos.h
+ * @brief Fichero cabecera del TDA RedVuelos
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#ifndef PRACTICAFINAL_REDVUELOS_H
+#define PRACTICAFINAL_REDVUELOS_H
+
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include "punto.h"
+#include "almacenRutas.h"
+
+using namespace std;
+
+/**
+ * @brief TDA RedVuelos
+ *
+ * Una instancia del tipo de datos abstracto @c RedVuelos es el grafo dirigido de vuelos que definen
+ * las rutas de un almacén: cada punto distinto (con la tolerancia de Punto::operator==) es un nodo,
+ * y cada par de puntos consecutivos de una ruta es una arista del primero al segundo, cuyo peso es
+ * la distancia ortodrómica entre ellos en kilómetros.
+ *
+ * Las aristas se guardan en formato CSR (compressed sparse row): las que salen del nodo @e i ocupan
+ * las posiciones [inicio[i], inicio[i+1]) de @a destino y @a peso. Los pesos se calculan una única vez
+ * al construir la red.
+ *
+ * La red no cambia tras construirla, por lo que puede consultarse desde varios hilos a la vez.
+ */
+class RedVuelos {
+private:
+	/**
+	 * @brief Puntos de los nodos
+	 */
+	vector<Punto> puntos;
+
+	/**
+	 * @brief Latitud de cada nodo, en radianes
+	 */
+	vector<double> lat_rad;
+
+	/**
+	 * @brief Longitud de cada nodo, en radianes
+	 */
+	vector<double> lon_rad;
+
+	/**
+	 * @brief Coseno de la latitud de cada nodo
+	 */
+	vector<double> cos_lat;
+
+	/**
+	 * @brief Comienzo de las aristas de cada nodo en @a destino y @a peso (uno más que nodos)
+	 */
+	vector<int> inicio;
+
+	/**
+	 * @brief Nodo destino de cada arista
+	 */
+	vector<int> destino;
+
+	/**
+	 * @brief Peso (distancia en kilómetros) de cada arista
+	 */
+	vector<double> peso;
+
+	/**
+	 * @brief Índice de los nodos por celdas de TAM_CELDA grados, para buscarlos por su punto
+	 */
+	unordered_map<long long, vector<int> > celdas;
+
+	/**
+	 * @brief Tamaño, en grados, de las celdas de @a celdas
+	 */
+	static const double TAM_CELDA;
+
+	/**
+	 * @brief Calcula la clave de la celda que contiene a unas coordenadas
+	 * @param lat Latitud
+	 * @param lon Longitud
+	 * @return Clave de la celda
+	 */
+	static long long Celda(double lat, double lon);
+
+	/**
+	 * @brief Busca un nodo y, si no existe, lo crea
+	 * @param p Punto del nodo
+	 * @return Nodo
+	 */
+	int Internar(const Punto &p);
+
+	/**
+	 * @brief Distancia ortodrómica entre dos nodos, en kilómetros, con los datos precalculados
+	 * @param a Nodo
+	 * @param b Nodo
+	 * @return Distancia en kilómetros
+	 */
+	double Distancia(int a, int b) const;
+
+	/**
+	 * @brief Calcula el camino mínimo entre dos nodos
+	 * @param origen Nodo de origen
+	 * @param destino Nodo de destino
+	 * @param heuristica Si es true se usa A* con la distancia ortodrómica al destino; si no, Dijkstra
+	 * @param camino Si no es nulo, se guardan en él los nodos del camino, del origen al destino
+	 * @return Longitud del camino en kilómetros, o -1 si no hay camino
+	 */
+	double Buscar(int origen, int destino, bool heuristica, vector<int> *camino) const;
+
+public:
+	/**
+	 * @brief Constructor por defecto de la clase. Crea una red vacía
+	 */
+	RedVuelos(){}
+
+	/**
+	 * @brief Constructor de la clase
+	 * @param almacen Almacén de rutas del que se obtiene la red
+	 */
+	RedVuelos(const AlmacenRutas &almacen);
+
+	/**
+	 * @brief Construye la red de un almacén de rutas, descartando la que hubiera
+	 * @param almacen Almacén de rutas
+	 */
+	void Construir(const AlmacenRutas &almacen);
+
+	/**
+	 * @brief Devuelve el número de nodos
+	 * @return Número de nodos
+	 */
+	int numNodos() const {return puntos.size();}
+
+	/**
+	 * @brief Devuelve el número de aristas (sin contar las repetidas)
+	 * @return Número de aristas
+	 */
+	int numAristas() const {return destino.size();}
+
+	/**
+	 * @brief Devuelve el punto de un nodo
+	 * @param nodo Nodo
+	 * @return Punto del nodo
+	 * @pre 0 <= nodo < numNodos()
+	 */
+	const Punto & getPunto(int nodo) const {return puntos[nodo];}
+
+	/**
+	 * @brief Busca el nodo de un punto
+	 * @param p Punto (se compara con Punto::operator==)
+	 * @return Nodo, o -1 si el punto no está en la red
+	 */
+	int buscarNodo(const Punto &p) const;
+
+	/**
+	 * @brief Calcula el camino mínimo entre dos nodos con el algoritmo de Dijkstra
+	 * @param origen Nodo de origen
+	 * @param destino Nodo de destino
+	 * @param camino Si no es nulo, se guardan en él los nodos del camino, del origen al destino
+	 * @return Longitud del camino en kilómetros, o -1 si no hay camino
+	 */
+	double Dijkstra(int origen, int destino, vector<int> *camino = 0) const;
+
+	/**
+	 * @brief Calcula el camino mínimo entre dos nodos con el algoritmo A*
+	 *
+	 * La heurística es la distancia ortodrómica hasta el destino, que nunca es mayor que la longitud
+	 * de ningún camino hasta él, así que el resultado es el mismo que el de Dijkstra, expandiendo
+	 * normalmente muchos menos nodos.
+	 *
+	 * @param origen Nodo de origen
+	 * @param destino Nodo de destino
+	 * @param camino Si no es nulo, se guardan en él los nodos del camino, del origen al destino
+	 * @return Longitud del camino en kilómetros, o -1 si no hay camino
+	 */
+	double AEstrella(int origen, int destino, vector<int> *camino = 0) const;
+
+	/**
+	 * @brief Calcula las distancias desde un nodo a todos los demás (Dijkstra completo)
+	 * @param origen Nodo de origen
+	 * @return Distancia en kilómetros a cada nodo, o -1 para los que no son alcanzables
+	 */
+	vector<double> Distancias(int origen) const;
+
+	/**
+	 * @brief Calcula, con A*, el camino mínimo de un lote de pares origen-destino, repartiéndolos entre varios hilos
+	 * @param consultas Pares (origen, destino)
+	 * @param num_hilos Número de hilos
+	 * @param caminos Si no es nulo, se guarda en él el camino de cada consulta
+	 * @return Longitud de cada camino en kilómetros, o -1 si no hay camino
+	 */
+	vector<double> CaminosMinimos(const vector<pair<int,int> > &consultas, int num_hilos,
+								  vector<vector<int> > *caminos = 0) const;
+
+	/**
+	 * @brief Calcula las distancias desde varios nodos a todos los demás, repartiéndolos entre varios hilos
+	 * @param origenes Nodos de origen
+	 * @param num_hilos Número de hilos
+	 * @return Para cada origen, lo mismo que Distancias()
+	 */
+	vector<vector<double> > Distancias(const vector<int> &origenes, int num_hilos) const;
+};
+
+#endif //PRACTICAFINAL_REDVUELOS_H
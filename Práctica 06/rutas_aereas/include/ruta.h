@@ -11,6 +11,7 @@
 #define PRACTICAFINAL_RUTA_H
 
 #include <list>
+#include <vector>
 #include <string>
 #include "punto.h"
 
@@ -21,11 +22,13 @@ using namespace std;
  * @brief TDA Ruta
  *
  * Una instancia del tipo de dato abstracto Ruta es un objeto que representa una ruta aerea
- * formada por una lista de puntos y un codigo de ruta.
+ * formada por una secuencia de puntos y un codigo de ruta.
+ *
+ * Los puntos se guardan de forma contigua en un vector.
  */
 class Ruta {
 private:
-	std::list<Punto> puntos;
+	vector<Punto> puntos;
 	string codigo;
 
 public:
@@ -42,6 +45,13 @@ public:
 	 */
 	Ruta(string codigo, const list<Punto> &puntos);
 
+	/**
+	 * @brief Constructor de la clase que se queda con el vector de puntos, sin copiarlo
+	 * @param codigo Codigo de la ruta
+	 * @param puntos Vector de puntos que forman la ruta
+	 */
+	Ruta(string codigo, vector<Punto> &&puntos);
+
 	/**
 	 * @brief Método que modifica el codigo de la ruta
 	 * @param codigo Nuevo codigo de la ruta
@@ -54,6 +64,18 @@ public:
 	 */
 	void setPuntos(const list<Punto> &puntos);
 
+	/**
+	 * @brief Método que modifica los puntos de la ruta
+	 * @param puntos  Nuevo vector de puntos de la ruta
+	 */
+	void setPuntos(const vector<Punto> &puntos);
+
+	/**
+	 * @brief Método que modifica los puntos de la ruta, sin copiarlos
+	 * @param puntos  Nuevo vector de puntos de la ruta
+	 */
+	void setPuntos(vector<Punto> &&puntos);
+
 	/**
 	 * @brief Método que devuelve el codigo de la ruta
 	 * @return Codigo de la ruta
@@ -61,10 +83,10 @@ public:
 	string getCodigo() const;
 
 	/**
-	 * @brief Método que devuelve la lista de puntos de la ruta
-	 * @return Lista de puntos de la ruta
+	 * @brief Método que devuelve los puntos de la ruta
+	 * @return Vector de puntos de la ruta
 	 */
-	const list<Punto> & getPuntos() const;
+	const vector<Punto> & getPuntos() const;
 
 	/**
 	 * @brief Método que devuelve el numero de puntos de la ruta
@@ -84,6 +106,19 @@ public:
 	 */
 	void eliminarPunto(const Punto& p);
 
+	/**
+	 * @brief Método que calcula la longitud total de la ruta
+	 * @return Suma de las distancias ortodrómicas de todos los tramos, en kilómetros
+	 * @see Punto::distancia()
+	 */
+	double longitudTotal() const;
+
+	/**
+	 * @brief Método que calcula la caja que envuelve a la ruta
+	 * @return Menor caja que contiene todos los puntos de la ruta. Vacía si la ruta no tiene puntos
+	 */
+	Caja caja() const;
+
 
 	class const_iterator;
 
@@ -93,9 +128,9 @@ public:
 	class iterator{
 	private:
 		/**
-		 * @brief Iterador de la lista de puntos
+		 * @brief Iterador del vector de puntos
 		 */
-		list<Punto>::iterator it;
+		vector<Punto>::iterator it;
 	public:
 		/**
 		 * @brief Constructor por defecto
@@ -104,9 +139,9 @@ public:
 
 		/**
 		 * @brief Constructor de la clase
-		 * @param it Iterador de la lista de puntos
+		 * @param it Iterador del vector de puntos
 		 */
-		iterator(const list<Punto>::iterator& it):it(it){}
+		iterator(const vector<Punto>::iterator& it):it(it){}
 
 		/**
 		 * @brief Operador de incremento
@@ -159,8 +194,8 @@ public:
 	};
 
 	/**
-	 * @brief Devuelve un iterador al principio de la lista de puntos
-	 * @return  Iterador al principio de la lista de puntos
+	 * @brief Devuelve un iterador al principio del vector de puntos
+	 * @return  Iterador al principio del vector de puntos
 	 */
 	iterator begin(){
 		iterator i;
@@ -169,8 +204,8 @@ public:
 	}
 
 	/**
-	 * @brief Devuelve un iterador al final de la lista de puntos
-	 * @return  Iterador al final de la lista de puntos
+	 * @brief Devuelve un iterador al final del vector de puntos
+	 * @return  Iterador al final del vector de puntos
 	 */
 	iterator end(){
 		iterator i;
@@ -184,9 +219,9 @@ public:
 	class const_iterator{
 	private:
 		/**
-		 * @brief Iterador constante de la lista de puntos
+		 * @brief Iterador constante del vector de puntos
 		 */
-		list<Punto>::const_iterator it;
+		vector<Punto>::const_iterator it;
 	public:
 		/**
 		 * @brief Constructor por defecto
@@ -195,9 +230,9 @@ public:
 
 		/**
 		 * @brief Constructor de la clase
-		 * @param it Iterador constante de la lista de puntos
+		 * @param it Iterador constante del vector de puntos
 		 */
-		const_iterator(const list<Punto>::const_iterator& it):it(it){}
+		const_iterator(const vector<Punto>::const_iterator& it):it(it){}
 
 		/**
 		 * @brief Operador de incremento
@@ -248,8 +283,8 @@ public:
 	};
 
 	/**
-	 * @brief Devuelve un iterador constante al principio de la lista de puntos
-	 * @return  Iterador constante al principio de la lista de puntos
+	 * @brief Devuelve un iterador constante al principio del vector de puntos
+	 * @return  Iterador constante al principio del vector de puntos
 	 */
 	const_iterator begin() const{
 		const_iterator i;
@@ -258,8 +293,8 @@ public:
 	}
 
 	/**
-	 * @brief Devuelve un iterador constante al final de la lista de puntos
-	 * @return  Iterador constante al final de la lista de puntos
+	 * @brief Devuelve un iterador constante al final del vector de puntos
+	 * @return  Iterador constante al final del vector de puntos
 	 */
 	const_iterator end() const{
 		const_iterator i;
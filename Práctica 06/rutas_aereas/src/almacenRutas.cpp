@@ -8,16 +8,30 @@
  */
 
 #include "almacenRutas.h"
+#include "formatoBinario.h"
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <iterator>
 using namespace std;
 
 #define MAGIC_CAD "#Rutas"
+#define MAGIA_BINARIA "RUTASBIN"
+
+const double AlmacenRutas::TAM_CELDA = 1e-4;
 
 AlmacenRutas::AlmacenRutas(const map<string, Ruta> &rutas) {
 	this->rutas = rutas;
+	Reindexar();
+}
+
+long long AlmacenRutas::Celda(double lat, double lon) {
+	long long fila = (long long) floor(lat / TAM_CELDA), columna = (long long) floor(lon / TAM_CELDA);
+	return (fila << 32) ^ (unsigned int) columna;
 }
 
 const Ruta& AlmacenRutas::getRuta(string codigo) {
-	return rutas[codigo];
+	return rutas.at(codigo);
 }
 
 bool AlmacenRutas::existeRuta(string codigo) {
@@ -25,17 +39,419 @@ bool AlmacenRutas::existeRuta(string codigo) {
 }
 
 void AlmacenRutas::insertarRuta(const Ruta &ruta) {
-	rutas.insert(pair<string, Ruta>(ruta.getCodigo(), ruta));
+	pair<map<string, Ruta>::iterator, bool> res = rutas.insert(pair<string, Ruta>(ruta.getCodigo(), ruta));
+	if (res.second)
+		Indexar(res.first->second);
+}
+
+void AlmacenRutas::insertarRuta(Ruta &&ruta) {
+	const Ruta *anadida = Anadir(move(ruta));
+	if (anadida != 0)
+		Indexar(*anadida);
+}
+
+const Ruta *AlmacenRutas::Anadir(Ruta &&ruta) {
+	string codigo = ruta.getCodigo();
+	if (rutas.find(codigo) != rutas.end())
+		return 0;
+	return &rutas.insert(pair<string, Ruta>(move(codigo), move(ruta))).first->second;
+}
+
+bool AlmacenRutas::LeerRuta(Lector &lector, Ruta &ruta) {
+	string codigo;
+	int num_puntos;
+	if (!lector.LeerPalabra(codigo) || !lector.LeerEntero(num_puntos))
+		return false;
+
+	vector<Punto> puntos;
+	puntos.reserve(min(max(num_puntos, 0), 4096));  // Sin fiarnos de un número de puntos desmesurado
+	double lat, lon;
+	char c;
+	for (int i = 0; i < num_puntos; ++i) {
+		// Cada punto tiene la forma (latitud,longitud)
+		if (!lector.LeerCaracter(c) || !lector.LeerDouble(lat) || !lector.LeerCaracter(c) ||
+			!lector.LeerDouble(lon) || !lector.LeerCaracter(c))
+			return false;
+		puntos.push_back(Punto(lat, lon));
+	}
+
+	ruta.setCodigo(move(codigo));
+	ruta.setPuntos(move(puntos));
+	return true;
+}
+
+bool AlmacenRutas::LeerRutas(const char *ini, const char *fin, vector<Ruta> &rutas) {
+	Lector lector(ini, fin);
+	Ruta ruta;
+	while (LeerRuta(lector, ruta))
+		rutas.push_back(move(ruta));
+
+	lector.SaltarBlancos();
+	return lector.Fin();
+}
+
+/**
+ * @brief Busca el comienzo de la siguiente línea que empiece una ruta
+ * @param p Posición desde la que buscar
+ * @param fin Final del texto
+ * @return Comienzo de la línea, o @a fin si no hay más rutas
+ */
+static const char * SiguienteRuta(const char *p, const char *fin) {
+	while (p < fin) {
+		const char *linea = (const char *) memchr(p, '\n', fin - p);
+		if (linea == 0)
+			return fin;
+		linea++;
+
+		// Los puntos de una ruta pueden continuar en la línea siguiente
+		const char *q = linea;
+		while (q < fin && (*q == ' ' || *q == '\t' || *q == '\r'))
+			q++;
+		if (q < fin && *q != '(' && *q != '\n')
+			return linea;
+		p = linea;
+	}
+	return fin;
+}
+
+bool AlmacenRutas::Parsear(const char *ini, const char *fin, int num_hilos) {
+	if (num_hilos < 1)
+		num_hilos = 1;
+
+	// Cortes entre los trozos de cada hilo
+	vector<const char *> cortes(1, ini);
+	for (int h = 1; h < num_hilos; h++) {
+		const char *corte = SiguienteRuta(max(ini + (fin - ini) / num_hilos * h, cortes.back()), fin);
+		if (corte > cortes.back() && corte < fin)
+			cortes.push_back(corte);
+	}
+	cortes.push_back(fin);
+
+	int trozos = cortes.size() - 1;
+	vector<vector<Ruta> > leidas(trozos);
+	vector<char> correcto(trozos, true);
+	if (trozos == 1)
+		correcto[0] = LeerRutas(ini, fin, leidas[0]);
+	else {
+		vector<thread> hilos;
+		for (int t = 0; t < trozos; t++)
+			hilos.push_back(thread([&, t]() {
+				correcto[t] = LeerRutas(cortes[t], cortes[t + 1], leidas[t]);
+			}));
+		for (int t = 0; t < trozos; t++)
+			hilos[t].join();
+	}
+
+	// Como al leer secuencialmente, nos quedamos con las rutas anteriores a la primera mal formada.
+	// Los índices se construyen al final, de una vez
+	bool todo = true;
+	for (int t = 0; t < trozos && todo; t++) {
+		for (size_t i = 0; i < leidas[t].size(); i++)
+			Anadir(move(leidas[t][i]));
+		todo = correcto[t];
+	}
+	Reindexar();
+	return todo;
+}
+
+bool AlmacenRutas::CargarFichero(const string &nombre, int num_hilos) {
+	FicheroMapeado fichero;
+	if (!fichero.Abrir(nombre)) {
+		cerr << "Error de apertura del fichero " << nombre << endl;
+		return false;
+	}
+
+	if (EsBinario(fichero, MAGIA_BINARIA)) {
+		const char *cuerpo;
+		size_t tam;
+		if (!AbrirBinario(fichero, MAGIA_BINARIA, cuerpo, tam) || !LeerBinario(cuerpo, tam)) {
+			cerr << "El fichero binario " << nombre << " está dañado o es de otra versión" << endl;
+			return false;
+		}
+		return true;
+	}
+
+	Lector lector(fichero.begin(), fichero.end());
+	string cadena;
+	if (!lector.LeerPalabra(cadena) || cadena != MAGIC_CAD) {
+		cerr << "El fichero " << nombre << " no es un almacen de rutas" << endl;
+		return false;
+	}
+
+	if (!Parsear(lector.Posicion(), fichero.end(), num_hilos)) {
+		cerr << "Ruta mal formada en el fichero " << nombre << endl;
+		return false;
+	}
+	return true;
 }
 
 void AlmacenRutas::eliminarRuta(string codigo) {
-	rutas.erase(codigo);
+	map<string, Ruta>::iterator it = rutas.find(codigo);
+	if (it != rutas.end()) {
+		Desindexar(it->second);
+		rutas.erase(it);
+
+		// Una ruta borrada sigue ocupando sitio en los índices principales hasta que se reconstruyen
+		if (cambios > 64 + rutas.size() / 64)
+			Reindexar();
+	}
+}
+
+/**
+ * @brief Orden de las paradas por su celda
+ */
+struct MenorCelda {
+	template <class Parada>
+	bool operator()(const Parada &p, long long celda) const { return p.celda < celda; }
+	template <class Parada>
+	bool operator()(long long celda, const Parada &p) const { return celda < p.celda; }
+	template <class Parada>
+	bool operator()(const Parada &p, const Parada &q) const { return p.celda < q.celda; }
+};
+
+vector<string> AlmacenRutas::rutasPorPunto(const Punto &punto) const {
+	// Celdas que pueden contener puntos iguales (con la tolerancia de Punto::operator==)
+	const double TOL = 1e-5;
+	double lat = punto.getLatitud(), lon = punto.getLongitud();
+	long long celdas[4] = {Celda(lat - TOL, lon - TOL), Celda(lat - TOL, lon + TOL),
+						   Celda(lat + TOL, lon - TOL), Celda(lat + TOL, lon + TOL)};
+	sort(celdas, celdas + 4);
+
+	vector<string> resultado;
+	for (int c = 0; c < 4; c++) {
+		if (c > 0 && celdas[c] == celdas[c - 1])
+			continue;
+		const vector<Parada> *indices[2] = {&paradas, &paradas_nuevas};
+		for (int k = 0; k < 2; k++) {
+			pair<vector<Parada>::const_iterator, vector<Parada>::const_iterator> celda =
+					equal_range(indices[k]->begin(), indices[k]->end(), celdas[c], MenorCelda());
+			for (vector<Parada>::const_iterator p = celda.first; p != celda.second; ++p)
+				if (p->ruta != 0 && p->punto == punto)
+					resultado.push_back(p->ruta->getCodigo());
+		}
+	}
+
+	sort(resultado.begin(), resultado.end());
+	resultado.erase(unique(resultado.begin(), resultado.end()), resultado.end());
+	return resultado;
+}
+
+vector<string> AlmacenRutas::rutasPorPais(const Pais &pais) const {
+	return rutasPorPunto(pais.getPunto());
+}
+
+void AlmacenRutas::Reindexar() {
+	// Una sola pasada por las rutas para los dos índices
+	size_t num_paradas = 0;
+	for (map<string, Ruta>::const_iterator it = rutas.begin(); it != rutas.end(); ++it)
+		num_paradas += it->second.getPuntos().size();
+
+	vector<Caja> cajas;
+	cajas.reserve(rutas.size());
+	rutas_arbol.clear();
+	rutas_arbol.reserve(rutas.size());
+	paradas.clear();
+	paradas.reserve(num_paradas);
+	for (map<string, Ruta>::const_iterator it = rutas.begin(); it != rutas.end(); ++it) {
+		const Ruta *ruta = &it->second;
+		rutas_arbol.push_back(ruta);
+		cajas.push_back(ruta->caja());
+
+		const vector<Punto> &puntos = ruta->getPuntos();
+		for (size_t i = 0; i < puntos.size(); i++) {
+			Parada parada = {Celda(puntos[i].getLatitud(), puntos[i].getLongitud()), puntos[i], ruta};
+			paradas.push_back(parada);
+		}
+	}
+
+	sort(paradas.begin(), paradas.end(), MenorCelda());
+	arbol.Construir(cajas);
+	paradas_nuevas.clear();
+	rutas_nuevas.clear();
+	cambios = 0;
+}
+
+void AlmacenRutas::Indexar(const Ruta &ruta) {
+	// Reconstruir cuesta O(n log n): se hace cuando los cambios llegan a una fracción de las rutas,
+	// así que cada cambio cuesta O(log n) amortizado y los índices aparte siguen siendo pequeños
+	if (++cambios > 64 + rutas.size() / 64) {
+		Reindexar();
+		return;
+	}
+
+	const vector<Punto> &puntos = ruta.getPuntos();
+	for (size_t i = 0; i < puntos.size(); i++) {
+		Parada parada = {Celda(puntos[i].getLatitud(), puntos[i].getLongitud()), puntos[i], &ruta};
+		paradas_nuevas.insert(upper_bound(paradas_nuevas.begin(), paradas_nuevas.end(), parada, MenorCelda()), parada);
+	}
+	rutas_nuevas.push_back(&ruta);
+}
+
+void AlmacenRutas::Desindexar(const Ruta &ruta) {
+	// Si se insertó tras la última reconstrucción, sólo está en los índices aparte
+	vector<const Ruta *>::iterator nueva = find(rutas_nuevas.begin(), rutas_nuevas.end(), &ruta);
+	const vector<Punto> &puntos = ruta.getPuntos();
+	if (nueva != rutas_nuevas.end()) {
+		rutas_nuevas.erase(nueva);
+		for (size_t i = 0; i < puntos.size(); i++) {
+			long long celda = Celda(puntos[i].getLatitud(), puntos[i].getLongitud());
+			vector<Parada>::iterator ini = lower_bound(paradas_nuevas.begin(), paradas_nuevas.end(), celda, MenorCelda());
+			vector<Parada>::iterator fin = upper_bound(ini, paradas_nuevas.end(), celda, MenorCelda());
+			for (vector<Parada>::iterator p = ini; p != fin; ++p)
+				if (p->ruta == &ruta) {
+					paradas_nuevas.erase(p);
+					break;
+				}
+		}
+	}
+	else {
+		// En los índices principales sólo se marca como borrada
+		for (size_t i = 0; i < puntos.size(); i++) {
+			long long celda = Celda(puntos[i].getLatitud(), puntos[i].getLongitud());
+			pair<vector<Parada>::iterator, vector<Parada>::iterator> rango =
+					equal_range(paradas.begin(), paradas.end(), celda, MenorCelda());
+			for (vector<Parada>::iterator p = rango.first; p != rango.second; ++p)
+				if (p->ruta == &ruta)
+					p->ruta = 0;
+		}
+		vector<int> candidatas = arbol.Buscar(ruta.caja());
+		for (size_t i = 0; i < candidatas.size(); i++)
+			if (rutas_arbol[candidatas[i]] == &ruta)
+				rutas_arbol[candidatas[i]] = 0;
+	}
+	cambios++;
+}
+
+/**
+ * @brief Indica si un segmento del plano latitud/longitud tiene algún punto dentro de una caja
+ *
+ * Recorta el segmento con cada lado de la caja (algoritmo de Liang-Barsky).
+ *
+ * @param a Extremo inicial
+ * @param b Extremo final
+ * @param c Caja
+ * @return True si el segmento corta a la caja, false en caso contrario
+ */
+static bool SegmentoEnCaja(const Punto &a, const Punto &b, const Caja &c) {
+	double x0 = a.getLongitud(), y0 = a.getLatitud();
+	double dx = b.getLongitud() - x0, dy = b.getLatitud() - y0;
+	double p[4] = {-dx, dx, -dy, dy};
+	double q[4] = {x0 - c.lon_min, c.lon_max - x0, y0 - c.lat_min, c.lat_max - y0};
+
+	double t0 = 0, t1 = 1;
+	for (int i = 0; i < 4; i++) {
+		if (p[i] == 0) {
+			if (q[i] < 0)
+				return false;  // Paralelo al lado y por fuera
+		}
+		else {
+			double t = q[i] / p[i];
+			if (p[i] < 0)
+				t0 = max(t0, t);
+			else
+				t1 = min(t1, t);
+			if (t0 > t1)
+				return false;
+		}
+	}
+	return true;
+}
+
+vector<string> AlmacenRutas::rutasEnCaja(const Caja &caja) const {
+	// Candidatas: las del árbol cuya caja corta a la buscada y todas las insertadas después
+	vector<const Ruta *> candidatas;
+	vector<int> ids = arbol.Buscar(caja);
+	for (size_t i = 0; i < ids.size(); i++)
+		if (rutas_arbol[ids[i]] != 0)
+			candidatas.push_back(rutas_arbol[ids[i]]);
+	candidatas.insert(candidatas.end(), rutas_nuevas.begin(), rutas_nuevas.end());
+
+	vector<string> resultado;
+	for (size_t i = 0; i < candidatas.size(); i++) {
+		const vector<Punto> &puntos = candidatas[i]->getPuntos();
+
+		bool atraviesa = puntos.size() == 1 && caja.contiene(puntos[0]);
+		for (size_t k = 1; k < puntos.size() && !atraviesa; k++)
+			atraviesa = SegmentoEnCaja(puntos[k - 1], puntos[k], caja);
+		if (atraviesa)
+			resultado.push_back(candidatas[i]->getCodigo());
+	}
+
+	sort(resultado.begin(), resultado.end());
+	return resultado;
 }
 
 int AlmacenRutas::getNumRutas() const {
 	return rutas.size();
 }
 
+bool AlmacenRutas::GuardarBinario(const string &nombre) const {
+	vector<uint64_t> inicio_puntos(1, 0), inicio_codigos(1, 0);
+	vector<double> coordenadas;
+	string cadenas;
+
+	for (map<string, Ruta>::const_iterator it = rutas.begin(); it != rutas.end(); ++it) {
+		const vector<Punto> &puntos = it->second.getPuntos();
+		for (size_t k = 0; k < puntos.size(); k++) {
+			coordenadas.push_back(puntos[k].getLatitud());
+			coordenadas.push_back(puntos[k].getLongitud());
+		}
+		cadenas += it->first;
+		inicio_puntos.push_back(coordenadas.size() / 2);
+		inicio_codigos.push_back(cadenas.size());
+	}
+
+	uint64_t tamanos[3] = {rutas.size(), coordenadas.size() / 2, cadenas.size()};
+	vector<char> cuerpo;
+	cuerpo.reserve(sizeof(tamanos) + 8 * (inicio_puntos.size() + inicio_codigos.size() + coordenadas.size()) + cadenas.size());
+	AnadirBinario(cuerpo, tamanos, 3);
+	AnadirBinario(cuerpo, inicio_puntos);
+	AnadirBinario(cuerpo, inicio_codigos);
+	AnadirBinario(cuerpo, coordenadas);
+	AnadirBinario(cuerpo, cadenas.data(), cadenas.size());
+
+	if (!GuardarFicheroBinario(nombre, MAGIA_BINARIA, cuerpo)) {
+		cerr << "Error de escritura del fichero " << nombre << endl;
+		return false;
+	}
+	return true;
+}
+
+bool AlmacenRutas::LeerBinario(const char *cuerpo, size_t tam) {
+	if (tam < 3 * sizeof(uint64_t))
+		return false;
+
+	const uint64_t *tamanos = (const uint64_t *) cuerpo;
+	uint64_t num_rutas = tamanos[0], num_puntos = tamanos[1], tam_cadenas = tamanos[2];
+	if (num_rutas > tam / 16 || num_puntos > tam / 16 || tam_cadenas > tam ||
+		tam != 8 * (3 + 2 * (num_rutas + 1)) + 16 * num_puntos + tam_cadenas)
+		return false;
+
+	const uint64_t *inicio_puntos = tamanos + 3;
+	const uint64_t *inicio_codigos = inicio_puntos + num_rutas + 1;
+	const double *coordenadas = (const double *) (inicio_codigos + num_rutas + 1);
+	const char *cadenas = (const char *) (coordenadas + 2 * num_puntos);
+
+	if (inicio_puntos[num_rutas] != num_puntos || inicio_codigos[num_rutas] != tam_cadenas)
+		return false;
+	for (uint64_t i = 0; i < num_rutas; i++)
+		if (inicio_puntos[i] > inicio_puntos[i + 1] || inicio_codigos[i] > inicio_codigos[i + 1])
+			return false;
+
+	// Las rutas vienen ordenadas por código, así que cada una se inserta al final del mapa
+	for (uint64_t i = 0; i < num_rutas; i++) {
+		vector<Punto> puntos;
+		puntos.reserve(inicio_puntos[i + 1] - inicio_puntos[i]);
+		for (uint64_t k = inicio_puntos[i]; k < inicio_puntos[i + 1]; k++)
+			puntos.push_back(Punto(coordenadas[2 * k], coordenadas[2 * k + 1]));
+
+		string codigo(cadenas + inicio_codigos[i], cadenas + inicio_codigos[i + 1]);
+		rutas.insert(rutas.end(), pair<string, Ruta>(codigo, Ruta(codigo, move(puntos))));
+	}
+	Reindexar();
+	return true;
+}
+
 ostream & operator<<(ostream & os, const AlmacenRutas & ar) {
 
 	//os << MAGIC_CAD << endl;
@@ -48,18 +464,14 @@ ostream & operator<<(ostream & os, const AlmacenRutas & ar) {
 }
 
 istream & operator>>(istream & is, AlmacenRutas & ar) {
-	Ruta ruta;
+	// Leemos todo el flujo de una vez y lo analizamos como CargarFichero(), sin una extracción por campo
+	string texto((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+	const char *fin = texto.data() + texto.size();
 
+	Lector lector(texto.data(), fin);
 	string cadena;
-	is >> cadena;
-
-	if (cadena != MAGIC_CAD) {
-		exit (-1);
-	}
-
-	while (is >> ruta) {
-		ar.insertarRuta(ruta);
-	}
+	if (!lector.LeerPalabra(cadena) || cadena != MAGIC_CAD || !ar.Parsear(lector.Posicion(), fin, 1))
+		is.setstate(ios::failbit);
 
 	return is;
 }
\ No newline at end of file
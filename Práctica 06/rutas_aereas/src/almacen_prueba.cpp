@@ -0,0 +1,162 @@
+/**
+ * @file almacen_prueba.cpp
+ * @brief Comprueba los índices de AlmacenRutas comparándolos con una búsqueda por fuerza bruta
+ *
+ * Crea un almacén de rutas aleatorias intercalando inserciones y borrados, y tras cada bloque de
+ * cambios compara AlmacenRutas::rutasPorPunto(), AlmacenRutas::rutasPorPais() y
+ * AlmacenRutas::rutasEnCaja() con el resultado de recorrer todas las rutas. Los puntos se toman
+ * de una rejilla con una pequeña perturbación, para que varias rutas compartan puntos y haya
+ * puntos iguales (según Punto::operator==) a ambos lados del borde de una celda del índice.
+ *
+ * @param NumeroDeRutas Número de rutas que se insertan. Opcional, por defecto 2000.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./almacen_prueba 2000
+ * @endcode
+ *
+ * Muestra el número de comprobaciones y de errores, y termina con 0 si no hay errores.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <list>
+#include "almacenRutas.h"
+
+using namespace std;
+
+/**
+ * @brief Real aleatorio en [a, b]
+ */
+double Aleatorio(double a, double b) {
+	return a + (b - a) * rand() / RAND_MAX;
+}
+
+/**
+ * @brief Punto aleatorio de una rejilla de 20x20 puntos separados un tamaño de celda del índice,
+ * desplazado menos de la tolerancia de Punto::operator==
+ */
+Punto PuntoAleatorio() {
+	return Punto(40 + (rand() % 20) * 1e-4 + Aleatorio(-4e-6, 4e-6),
+	             -3 + (rand() % 20) * 1e-4 + Aleatorio(-4e-6, 4e-6));
+}
+
+/**
+ * @brief Indica si un segmento tiene algún punto dentro de una caja, recortándolo contra ella
+ */
+bool SegmentoCorta(const Punto &a, const Punto &b, const Caja &c) {
+	double t0 = 0, t1 = 1;
+	double p[2] = {a.getLatitud(), a.getLongitud()}, d[2] = {b.getLatitud() - p[0], b.getLongitud() - p[1]};
+	double lo[2] = {c.lat_min, c.lon_min}, hi[2] = {c.lat_max, c.lon_max};
+	for (int k = 0; k < 2; k++) {
+		if (d[k] == 0) {
+			if (p[k] < lo[k] || p[k] > hi[k])
+				return false;
+			continue;
+		}
+		double ta = (lo[k] - p[k]) / d[k], tb = (hi[k] - p[k]) / d[k];
+		if (ta > tb)
+			swap(ta, tb);
+		t0 = max(t0, ta);
+		t1 = min(t1, tb);
+	}
+	return t0 <= t1;
+}
+
+/**
+ * @brief Rutas que pasan por un punto, recorriendo todas
+ */
+vector<string> PorPuntoBruta(const vector<Ruta> &rutas, const Punto &punto) {
+	vector<string> resultado;
+	for (size_t i = 0; i < rutas.size(); i++) {
+		const vector<Punto> &puntos = rutas[i].getPuntos();
+		if (find(puntos.begin(), puntos.end(), punto) != puntos.end())
+			resultado.push_back(rutas[i].getCodigo());
+	}
+	sort(resultado.begin(), resultado.end());
+	return resultado;
+}
+
+/**
+ * @brief Rutas que atraviesan una caja, recorriendo todas
+ */
+vector<string> EnCajaBruta(const vector<Ruta> &rutas, const Caja &caja) {
+	vector<string> resultado;
+	for (size_t i = 0; i < rutas.size(); i++) {
+		const vector<Punto> &puntos = rutas[i].getPuntos();
+		bool atraviesa = puntos.size() == 1 && SegmentoCorta(puntos[0], puntos[0], caja);
+		for (size_t k = 1; k < puntos.size() && !atraviesa; k++)
+			atraviesa = SegmentoCorta(puntos[k - 1], puntos[k], caja);
+		if (atraviesa)
+			resultado.push_back(rutas[i].getCodigo());
+	}
+	sort(resultado.begin(), resultado.end());
+	return resultado;
+}
+
+int main(int argc, char *argv[]) {
+	int nrutas = (argc > 1) ? atoi(argv[1]) : 2000;
+
+	if (argc > 2 || nrutas <= 0) {
+		cerr << "Uso: almacen_prueba [NumeroDeRutas]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	AlmacenRutas almacen;
+	vector<Ruta> vivas;
+	long long comprobaciones = 0, errores = 0;
+
+	for (int i = 0; i < nrutas; i++) {
+		list<Punto> puntos;
+		int npuntos = 1 + rand() % 6;
+		for (int k = 0; k < npuntos; k++)
+			puntos.push_back(PuntoAleatorio());
+		Ruta ruta("R" + to_string(i), puntos);
+		almacen.insertarRuta(ruta);
+		vivas.push_back(ruta);
+
+		// Uno de cada tres pasos borra una ruta al azar
+		if (i % 3 == 2) {
+			size_t k = rand() % vivas.size();
+			almacen.eliminarRuta(vivas[k].getCodigo());
+			vivas.erase(vivas.begin() + k);
+		}
+
+		// Cada bloque de cambios se comprueba con varias consultas, en el almacén y en una copia,
+		// cuyos índices se construyen de una vez
+		if (i % 50 != 49 && i != nrutas - 1)
+			continue;
+
+		AlmacenRutas copia(almacen);
+		for (int q = 0; q < 20; q++) {
+			Punto punto = PuntoAleatorio();
+			vector<string> bruta = PorPuntoBruta(vivas, punto);
+			if (almacen.rutasPorPunto(punto) != bruta || copia.rutasPorPunto(punto) != bruta)
+				errores++;
+			Pais pais("P", "P.png", punto);
+			if (almacen.rutasPorPais(pais) != bruta)
+				errores++;
+
+			double lat = Aleatorio(40, 40.002), lon = Aleatorio(-3, -2.998);
+			Caja caja = {lat, lat + Aleatorio(0, 5e-4), lon, lon + Aleatorio(0, 5e-4)};
+			vector<string> en_caja = EnCajaBruta(vivas, caja);
+			if (almacen.rutasEnCaja(caja) != en_caja || copia.rutasEnCaja(caja) != en_caja)
+				errores++;
+			comprobaciones += 3;
+		}
+
+		if (almacen.getNumRutas() != (int) vivas.size() || !almacen.existeRuta(vivas.back().getCodigo()))
+			errores++;
+		comprobaciones++;
+	}
+
+	cout << "Comprobaciones: " << comprobaciones << ", errores: " << errores << endl;
+	return errores == 0 ? 0 : 1;
+}
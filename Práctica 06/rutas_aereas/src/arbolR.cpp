@@ -0,0 +1,139 @@
+/**
+ * @file arbolR.cpp
+ * @brief Fichero de implementación del TDA ArbolR
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "arbolR.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Caja que envuelve a otras dos
+ */
+static Caja Union(const Caja &a, const Caja &b) {
+	Caja c = {min(a.lat_min, b.lat_min), max(a.lat_max, b.lat_max),
+			  min(a.lon_min, b.lon_min), max(a.lon_max, b.lon_max)};
+	return c;
+}
+
+/**
+ * @brief Caja vacía, neutra para Union()
+ */
+static Caja CajaVacia() {
+	double inf = numeric_limits<double>::infinity();
+	Caja c = {inf, -inf, inf, -inf};
+	return c;
+}
+
+/**
+ * @brief Ordena unas posiciones según el centro de sus cajas, por longitud o por latitud
+ */
+class MenorCentro {
+private:
+	const vector<Caja> &cajas;
+	bool por_longitud;
+public:
+	MenorCentro(const vector<Caja> &c, bool lon): cajas(c), por_longitud(lon) {}
+	bool operator()(int a, int b) const {
+		if (por_longitud)
+			return cajas[a].lon_min + cajas[a].lon_max < cajas[b].lon_min + cajas[b].lon_max;
+		return cajas[a].lat_min + cajas[a].lat_max < cajas[b].lat_min + cajas[b].lat_max;
+	}
+};
+
+/**
+ * @brief Ordena unas posiciones con el método STR para agruparlas de @a capacidad en @a capacidad
+ * @param cajas Cajas de las posiciones
+ * @param orden Posiciones a ordenar
+ * @param capacidad Tamaño de cada grupo
+ */
+static void OrdenarSTR(const vector<Caja> &cajas, vector<int> &orden, int capacidad) {
+	size_t n = orden.size();
+	size_t grupos = (n + capacidad - 1) / capacidad;
+	size_t franjas = (size_t) ceil(sqrt((double) grupos));
+	size_t por_franja = franjas * capacidad;
+
+	sort(orden.begin(), orden.end(), MenorCentro(cajas, true));
+	for (size_t i = 0; i < n; i += por_franja)
+		sort(orden.begin() + i, orden.begin() + min(i + por_franja, n), MenorCentro(cajas, false));
+}
+
+void ArbolR::clear() {
+	niveles.clear();
+	ids.clear();
+	cajas.clear();
+}
+
+void ArbolR::Construir(const vector<Caja> &cajas) {
+	clear();
+	this->cajas = cajas;
+	for (size_t i = 0; i < cajas.size(); i++)
+		if (!cajas[i].vacia())
+			ids.push_back(i);
+	if (ids.empty())
+		return;
+
+	// Hojas
+	OrdenarSTR(cajas, ids, CAPACIDAD);
+	niveles.push_back(vector<Nodo>());
+	for (size_t i = 0; i < ids.size(); i += CAPACIDAD) {
+		Nodo nodo = {CajaVacia(), (int) i, (int) min((size_t) CAPACIDAD, ids.size() - i)};
+		for (int k = 0; k < nodo.num; k++)
+			nodo.caja = Union(nodo.caja, cajas[ids[i + k]]);
+		niveles.back().push_back(nodo);
+	}
+
+	// Niveles superiores, hasta que quede un único nodo
+	while (niveles.back().size() > 1) {
+		const vector<Nodo> &inferior = niveles.back();
+		vector<Caja> cajas_nivel(inferior.size());
+		vector<int> orden(inferior.size());
+		for (size_t i = 0; i < inferior.size(); i++) {
+			cajas_nivel[i] = inferior[i].caja;
+			orden[i] = i;
+		}
+		OrdenarSTR(cajas_nivel, orden, CAPACIDAD);
+
+		// Los hijos de cada nodo tienen que quedar contiguos: reordenamos el nivel inferior
+		vector<Nodo> reordenado(inferior.size());
+		for (size_t i = 0; i < orden.size(); i++)
+			reordenado[i] = inferior[orden[i]];
+		niveles.back().swap(reordenado);
+
+		vector<Nodo> superior;
+		const vector<Nodo> &hijos = niveles.back();
+		for (size_t i = 0; i < hijos.size(); i += CAPACIDAD) {
+			Nodo nodo = {CajaVacia(), (int) i, (int) min((size_t) CAPACIDAD, hijos.size() - i)};
+			for (int k = 0; k < nodo.num; k++)
+				nodo.caja = Union(nodo.caja, hijos[i + k].caja);
+			superior.push_back(nodo);
+		}
+		niveles.push_back(superior);
+	}
+}
+
+void ArbolR::Buscar(int nivel, int nodo, const Caja &c, vector<int> &resultado) const {
+	const Nodo &n = niveles[nivel][nodo];
+	if (!n.caja.solapa(c))
+		return;
+
+	if (nivel == 0) {
+		for (int k = n.primero; k < n.primero + n.num; k++)
+			if (cajas[ids[k]].solapa(c))
+				resultado.push_back(ids[k]);
+	}
+	else
+		for (int k = n.primero; k < n.primero + n.num; k++)
+			Buscar(nivel - 1, k, c, resultado);
+}
+
+vector<int> ArbolR::Buscar(const Caja &c) const {
+	vector<int> resultado;
+	if (!niveles.empty() && !c.vacia())
+		Buscar(niveles.size() - 1, 0, c, resultado);
+	return resultado;
+}
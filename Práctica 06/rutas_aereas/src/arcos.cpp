@@ -0,0 +1,155 @@
+/**
+ * @file arcos.cpp
+ * @brief Fichero de implementación del TDA LoteArcos
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "arcos.h"
+#include <cmath>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+void LoteArcos::clear() {
+	origenes.clear();
+	destinos.clear();
+}
+
+void LoteArcos::Anadir(const Punto &origen, const Punto &destino) {
+	origenes.push_back(origen);
+	destinos.push_back(destino);
+}
+
+void LoteArcos::Anadir(const Ruta &ruta) {
+	const vector<Punto> &puntos = ruta.getPuntos();
+	for (size_t i = 1; i < puntos.size(); i++)
+		Anadir(puntos[i - 1], puntos[i]);
+}
+
+void LoteArcos::Anadir(const AlmacenRutas &almacen) {
+	AlmacenRutas::const_iterator it;
+	for (it = almacen.begin(); it != almacen.end(); ++it)
+		Anadir(*it);
+}
+
+void LoteArcos::Segmentos(int filas, int columnas, int tramos, vector<Segmento> &segmentos) const {
+	segmentos.clear();
+	size_t n = size();
+	segmentos.reserve(n * tramos);
+
+	// Píxeles por radián en cada eje
+	double por_col = columnas / (2 * M_PI), por_fila = filas / M_PI;
+
+	// El punto k-ésimo de todos los arcos se calcula de una vez
+	LotePuntos anterior = origenes, actual;
+	for (int k = 1; k <= tramos; k++) {
+		origenes.puntosIntermedios(destinos, k / (double) tramos, actual);
+
+		const vector<double> &lat0 = anterior.getLatitudes(), &lon0 = anterior.getLongitudes();
+		const vector<double> &lat1 = actual.getLatitudes(), &lon1 = actual.getLongitudes();
+		for (size_t i = 0; i < n; i++) {
+			double dlon = lon1[i] - lon0[i];
+			if (fabs(dlon) <= M_PI) {
+				Segmento s = {(M_PI_2 - lat0[i]) * por_fila, (lon0[i] + M_PI) * por_col,
+							  (M_PI_2 - lat1[i]) * por_fila, (lon1[i] + M_PI) * por_col};
+				segmentos.push_back(s);
+			}
+			else {
+				// Cruza el antimeridiano: lo partimos donde corta el borde del mapa por el que sale
+				double borde = (lon0[i] > 0) ? M_PI : -M_PI;
+				double t = (borde - lon0[i]) / (lon1[i] + 2 * borde - lon0[i]);
+				double lat_corte = lat0[i] + t * (lat1[i] - lat0[i]);
+
+				Segmento s1 = {(M_PI_2 - lat0[i]) * por_fila, (lon0[i] + M_PI) * por_col,
+							   (M_PI_2 - lat_corte) * por_fila, (borde + M_PI) * por_col};
+				Segmento s2 = {(M_PI_2 - lat_corte) * por_fila, (M_PI - borde) * por_col,
+							   (M_PI_2 - lat1[i]) * por_fila, (lon1[i] + M_PI) * por_col};
+				segmentos.push_back(s1);
+				segmentos.push_back(s2);
+			}
+		}
+		swap(anterior, actual);
+	}
+}
+
+template <class Lienzo>
+void LoteArcos::Dibujar(Lienzo &mapa, const Pixel &color, int tramos, int num_hilos, vector<Region> *regiones) const {
+	int filas = mapa.getFilas(), columnas = mapa.getColumnas();
+	if (size() == 0 || filas == 0 || columnas == 0)
+		return;
+
+	vector<Segmento> segmentos;
+	Segmentos(filas, columnas, tramos, segmentos);
+
+	// Clasificamos los segmentos por teselas en formato CSR: los de la tesela t ocupan las
+	// posiciones [inicio[t], inicio[t+1]) de indices. Un segmento puede tocar varias teselas.
+	int tf = (filas + TAM_TESELA - 1) / TAM_TESELA, tc = (columnas + TAM_TESELA - 1) / TAM_TESELA;
+	vector<int> inicio(tf * tc + 1, 0), indices;
+	vector<int> caja(4 * segmentos.size());
+
+	for (size_t s = 0; s < segmentos.size(); s++) {
+		// Teselas que toca la caja del segmento, ampliada un píxel por el antialiasing
+		const Segmento &seg = segmentos[s];
+		int *c = &caja[4 * s];
+		c[0] = max(0, (int) floor(min(seg.f0, seg.f1) - 1) / TAM_TESELA);
+		c[1] = min(tf - 1, (int) floor(max(seg.f0, seg.f1) + 1) / TAM_TESELA);
+		c[2] = max(0, (int) floor(min(seg.c0, seg.c1) - 1) / TAM_TESELA);
+		c[3] = min(tc - 1, (int) floor(max(seg.c0, seg.c1) + 1) / TAM_TESELA);
+		for (int i = c[0]; i <= c[1]; i++)
+			for (int j = c[2]; j <= c[3]; j++)
+				inicio[i * tc + j + 1]++;
+	}
+	for (int t = 0; t < tf * tc; t++)
+		inicio[t + 1] += inicio[t];
+
+	indices.resize(inicio[tf * tc]);
+	vector<int> libre(inicio.begin(), inicio.end() - 1);
+	for (size_t s = 0; s < segmentos.size(); s++) {
+		const int *c = &caja[4 * s];
+		for (int i = c[0]; i <= c[1]; i++)
+			for (int j = c[2]; j <= c[3]; j++)
+				indices[libre[i * tc + j]++] = s;
+	}
+
+	// Cada tesela se dibuja entera de una vez. Las teselas no se solapan, así que varios hilos
+	// pueden dibujar teselas distintas a la vez sobre el mismo mapa
+	vector<int> ocupadas;
+	for (int t = 0; t < tf * tc; t++)
+		if (inicio[t] != inicio[t + 1])
+			ocupadas.push_back(t);
+
+	atomic<int> siguiente(0);
+	auto trabajador = [&]() {
+		for (int k = siguiente++; k < (int) ocupadas.size(); k = siguiente++) {
+			int t = ocupadas[k];
+			Region tesela = {(t / tc) * TAM_TESELA, (t % tc) * TAM_TESELA, TAM_TESELA, TAM_TESELA};
+			for (int p = inicio[t]; p < inicio[t + 1]; p++) {
+				const Segmento &seg = segmentos[indices[p]];
+				mapa.DibujarLinea(seg.f0, seg.c0, seg.f1, seg.c1, color, &tesela);
+			}
+		}
+	};
+
+	num_hilos = min(num_hilos, (int) ocupadas.size());
+	if (num_hilos <= 1)
+		trabajador();
+	else {
+		vector<thread> hilos;
+		for (int h = 0; h < num_hilos; h++)
+			hilos.push_back(thread(trabajador));
+		for (int h = 0; h < num_hilos; h++)
+			hilos[h].join();
+	}
+
+	if (regiones != 0)
+		for (size_t k = 0; k < ocupadas.size(); k++) {
+			Region tesela = {(ocupadas[k] / tc) * TAM_TESELA, (ocupadas[k] % tc) * TAM_TESELA, TAM_TESELA, TAM_TESELA};
+			regiones->push_back(tesela);
+		}
+}
+
+template void LoteArcos::Dibujar<Imagen>(Imagen &, const Pixel &, int, int, vector<Region> *) const;
+template void LoteArcos::Dibujar<MapaTeselado>(MapaTeselado &, const Pixel &, int, int, vector<Region> *) const;
@@ -0,0 +1,199 @@
+/**
+ * @file carga_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de la carga de paises y almacenes de rutas
+ *
+ * Genera un fichero de paises y un almacén de rutas sintéticos y compara el tiempo de leerlos
+ * como se hacía antes (extracciones con operator>> de un flujo, una por campo, y copias de cada
+ * ruta) con Paises::CargarFichero() y AlmacenRutas::CargarFichero(), con uno y con varios hilos.
+ * También mide la carga de los mismos datos guardados en formato binario.
+ *
+ * Los ficheros se crean en el directorio actual y se borran al terminar.
+ *
+ * @param NumeroDeRutas Número de rutas del almacén. Opcional, por defecto 1000000.
+ * @param PuntosPorRuta Número de puntos de cada ruta. Opcional, por defecto 8.
+ * @param NumeroDeHilos Número de hilos de la carga en paralelo. Opcional, por defecto los que tenga la máquina.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./carga_medida 1000000 8 4
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <list>
+#include <set>
+#include "paises.h"
+#include "almacenRutas.h"
+
+using namespace std;
+
+#define FICHERO_PAISES "carga_medida_paises.txt"
+#define FICHERO_RUTAS "carga_medida_rutas.txt"
+#define FICHERO_PAISES_BIN "carga_medida_paises.bin"
+#define FICHERO_RUTAS_BIN "carga_medida_rutas.bin"
+
+/**
+ * @brief Lee un almacén de rutas como lo hacía antes operator>>
+ *
+ * Cada punto se extrae con operator>>, se acumula en una lista nueva que se copia en la ruta,
+ * y la ruta se vuelve a copiar al insertarla en el mapa.
+ *
+ * @param is Flujo de entrada
+ * @param rutas Mapa donde se añaden las rutas
+ */
+void LeerRutasFlujo(istream &is, map<string, Ruta> &rutas) {
+	string cadena, codigo;
+	is >> cadena;
+
+	int num_puntos;
+	while (is >> codigo >> num_puntos) {
+		list<Punto> puntos;
+		Punto p;
+		for (int i = 0; i < num_puntos; ++i) {
+			is >> p;
+			puntos.push_back(p);
+		}
+		Ruta ruta;
+		ruta.setCodigo(codigo);
+		ruta.setPuntos(puntos);
+		rutas.insert(pair<string, Ruta>(ruta.getCodigo(), ruta));
+	}
+}
+
+/**
+ * @brief Lee unos paises como lo hacía antes operator>>, con un istringstream por línea
+ * @param is Flujo de entrada
+ * @param paises Conjunto donde se añaden los paises
+ */
+void LeerPaisesFlujo(istream &is, set<Pais> &paises) {
+	double latitud, longitud;
+	string nombre, bandera, line;
+	while (getline(is, line)) {
+		if (line.empty() || line[0] == '#')
+			continue;
+		istringstream iss(line);
+		iss >> latitud >> longitud >> nombre >> bandera;
+		paises.insert(Pais(nombre, bandera, Punto(latitud, longitud)));
+	}
+}
+
+/**
+ * @brief Devuelve los segundos transcurridos desde un instante
+ * @param tini Instante inicial
+ * @return Segundos transcurridos
+ */
+double Segundos(chrono::steady_clock::time_point tini) {
+	return chrono::duration<double>(chrono::steady_clock::now() - tini).count();
+}
+
+int main (int argc, char* argv[]) {
+	int nrutas = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int npuntos = (argc > 2) ? atoi(argv[2]) : 8;
+	int nhilos = (argc > 3) ? atoi(argv[3]) : (int) thread::hardware_concurrency();
+	if (nhilos <= 0)
+		nhilos = 1;
+
+	if (argc > 4 || nrutas <= 0 || npuntos <= 0) {
+		cerr << "Uso: carga_medida [NumeroDeRutas] [PuntosPorRuta] [NumeroDeHilos]" << endl;
+		return 1;
+	}
+
+	// Generamos los ficheros, con tantos paises como rutas y los puntos de las rutas tomados de ellos
+	srand(1);
+	vector<Punto> puntos;
+	ofstream fpaises(FICHERO_PAISES);
+	fpaises.precision(17);
+	fpaises << "# Latitud\tLongitud\tPais\tBandera" << endl;
+	for (int i = 0; i < nrutas; i++) {
+		Punto p(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180);
+		fpaises << p.getLatitud() << "\t" << p.getLongitud() << "\tPais" << i << "\tpais" << i << ".ppm" << endl;
+		puntos.push_back(p);
+	}
+	fpaises.close();
+
+	ofstream frutas(FICHERO_RUTAS);
+	frutas.precision(17);
+	frutas << "#Rutas" << endl;
+	for (int i = 0; i < nrutas; i++) {
+		frutas << "R" << i << " " << npuntos;
+		for (int j = 0; j < npuntos; j++) {
+			const Punto &p = puntos[rand() % nrutas];
+			frutas << " (" << p.getLatitud() << "," << p.getLongitud() << ")";
+		}
+		frutas << endl;
+	}
+	frutas.close();
+
+	// Paises
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	ifstream file(FICHERO_PAISES);
+	set<Pais> conjunto;
+	LeerPaisesFlujo(file, conjunto);
+	file.close();
+	double t_paises_flujo = Segundos(tini);
+
+	tini = chrono::steady_clock::now();
+	Paises paises;
+	paises.CargarFichero(FICHERO_PAISES);
+	double t_paises = Segundos(tini);
+
+	// Almacén de rutas
+	tini = chrono::steady_clock::now();
+	file.open(FICHERO_RUTAS);
+	map<string, Ruta> mapa;
+	LeerRutasFlujo(file, mapa);
+	file.close();
+	double t_rutas_flujo = Segundos(tini);
+
+	tini = chrono::steady_clock::now();
+	AlmacenRutas secuencial;
+	secuencial.CargarFichero(FICHERO_RUTAS);
+	double t_rutas = Segundos(tini);
+
+	tini = chrono::steady_clock::now();
+	AlmacenRutas paralelo;
+	paralelo.CargarFichero(FICHERO_RUTAS, nhilos);
+	double t_rutas_hilos = Segundos(tini);
+
+	// Formato binario
+	paises.GuardarBinario(FICHERO_PAISES_BIN);
+	secuencial.GuardarBinario(FICHERO_RUTAS_BIN);
+
+	tini = chrono::steady_clock::now();
+	Paises paises_bin;
+	paises_bin.CargarFichero(FICHERO_PAISES_BIN);
+	double t_paises_bin = Segundos(tini);
+
+	tini = chrono::steady_clock::now();
+	AlmacenRutas rutas_bin;
+	rutas_bin.CargarFichero(FICHERO_RUTAS_BIN);
+	double t_rutas_bin = Segundos(tini);
+
+	remove(FICHERO_PAISES);
+	remove(FICHERO_RUTAS);
+	remove(FICHERO_PAISES_BIN);
+	remove(FICHERO_RUTAS_BIN);
+
+	// Mostramos resultados (segundos)
+	cout << "Paises: " << conjunto.size() << " / " << paises.size() << endl;
+	cout << "flujo:\t\t" << t_paises_flujo << endl;
+	cout << "CargarFichero:\t" << t_paises << endl;
+	cout << "binario:\t" << t_paises_bin << " (" << paises_bin.size() << ")" << endl;
+	cout << "Rutas: " << mapa.size() << " / " << secuencial.getNumRutas() << " / " << paralelo.getNumRutas()
+		 << " (" << npuntos << " puntos por ruta)" << endl;
+	cout << "flujo:\t\t" << t_rutas_flujo << endl;
+	cout << "CargarFichero:\t" << t_rutas << endl;
+	cout << "CargarFichero(" << nhilos << "):\t" << t_rutas_hilos << endl;
+	cout << "binario:\t" << t_rutas_bin << " (" << rutas_bin.getNumRutas() << ")" << endl;
+
+	return 0;
+}
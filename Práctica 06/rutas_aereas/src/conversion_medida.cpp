@@ -0,0 +1,129 @@
+/**
+ * @file conversion_medida.cpp
+ * @brief Fichero usado para medir la conversión de imágenes entre formatos de píxel
+ *
+ * Genera una imagen RGBA aleatoria, la pasa a cada uno de los formatos de BasicImage
+ * (grises de 8 y 16 bits, RGB y RGBA, que es el Pixel de Imagen) y mide cuánto cuesta
+ * convertirla de cada formato a cada uno de los demás con BasicImage::Convertir().
+ *
+ * Para comparar, mide también la conversión de RGBA a RGB recorriendo la Imagen píxel a píxel
+ * con su operador (), como hacía antes Imagen::EscribirImagen().
+ *
+ * Los resultados se muestran en millones de píxeles por segundo.
+ *
+ * @param Filas Número de filas de la imagen. Opcional, por defecto 2048.
+ * @param Columnas Número de columnas de la imagen. Opcional, por defecto 2048.
+ * @param Repeticiones Número de conversiones que se miden de cada tipo. Opcional, por defecto 10.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./conversion_medida 2048 2048 10
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include "imagen.h"
+#include "basicImage.h"
+
+using namespace std;
+
+/**
+ * @brief Mide la conversión de una imagen a otro formato de píxel
+ * @tparam Origen Tipo de píxel de la imagen
+ * @tparam Destino Tipo de píxel al que se convierte
+ * @param img Imagen a convertir
+ * @param reps Número de conversiones
+ * @param control Acumula un byte de cada resultado, para que no se eliminen las conversiones
+ * @return Millones de píxeles convertidos por segundo
+ */
+template <class Origen, class Destino>
+double MedirConversion(const BasicImage<Origen> &img, int reps, unsigned &control) {
+	clock_t tini = clock();
+	for (int r = 0; r < reps; r++) {
+		BasicImage<Destino> resultado = img.template Convertir<Destino>();
+		control += *reinterpret_cast<const unsigned char *>(resultado[r % resultado.getFilas()]);
+	}
+	clock_t tfin = clock();
+
+	double segundos = (tfin - tini) / (double) CLOCKS_PER_SEC;
+	return img.size() * (double) reps / segundos / 1e6;
+}
+
+/**
+ * @brief Muestra la fila de la tabla de un formato de origen
+ * @tparam Origen Tipo de píxel de origen
+ * @param nombre Nombre del formato de origen
+ * @param base Imagen RGBA de la que se parte
+ * @param reps Número de conversiones de cada tipo
+ * @param control Acumulador de control
+ */
+template <class Origen>
+void MedirFormato(const char nombre[], const BasicImage<Pixel> &base, int reps, unsigned &control) {
+	BasicImage<Origen> img = base.Convertir<Origen>();
+
+	cout << nombre << "\t"
+		 << MedirConversion<Origen, Gris8>(img, reps, control) << "\t"
+		 << MedirConversion<Origen, Gris16>(img, reps, control) << "\t"
+		 << MedirConversion<Origen, Rgb8>(img, reps, control) << "\t"
+		 << MedirConversion<Origen, Pixel>(img, reps, control) << endl;
+}
+
+int main (int argc, char* argv[]) {
+	int filas = (argc > 1) ? atoi(argv[1]) : 2048;
+	int columnas = (argc > 2) ? atoi(argv[2]) : 2048;
+	int reps = (argc > 3) ? atoi(argv[3]) : 10;
+
+	if (argc > 4 || filas <= 0 || columnas <= 0 || reps <= 0) {
+		cerr << "Uso: conversion_medida [Filas] [Columnas] [Repeticiones]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	BasicImage<Pixel> base(filas, columnas);
+	for (int i = 0; i < filas; i++)
+		for (int j = 0; j < columnas; j++) {
+			Pixel p = {(unsigned char) rand(), (unsigned char) rand(), (unsigned char) rand(), (unsigned char) rand()};
+			base(i, j) = p;
+		}
+
+	unsigned control = 0;
+
+	// Tabla de conversiones: una fila por formato de origen, una columna por formato de destino
+	cout << "Imagen de " << filas << "x" << columnas << ", " << reps << " repeticiones (Mpx/s)" << endl;
+	cout << "origen\\destino\tgris8\tgris16\trgb\trgba" << endl;
+	MedirFormato<Gris8>("gris8", base, reps, control);
+	MedirFormato<Gris16>("gris16", base, reps, control);
+	MedirFormato<Rgb8>("rgb", base, reps, control);
+	MedirFormato<Pixel>("rgba", base, reps, control);
+
+	// RGBA a RGB píxel a píxel sobre una Imagen, como antes de BasicImage
+	Imagen imagen(filas, columnas);
+	for (int i = 0; i < filas; i++)
+		for (int j = 0; j < columnas; j++)
+			imagen(i, j) = base(i, j);
+
+	clock_t tini = clock();
+	for (int r = 0; r < reps; r++) {
+		unsigned char *aux = new unsigned char[filas * columnas * 3];
+		for (int k = 0; k < filas * columnas; k++) {
+			const Pixel &p = imagen(k / columnas, k % columnas);
+			aux[3 * k] = p.r;
+			aux[3 * k + 1] = p.g;
+			aux[3 * k + 2] = p.b;
+		}
+		control += aux[r];
+		delete[] aux;
+	}
+	clock_t tfin = clock();
+	double segundos = (tfin - tini) / (double) CLOCKS_PER_SEC;
+
+	cout << "rgba->rgb pixel a pixel:\t" << filas * (double) columnas * reps / segundos / 1e6 << endl;
+	cout << "(control: " << control << ")" << endl;
+
+	return 0;
+}
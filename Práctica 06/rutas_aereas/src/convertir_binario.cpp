@@ -0,0 +1,55 @@
+/**
+ * @file convertir_binario.cpp
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ *
+ * @brief Programa que convierte un fichero de paises y un almacén de rutas al formato binario.
+ *
+ * Los ficheros generados se pueden usar en lugar de los de texto en rutaaerea y rutaaerea_lote,
+ * que los reconocen por su cabecera y los cargan sin analizar ningún texto.
+ *
+ * @param fichero_paises Fichero con la informacion de los paises
+ * @param almacen_rutas Fichero con el almacen de rutas
+ * @param paises_bin Fichero binario de paises a generar
+ * @param rutas_bin Fichero binario de rutas a generar
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./convertir_binario ./datos/paises.txt ./datos/almacen_rutas.txt ./datos/paises.bin ./datos/almacen_rutas.bin
+ * Paises: 52
+ * Rutas: 5
+ * @endcode
+ */
+
+#include "paises.h"
+#include "almacenRutas.h"
+#include <iostream>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	if (argc != 5) {
+		cout << "Los parametros son:" << endl;
+		cout << "1 - Fichero con la informacion de los paises" << endl;
+		cout << "2 - Fichero con el almacen de rutas" << endl;
+		cout << "3 - Fichero binario de paises a generar" << endl;
+		cout << "4 - Fichero binario de rutas a generar" << endl;
+
+		cout << "Uso: " << argv[0] << " <fichero_paises> <almacen_rutas> <paises_bin> <rutas_bin>" << endl;
+
+		return -1;
+	}
+
+	Paises paises;
+	if (!paises.CargarFichero(argv[1]) || !paises.GuardarBinario(argv[3]))
+		return -1;
+	cout << "Paises: " << paises.size() << endl;
+
+	AlmacenRutas Ar;
+	if (!Ar.CargarFichero(argv[2]) || !Ar.GuardarBinario(argv[4]))
+		return -1;
+	cout << "Rutas: " << Ar.getNumRutas() << endl;
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file formatoBinario.cpp
+ * @brief Fichero de implementación de las utilidades comunes de los formatos binarios
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "formatoBinario.h"
+#include <cstring>
+#include <fstream>
+
+#define ORDEN_BYTES 0x01020304
+
+uint64_t SumaComprobacion(const char *datos, size_t tam) {
+	uint64_t h = 14695981039346656037ULL;
+
+	size_t palabras = tam / 8;
+	for (size_t i = 0; i < palabras; i++) {
+		uint64_t w;
+		memcpy(&w, datos + 8 * i, 8);
+		h ^= w;
+		h *= 1099511628211ULL;
+	}
+	for (size_t i = 8 * palabras; i < tam; i++) {
+		h ^= (unsigned char) datos[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+bool EsBinario(const FicheroMapeado &fichero, const char *magia) {
+	return fichero.size() >= sizeof(CabeceraBinaria) && memcmp(fichero.begin(), magia, 8) == 0;
+}
+
+bool AbrirBinario(const FicheroMapeado &fichero, const char *magia, const char *&cuerpo, size_t &tam) {
+	if (!EsBinario(fichero, magia))
+		return false;
+
+	CabeceraBinaria cab;
+	memcpy(&cab, fichero.begin(), sizeof(cab));
+	if (cab.version != VERSION_BINARIA || cab.orden_bytes != ORDEN_BYTES)
+		return false;
+	if (cab.tam_cuerpo != fichero.size() - sizeof(cab))
+		return false;
+
+	cuerpo = fichero.begin() + sizeof(cab);
+	tam = cab.tam_cuerpo;
+	return SumaComprobacion(cuerpo, tam) == cab.suma;
+}
+
+bool GuardarFicheroBinario(const string &nombre, const char *magia, const vector<char> &cuerpo) {
+	CabeceraBinaria cab;
+	memcpy(cab.magia, magia, 8);
+	cab.version = VERSION_BINARIA;
+	cab.orden_bytes = ORDEN_BYTES;
+	cab.tam_cuerpo = cuerpo.size();
+	cab.suma = SumaComprobacion(cuerpo.data(), cuerpo.size());
+
+	ofstream f(nombre.c_str(), ios::out | ios::binary);
+	if (!f)
+		return false;
+	f.write((const char *) &cab, sizeof(cab));
+	f.write(cuerpo.data(), cuerpo.size());
+	return (bool) f;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file geodesia.cpp
+ * @brief Fichero de implementación del TDA LotePuntos
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "geodesia.h"
+
+#define GRADOS_A_RAD (M_PI / 180)
+#define RAD_A_GRADOS (180 / M_PI)
+
+LotePuntos::LotePuntos(const vector<Punto> &puntos) {
+	reserve(puntos.size());
+	for (size_t i = 0; i < puntos.size(); i++)
+		push_back(puntos[i]);
+}
+
+void LotePuntos::reserve(size_t n) {
+	lat.reserve(n);
+	lon.reserve(n);
+	sin_lat.reserve(n);
+	cos_lat.reserve(n);
+	sin_lon.reserve(n);
+	cos_lon.reserve(n);
+}
+
+void LotePuntos::push_back(const Punto &p) {
+	double phi = p.getLatitud() * GRADOS_A_RAD, lambda = p.getLongitud() * GRADOS_A_RAD;
+	lat.push_back(phi);
+	lon.push_back(lambda);
+	sin_lat.push_back(sin(phi));
+	cos_lat.push_back(cos(phi));
+	sin_lon.push_back(sin(lambda));
+	cos_lon.push_back(cos(lambda));
+}
+
+void LotePuntos::clear() {
+	lat.clear();
+	lon.clear();
+	sin_lat.clear();
+	cos_lat.clear();
+	sin_lon.clear();
+	cos_lon.clear();
+}
+
+Punto LotePuntos::operator[](size_t i) const {
+	return Punto(lat[i] * RAD_A_GRADOS, lon[i] * RAD_A_GRADOS);
+}
+
+void LotePuntos::distancias(const LotePuntos &otro, double *resultado) const {
+	const double * __restrict lat1 = lat.data(), * __restrict lat2 = otro.lat.data();
+	const double * __restrict lon1 = lon.data(), * __restrict lon2 = otro.lon.data();
+	const double * __restrict c1 = cos_lat.data(), * __restrict c2 = otro.cos_lat.data();
+	double * __restrict r = resultado;
+	size_t n = size();
+
+	#pragma omp simd
+	for (size_t i = 0; i < n; i++) {
+		double s_lat = sin((lat2[i] - lat1[i]) * 0.5);
+		double s_lon = sin((lon2[i] - lon1[i]) * 0.5);
+		double h = s_lat * s_lat + c1[i] * c2[i] * s_lon * s_lon;
+		h = h < 1.0 ? h : 1.0;
+		r[i] = 2 * RADIO_TIERRA * asin(sqrt(h));
+	}
+}
+
+void LotePuntos::rumbos(const LotePuntos &otro, double *resultado) const {
+	const double * __restrict s1 = sin_lat.data(), * __restrict s2 = otro.sin_lat.data();
+	const double * __restrict c1 = cos_lat.data(), * __restrict c2 = otro.cos_lat.data();
+	const double * __restrict sl1 = sin_lon.data(), * __restrict sl2 = otro.sin_lon.data();
+	const double * __restrict cl1 = cos_lon.data(), * __restrict cl2 = otro.cos_lon.data();
+	double * __restrict r = resultado;
+	size_t n = size();
+
+	#pragma omp simd
+	for (size_t i = 0; i < n; i++) {
+		// Seno y coseno de la diferencia de longitudes, sin llamar a funciones trigonométricas
+		double sin_dlon = sl2[i] * cl1[i] - cl2[i] * sl1[i];
+		double cos_dlon = cl2[i] * cl1[i] + sl2[i] * sl1[i];
+
+		double y = sin_dlon * c2[i];
+		double x = c1[i] * s2[i] - s1[i] * c2[i] * cos_dlon;
+		double grados = atan2(y, x) * RAD_A_GRADOS;
+		r[i] = grados < 0 ? grados + 360 : grados;
+	}
+}
+
+void LotePuntos::puntosIntermedios(const LotePuntos &otro, double fraccion, LotePuntos &resultado) const {
+	size_t n = size();
+	resultado.lat.resize(n);
+	resultado.lon.resize(n);
+	resultado.sin_lat.resize(n);
+	resultado.cos_lat.resize(n);
+	resultado.sin_lon.resize(n);
+	resultado.cos_lon.resize(n);
+
+	const double * __restrict lat1 = lat.data(), * __restrict lat2 = otro.lat.data();
+	const double * __restrict lon1 = lon.data(), * __restrict lon2 = otro.lon.data();
+	const double * __restrict s1 = sin_lat.data(), * __restrict s2 = otro.sin_lat.data();
+	const double * __restrict c1 = cos_lat.data(), * __restrict c2 = otro.cos_lat.data();
+	const double * __restrict sl1 = sin_lon.data(), * __restrict sl2 = otro.sin_lon.data();
+	const double * __restrict cl1 = cos_lon.data(), * __restrict cl2 = otro.cos_lon.data();
+	double * __restrict r_lat = resultado.lat.data(), * __restrict r_lon = resultado.lon.data();
+	double * __restrict r_sin = resultado.sin_lat.data(), * __restrict r_cos = resultado.cos_lat.data();
+	double * __restrict r_sinl = resultado.sin_lon.data(), * __restrict r_cosl = resultado.cos_lon.data();
+
+	#pragma omp simd
+	for (size_t i = 0; i < n; i++) {
+		// Ángulo entre los dos puntos (haversine); sin(d) = 2 sqrt(h (1 - h))
+		double s_lat = sin((lat2[i] - lat1[i]) * 0.5);
+		double s_lon = sin((lon2[i] - lon1[i]) * 0.5);
+		double h = s_lat * s_lat + c1[i] * c2[i] * s_lon * s_lon;
+		h = h < 1.0 ? h : 1.0;
+		double d = 2 * asin(sqrt(h));
+		double sin_d = 2 * sqrt(h * (1 - h));
+
+		// Interpolación esférica (slerp) entre los vectores unitarios; si los puntos casi coinciden, lineal
+		bool casi_iguales = sin_d < 1e-12;
+		double divisor = casi_iguales ? 1 : sin_d;
+		double a = casi_iguales ? 1 - fraccion : sin((1 - fraccion) * d) / divisor;
+		double b = casi_iguales ? fraccion : sin(fraccion * d) / divisor;
+
+		double x = a * c1[i] * cl1[i] + b * c2[i] * cl2[i];
+		double y = a * c1[i] * sl1[i] + b * c2[i] * sl2[i];
+		double z = a * s1[i] + b * s2[i];
+
+		double rxy = sqrt(x * x + y * y);
+		double norma = sqrt(rxy * rxy + z * z);
+		r_lat[i] = atan2(z, rxy);
+		r_lon[i] = atan2(y, x);
+		r_sin[i] = z / norma;
+		r_cos[i] = rxy / norma;
+		r_sinl[i] = rxy > 0 ? y / rxy : 0;
+		r_cosl[i] = rxy > 0 ? x / rxy : 1;
+	}
+}
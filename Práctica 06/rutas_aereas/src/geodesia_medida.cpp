@@ -0,0 +1,113 @@
+/**
+ * @file geodesia_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de los cálculos geodésicos por lotes
+ *
+ * Genera pares de puntos aleatorios y compara el tiempo de calcular distancias, rumbos y puntos medios
+ * con los métodos de Punto, par a par, con el de las operaciones por lotes de LotePuntos.
+ * Muestra también la mayor diferencia entre ambos resultados.
+ *
+ * @param NumeroDePares Número de pares de puntos. Opcional, por defecto 1000000.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./geodesia_medida 1000000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "geodesia.h"
+
+using namespace std;
+
+/**
+ * @brief Devuelve los segundos transcurridos desde un instante
+ * @param tini Instante inicial
+ * @return Segundos transcurridos
+ */
+double Segundos(clock_t tini) {
+	return (clock() - tini) / (double) CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Diferencia entre dos rumbos, teniendo en cuenta que 0 y 360 son el mismo
+ */
+double DiferenciaAngulos(double a, double b) {
+	double d = fabs(a - b);
+	return d > 180 ? 360 - d : d;
+}
+
+int main (int argc, char* argv[]) {
+	int npares = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+	if (argc > 2 || npares <= 0) {
+		cerr << "Uso: geodesia_medida [NumeroDePares]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	vector<Punto> origen, destino;
+	for (int i = 0; i < npares; i++) {
+		origen.push_back(Punto(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180));
+		destino.push_back(Punto(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180));
+	}
+
+	clock_t tini = clock();
+	LotePuntos lote_origen(origen), lote_destino(destino);
+	double t_preparar = Segundos(tini);
+
+	// Distancias
+	vector<double> d_punto(npares), d_lote(npares);
+	tini = clock();
+	for (int i = 0; i < npares; i++)
+		d_punto[i] = origen[i].distancia(destino[i]);
+	double t_dist_punto = Segundos(tini);
+
+	tini = clock();
+	lote_origen.distancias(lote_destino, d_lote.data());
+	double t_dist_lote = Segundos(tini);
+
+	// Rumbos
+	vector<double> r_punto(npares), r_lote(npares);
+	tini = clock();
+	for (int i = 0; i < npares; i++)
+		r_punto[i] = origen[i].rumbo(destino[i]);
+	double t_rumbo_punto = Segundos(tini);
+
+	tini = clock();
+	lote_origen.rumbos(lote_destino, r_lote.data());
+	double t_rumbo_lote = Segundos(tini);
+
+	// Puntos medios
+	vector<Punto> m_punto(npares);
+	LotePuntos m_lote;
+	tini = clock();
+	for (int i = 0; i < npares; i++)
+		m_punto[i] = origen[i].puntoIntermedio(destino[i], 0.5);
+	double t_medio_punto = Segundos(tini);
+
+	tini = clock();
+	lote_origen.puntosIntermedios(lote_destino, 0.5, m_lote);
+	double t_medio_lote = Segundos(tini);
+
+	double err_dist = 0, err_rumbo = 0, err_medio = 0;
+	for (int i = 0; i < npares; i++) {
+		err_dist = max(err_dist, fabs(d_punto[i] - d_lote[i]));
+		err_rumbo = max(err_rumbo, DiferenciaAngulos(r_punto[i], r_lote[i]));
+		err_medio = max(err_medio, m_punto[i].distancia(m_lote[i]));
+	}
+
+	// Mostramos resultados (millones de pares por segundo)
+	cout << "Pares: " << npares << ", preparar los lotes: " << t_preparar << " s" << endl;
+	cout << "\t\tPunto\tLotePuntos\tdiferencia maxima" << endl;
+	cout << "distancia\t" << npares / t_dist_punto / 1e6 << "\t" << npares / t_dist_lote / 1e6 << "\t\t" << err_dist << " km" << endl;
+	cout << "rumbo\t\t" << npares / t_rumbo_punto / 1e6 << "\t" << npares / t_rumbo_lote / 1e6 << "\t\t" << err_rumbo << " grados" << endl;
+	cout << "punto medio\t" << npares / t_medio_punto / 1e6 << "\t" << npares / t_medio_lote / 1e6 << "\t\t" << err_medio << " km" << endl;
+
+	return 0;
+}
@@ -10,200 +10,375 @@
 #include "imagen.h"
 #include "imagenES.h"
 #include "string.h"
+#include <algorithm>
 #include <cmath>
-#include <cassert>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 
 using namespace std;
 
 Imagen::Imagen()
 {
-    data = 0;
-    nf = nc = 0;
 }
 
 Imagen::Imagen(int f, int c)
 {
-    nf = f;
-    nc = c;
-    data = new Pixel *[nf];
-    for (int i = 0; i < nf; i++)
+    Pixel blanco = {255, 255, 255, 255};
+    pixeles = BasicImage<Pixel>(f, c, blanco);
+}
+
+Pixel Imagen::media_pixeles(const Pixel& p1, const Pixel& p2) const{
+    Pixel ret_p;
+    ret_p.r = (p1.r + p2.r) / 2;
+    ret_p.g = (p1.g + p2.g) / 2;
+    ret_p.b = (p1.b + p2.b) / 2;
+    ret_p.transp = 255;
+    return ret_p;
+}
+
+void Imagen::LeerImagen(const char *img_path, const string &mascara_path)
+{
+    // Las imágenes PAM RGBA ya traen la transparencia en el cuarto canal; las PPM y las PAM RGB
+    // (DEPTH 3) se leen como opacas
+    int f, c, canales;
+    bool leida;
+    if (LeerTipoImagen(img_path, f, c, canales) == IMG_PAM && canales == 4)
+        leida = pixeles.LeerPNM(img_path);
+    else
+        leida = pixeles.LeerPNMComo<Rgb8>(img_path);
+
+    if (!leida)
     {
-        data[i] = new Pixel[nc];
-        for (int j = 0; j < nc; j++)
+        cerr << "Ha habido un problema en la lectura de " << img_path << endl;
+        return;
+    }
+
+    if (mascara_path != "")
+    {
+        BasicImage<Gris8> mascara;
+        if (!mascara.LeerPNM(mascara_path.c_str()) ||
+            mascara.getFilas() != getFilas() || mascara.getColumnas() != getColumnas())
+        {
+            cerr << "Ha habido un problema en la lectura de " << mascara_path << endl;
+            return;
+        }
+
+        for (int i = 0; i < getFilas(); i++)
         {
-            data[i][j].r = 255;
-            data[i][j].g = 255;
-            data[i][j].b = 255;
-            data[i][j].transp = 255;
+            Pixel *fila = pixeles[i];
+            const Gris8 *m = mascara[i];
+            for (int j = 0; j < getColumnas(); j++)
+                fila[j].transp = m[j];
         }
     }
 }
 
-void Imagen::borrar()
+string Imagen::NombreMascara(const char img_path[])
 {
-    for (int i = 0; i < nf; i++)
-        delete[] data[i];
-    delete[] data;
+    // El prefijo va delante del nombre del fichero, no del directorio
+    string n_aux = img_path;
+    size_t barra = n_aux.rfind('/');
+    size_t inicio = (barra == string::npos) ? 0 : barra + 1;
+    n_aux.insert(inicio, "mascara_");
+
+    size_t found = n_aux.find(".ppm", inicio);
+    if (found != string::npos)
+    {
+        n_aux = n_aux.substr(0, found);
+    }
+
+    return n_aux + ".pgm";
 }
 
-void Imagen::copiar(const Imagen &img)
+bool Imagen::EsOpaca() const
 {
-
-    nf = img.nf;
-    nc = img.nc;
-    data = new Pixel *[nf];
+    // Un píxel ocupa 4 bytes (r, g, b, transp): comparamos sus transparencias con 255 haciendo el AND
+    // de los píxeles de cada fila como enteros de 32 bits, en un bucle que el compilador vectoriza
+    static_assert(sizeof(Pixel) == sizeof(uint32_t), "Pixel debe ocupar 4 bytes");
+    Pixel opaco = {0, 0, 0, 255};
+    uint32_t mascara;
+    memcpy(&mascara, &opaco, sizeof(Pixel));
+
+    const int nf = getFilas(), nc = getColumnas();
     for (int i = 0; i < nf; i++)
     {
-        data[i] = new Pixel[nc];
+        const Pixel *fila = pixeles[i];
+        uint32_t acumulado = 0xFFFFFFFFu;
+        #pragma omp simd reduction(&:acumulado)
         for (int j = 0; j < nc; j++)
         {
-            data[i][j] = img.data[i][j];
+            uint32_t pixel;
+            memcpy(&pixel, fila + j, sizeof(Pixel));
+            acumulado &= pixel;
         }
+        if ((acumulado & mascara) != mascara)
+            return false;
     }
+    return true;
 }
 
-Imagen& Imagen::operator=(const Imagen &img)
+void Imagen::EscribirImagen(const char img_path[], Tipo_Salida ts) const
 {
-    if (this != &img)
-    {
-        borrar();
-        copiar(img);
-    }
-    return *this;
-}
-
-Pixel Imagen::media_pixeles(const Pixel& p1, const Pixel& p2) const{
-    Pixel ret_p;
-    ret_p.r = (p1.r + p2.r) / 2;
-    ret_p.g = (p1.g + p2.g) / 2;
-    ret_p.b = (p1.b + p2.b) / 2;
-    ret_p.transp = 255;
-    return ret_p;
+    if (ts == AUTOMATICO)
+        ts = EsOpaca() ? SOLO_PPM : PPM_MASCARA;
+
+    // Los píxeles se dan fila a fila, o de una vez si las filas están seguidas. En PAM se escriben
+    // sin copiarlos; en PPM se convierten por lotes en un búfer de tamaño fijo
+    EscritorImagen escritor;
+    if (!escritor.Abrir(img_path, getFilas(), getColumnas(), ts))
+        return;
+    if (pixeles.Contigua())
+        escritor.Anadir(pixeles.Datos(), getFilas() * getColumnas());
+    else
+        for (int i = 0; i < getFilas(); i++)
+            escritor.Anadir(pixeles[i], getColumnas());
+    escritor.Cerrar();
 }
 
-void Imagen::LeerImagen(const char *img_path, const string &mascara_path)
+bool EscritorImagen::Abrir(const char img_path[], int filas, int columnas, Tipo_Salida ts)
 {
-    int f, c;
-    unsigned char *aux, *aux_mask;
-
-    LeerTipoImagen(img_path, f, c);
-    aux = new unsigned char[f * c * 3];
-    LeerImagenPPM(img_path, f, c, aux);
-    if (mascara_path != "")
+    this->ts = ts;
+    nombre = img_path;
+    usados = 0;
+    if (!imagen.Abrir(img_path))
     {
-        int fm, cm;
-        LeerTipoImagen(mascara_path.c_str(), fm, cm);
-        aux_mask = new unsigned char[fm * cm];
-        LeerImagenPGM(mascara_path.c_str(), fm, cm, aux_mask);
+        cerr << "Ha habido un problema en la escritura de " << img_path << endl;
+        return false;
     }
-    else
+    cabecera = CabeceraImagen(ts == PAM_RGBA ? IMG_PAM : IMG_PPM, filas, columnas);
+    imagen.Anadir(cabecera.data(), cabecera.size());
+
+    if (ts == PPM_MASCARA)
     {
-        aux_mask = 0;
+        nombre_mascara = Imagen::NombreMascara(img_path);
+        if (!mascara.Abrir(nombre_mascara.c_str()))
+        {
+            cerr << "Ha habido un problema en la escritura de " << nombre_mascara << endl;
+            imagen.Descartar();
+            return false;
+        }
+        cabecera_mascara = CabeceraImagen(IMG_PGM, filas, columnas);
+        mascara.Anadir(cabecera_mascara.data(), cabecera_mascara.size());
     }
 
-    Imagen img(f, c);
-    int total = f * c * 3;
-    for (int i = 0; i < total; i += 3)
+    // En PAM los píxeles ya están en el formato del fichero y no hace falta búfer
+    if (ts != PAM_RGBA)
     {
-        int posi = i / (c * 3);
-        int posj = (i % (c * 3)) / 3;
-
-        img.data[posi][posj].r = aux[i];
-        img.data[posi][posj].g = aux[i + 1];
-        img.data[posi][posj].b = aux[i + 2];
-        if (aux_mask != 0)
-            img.data[posi][posj].transp = aux_mask[i / 3];
-        else
-            img.data[posi][posj].transp = 255;
+        long long total = (long long) filas * columnas;
+        color.resize(min<long long>(TAM_LOTE, total));
+        if (ts == PPM_MASCARA)
+            gris.resize(color.size());
     }
-
-    *this = img;
-    if (aux_mask != 0)
-        delete[] aux_mask;
-    delete[] aux;
+    return true;
 }
 
-void Imagen::EscribirImagen(const char img_path[]) const
+void EscritorImagen::Anadir(const Pixel *p, int n)
 {
-    unsigned char *aux = new unsigned char[nf * nc * 3];
-    unsigned char *m = new unsigned char[nf * nc];
-
-    int total = nf * nc * 3;
-
-    for (int i = 0; i < total; i += 3)
+    if (ts == PAM_RGBA)
     {
-        int posi = i / (nc * 3);
-        int posj = (i % (nc * 3)) / 3;
-
-        aux[i] = data[posi][posj].r;
-        aux[i + 1] = data[posi][posj].g;
-        aux[i + 2] = data[posi][posj].b;
-        m[i / 3] = data[posi][posj].transp;
+        imagen.Anadir(p, (size_t) n * sizeof(Pixel));
+        return;
     }
 
-    if (!EscribirImagenPPM(img_path, aux, nf, nc))
+    static_assert(sizeof(Rgb8) == 3, "Los píxeles RGB deben ocupar 3 bytes");
+    while (n > 0)
     {
-        cerr << "Ha habido un problema en la escritura de " << img_path << endl;
+        int k = min(n, (int) color.size() - usados);
+        ConversionPixel<Pixel, Rgb8, FormatoPixel<Pixel>, FormatoPixel<Rgb8> >::Convertir(p, k, &color[usados]);
+        if (ts == PPM_MASCARA)
+            ConversionPixel<Pixel, Gris8, FormatoPixel<Pixel>, FormatoMascara>::Convertir(p, k, &gris[usados]);
+        usados += k;
+        p += k;
+        n -= k;
+        if (usados == (int) color.size())
+            Vaciar();
     }
+}
 
-    delete[] aux;
-
-    string n_aux = "mascara_";
-    n_aux = n_aux + img_path;
-    size_t found = n_aux.find(".ppm");
-
-    if (found != string::npos)
+void EscritorImagen::Vaciar()
+{
+    imagen.Anadir(color.data(), (size_t) usados * sizeof(Rgb8));
+    imagen.Volcar();
+    if (ts == PPM_MASCARA)
     {
-        n_aux = n_aux.substr(0, found);
+        mascara.Anadir(gris.data(), usados);
+        mascara.Volcar();
     }
+    usados = 0;
+}
 
-    n_aux = n_aux + ".pgm";
+bool EscritorImagen::Cerrar()
+{
+    if (usados > 0)
+        Vaciar();
 
-    if (!EscribirImagenPGM(n_aux.c_str(), m, nf, nc))
+    bool correcta = imagen.Cerrar();
+    if (!correcta)
+        cerr << "Ha habido un problema en la escritura de " << nombre << endl;
+    if (ts == PPM_MASCARA)
     {
-        cerr << "Ha habido un problema en la escritura de " << n_aux << endl;
+        if (!mascara.Cerrar())
+        {
+            cerr << "Ha habido un problema en la escritura de " << nombre_mascara << endl;
+            correcta = false;
+        }
+        // Si ha fallado uno de los dos no dejamos el otro
+        if (!correcta)
+        {
+            remove(nombre.c_str());
+            remove(nombre_mascara.c_str());
+        }
     }
+    return correcta;
+}
 
+// Divide entre 255 redondeando, para 0 <= x <= 255*255
+static inline unsigned div255(unsigned x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
 
-    delete[] m;
+// Compone color, con transparencia 0 < a <= 255, sobre dst ("over" sin premultiplicar):
+// ao = a + ad*(1-a), dst = (color*a + dst*ad*(1-a)) / ao
+// En escala 255*255 el denominador es a*255 + ad*(255-a), que no se anula al ser a > 0
+static inline void componer_sobre(Pixel &dst, const Pixel &color, unsigned a) {
+    unsigned ws = a * 255, wd = dst.transp * (255 - a), den = ws + wd;
+    dst.r = (color.r * ws + dst.r * wd + den / 2) / den;
+    dst.g = (color.g * ws + dst.g * wd + den / 2) / den;
+    dst.b = (color.b * ws + dst.b * wd + den / 2) / den;
+    dst.transp = a + div255(wd);
 }
 
 void Imagen::PutImagen(int posi, int posj, const Imagen & img, Tipo_Pegado t){
-    assert(posi + img.nf < nf && posj + img.nc < nc);
-
-    for (int i = 0; i < img.nf; i++)
-        for (int j = 0; j < img.nc; j++)
-            if (posi + i >= 0 && posi + i < nf && posj + j >= 0 && posj + j < nc)
-            {
-                if (img(i,j).transp != 0) {
-                    if (t == OPACO)
-                        (*this).operator()(posi + i, posj + j) = img(i, j);
-                    else if (t == BLENDING) {
-                        (*this).operator()(posi + i, posj + j) = media_pixeles((*this).operator()(posi + i, posj + j), img(i, j));
-                    }
+    // Recortamos la zona de pegado una sola vez
+    int ini_i = max(0, -posi), fin_i = min(img.getFilas(), getFilas() - posi);
+    int ini_j = max(0, -posj), fin_j = min(img.getColumnas(), getColumnas() - posj);
+
+    for (int i = ini_i; i < fin_i; i++) {
+        const Pixel *src = img.pixeles[i] + ini_j;
+        Pixel *dst = pixeles[posi + i] + posj + ini_j;
+        int n = fin_j - ini_j;
+
+        switch (t) {
+            case OPACO:
+                for (int k = 0; k < n; k++)
+                    if (src[k].transp != 0)
+                        dst[k] = src[k];
+                break;
+
+            case BLENDING:
+                for (int k = 0; k < n; k++)
+                    if (src[k].transp != 0)
+                        dst[k] = media_pixeles(dst[k], src[k]);
+                break;
+
+            case SOBRE:
+                for (int k = 0; k < n; k++)
+                    if (src[k].transp != 0)
+                        componer_sobre(dst[k], src[k], src[k].transp);
+                break;
+
+            case ADITIVO:
+                // dst = min(dst + src*a, 1)
+                for (int k = 0; k < n; k++) {
+                    unsigned a = src[k].transp;
+                    dst[k].r = min(255u, dst[k].r + div255(src[k].r * a));
+                    dst[k].g = min(255u, dst[k].g + div255(src[k].g * a));
+                    dst[k].b = min(255u, dst[k].b + div255(src[k].b * a));
                 }
-            }
+                break;
+
+            case MULTIPLICATIVO:
+                // dst = dst * (src*a + (1-a))
+                for (int k = 0; k < n; k++) {
+                    unsigned a = src[k].transp, na = 255 - a;
+                    dst[k].r = div255(dst[k].r * (div255(src[k].r * a) + na));
+                    dst[k].g = div255(dst[k].g * (div255(src[k].g * a) + na));
+                    dst[k].b = div255(dst[k].b * (div255(src[k].b * a) + na));
+                }
+                break;
+        }
+    }
+}
+
+Imagen Imagen::ExtraerImagen(int i, int j, int filas, int columnas) const
+{
+    Imagen resultado;
+    resultado.pixeles = pixeles.Recortar(i, j, filas, columnas);
+    return resultado;
+}
+
+void Imagen::CopiarRegion(const Imagen &origen, const Region &reg)
+{
+    pixeles.CopiarRegion(origen.pixeles, reg.fila, reg.columna, reg.filas, reg.columnas);
+}
+
+void Imagen::DibujarLinea(double f0, double c0, double f1, double c1, const Pixel &color, const Region *recorte)
+{
+    // Límites en los que se puede pintar
+    int fmin = 0, fmax = getFilas(), cmin = 0, cmax = getColumnas();
+    if (recorte != 0) {
+        fmin = max(fmin, recorte->fila);
+        fmax = min(fmax, recorte->fila + recorte->filas);
+        cmin = max(cmin, recorte->columna);
+        cmax = min(cmax, recorte->columna + recorte->columnas);
+    }
+    if (fmin >= fmax || cmin >= cmax || color.transp == 0)
+        return;
+
+    // Trabajamos con los centros de los píxeles. x es el eje en el que el segmento avanza más
+    double x0 = c0 - 0.5, y0 = f0 - 0.5, x1 = c1 - 0.5, y1 = f1 - 0.5;
+    bool empinada = fabs(y1 - y0) > fabs(x1 - x0);
+    if (empinada) {
+        swap(x0, y0);
+        swap(x1, y1);
+    }
+    if (x0 > x1) {
+        swap(x0, x1);
+        swap(y0, y1);
+    }
+    double pendiente = (x1 > x0) ? (y1 - y0) / (x1 - x0) : 0;
+
+    int xmin = empinada ? fmin : cmin, xmax = empinada ? fmax : cmax;
+    int ymin = empinada ? cmin : fmin, ymax = empinada ? cmax : fmax;
+    int xini = max((int) floor(x0 + 0.5), xmin), xfin = min((int) floor(x1 + 0.5), xmax - 1);
+
+    for (int x = xini; x <= xfin; x++) {
+        // Parte del píxel que cubre el segmento en el eje x (sólo es menor que 1 en los extremos)
+        double cubre = min(x1, x + 0.5) - max(x0, x - 0.5);
+        if (cubre <= 0)
+            continue;
+
+        double y = y0 + pendiente * (x - x0);
+        int yi = (int) floor(y);
+        double fraccion = y - yi;
+        double cobertura[2] = {(1 - fraccion) * cubre, fraccion * cubre};
+
+        for (int k = 0; k < 2; k++) {
+            int yk = yi + k;
+            unsigned a = (unsigned) (color.transp * cobertura[k] + 0.5);
+            if (yk < ymin || yk >= ymax || a == 0)
+                continue;
+
+            componer_sobre(empinada ? pixeles[x][yk] : pixeles[yk][x], color, a);
+        }
+    }
 }
 
 const Pixel &Imagen::operator()(int i, int j) const {
-    assert(i >= 0 && i < nf && j >= 0 && j < nc);
-	return data[i][j];
+	return pixeles(i, j);
 }
 
 Pixel &Imagen::operator()(int i, int j) {
-    assert(i >= 0 && i < nf && j >= 0 && j < nc);
-	return data[i][j];
+	return pixeles(i, j);
 }
 
-Imagen Imagen::Rota(double angulo) const {
-    double rads=angulo;
-    double coseno = cos(angulo);
-    double seno = sin(angulo);
+void Imagen::DimensionesRotada(double coseno, double seno, double &new_row_min, double &new_col_min,
+                               int &newimgrows, int &newimgcols) const {
     //Para obtener las dimensiones de la imagen
     int rcorners[4],ccorners[4];
-    int newimgrows,newimgcols;
-    double new_row_min,new_col_min,new_row_max,new_col_max;
+    double new_row_max,new_col_max;
     double inter,inter1;
     rcorners[0]=0;
     rcorners[1]=0;
@@ -217,8 +392,6 @@ Imagen Imagen::Rota(double angulo) const {
     new_col_min=0;
     new_row_max=0;
     new_col_max=0;
-    newimgrows=0;
-    newimgcols=0;
     for(int count=0;count<4;count++){
         inter=rcorners[count]*coseno+ccorners[count]*seno;
 
@@ -236,6 +409,13 @@ Imagen Imagen::Rota(double angulo) const {
 
     newimgrows=(unsigned)ceil((double)new_row_max-new_row_min);
     newimgcols=(unsigned)ceil((double)new_col_max-new_col_min);
+}
+
+Imagen Imagen::Rota_noeff(double angulo) const {
+    double rads=angulo;
+    int newimgrows,newimgcols;
+    double new_row_min,new_col_min;
+    DimensionesRotada(cos(angulo), sin(angulo), new_row_min, new_col_min, newimgrows, newimgcols);
 
     Imagen Iout(newimgrows,newimgcols);
     for(int rows=0;rows<newimgrows;rows++){
@@ -260,4 +440,96 @@ Imagen Imagen::Rota(double angulo) const {
     return Iout;
 }
 
+// Bits de la parte fraccionaria en la aritmética de punto fijo de Rota(). Con 32 el error del
+// incremento no llega a acumular un píxel ni en filas de millones de columnas
+#define BITS_FRAC 32
+#define UNO_FIJO ((int64_t) 1 << BITS_FRAC)
+
+// Interpola linealmente dos componentes con un peso de 8 bits para la segunda
+static inline unsigned mezcla(unsigned a, unsigned b, unsigned peso) {
+    return a * (256 - peso) + b * peso;
+}
+
+Imagen Imagen::Rota(double angulo, Tipo_Interpolacion ti) const {
+    double coseno = cos(angulo);
+    double seno = sin(angulo);
+    int newimgrows,newimgcols;
+    double new_row_min,new_col_min;
+    DimensionesRotada(coseno, seno, new_row_min, new_col_min, newimgrows, newimgcols);
+
+    // Al avanzar una columna en la imagen rotada, el origen avanza siempre lo mismo. Las
+    // coordenadas de origen, en punto fijo, necesitan 64 bits
+    const int64_t drow = llround(-seno * UNO_FIJO);
+    const int64_t dcol = llround(coseno * UNO_FIJO);
+
+    Pixel transparente;
+    transparente.r = transparente.g = transparente.b = 255;
+    transparente.transp = 0;
+
+    // Dimensiones de la imagen original en variables locales: las escrituras en Iout no pueden modificarlas
+    const int nf = getFilas(), nc = getColumnas();
+
+    Imagen Iout(newimgrows,newimgcols);
+    for(int rows=0;rows<newimgrows;rows++){
+        // Origen (en punto fijo) del primer píxel de la fila
+        double r = rows + new_row_min;
+        int64_t frow = llround((r*coseno - new_col_min*seno) * UNO_FIJO);
+        int64_t fcol = llround((r*seno + new_col_min*coseno) * UNO_FIJO);
+        Pixel *out = Iout.pixeles[rows];
+
+        if (ti == VECINO) {
+            for(int cols=0;cols<newimgcols;cols++, frow+=drow, fcol+=dcol){
+                // Redondeo hacia arriba, como en Rota_noeff()
+                int old_row = (int) ((frow + UNO_FIJO - 1) >> BITS_FRAC);
+                int old_col = (int) ((fcol + UNO_FIJO - 1) >> BITS_FRAC);
+                if ((unsigned) old_row < (unsigned) nf && (unsigned) old_col < (unsigned) nc)
+                    out[cols] = pixeles[old_row][old_col];
+                else
+                    out[cols] = transparente;
+            }
+        }
+        else {
+            for(int cols=0;cols<newimgcols;cols++, frow+=drow, fcol+=dcol){
+                int old_row = (int) (frow >> BITS_FRAC);
+                int old_col = (int) (fcol >> BITS_FRAC);
+                if ((unsigned) old_row < (unsigned) nf && (unsigned) old_col < (unsigned) nc) {
+                    // Pesos de 8 bits de la fila y columna siguientes
+                    unsigned pf = (frow >> (BITS_FRAC - 8)) & 0xFF;
+                    unsigned pc = (fcol >> (BITS_FRAC - 8)) & 0xFF;
+                    const Pixel *f0 = pixeles[old_row];
+                    const Pixel *f1 = pixeles[old_row + 1 < nf ? old_row + 1 : old_row];
+                    int c1 = old_col + 1 < nc ? old_col + 1 : old_col;
+
+                    const Pixel &a = f0[old_col], &b = f0[c1], &c = f1[old_col], &d = f1[c1];
+                    if ((a.transp & b.transp & c.transp & d.transp) == 255) {
+                        out[cols].r = (mezcla(mezcla(a.r, b.r, pc), mezcla(c.r, d.r, pc), pf) + (1 << 15)) >> 16;
+                        out[cols].g = (mezcla(mezcla(a.g, b.g, pc), mezcla(c.g, d.g, pc), pf) + (1 << 15)) >> 16;
+                        out[cols].b = (mezcla(mezcla(a.b, b.b, pc), mezcla(c.b, d.b, pc), pf) + (1 << 15)) >> 16;
+                        out[cols].transp = 255;
+                        continue;
+                    }
+
+                    // Si no son todos opacos se interpolan los colores premultiplicados por su
+                    // transparencia, para que el color de los píxeles transparentes no se mezcle
+                    unsigned wa = (256 - pc) * (256 - pf) * a.transp, wb = pc * (256 - pf) * b.transp;
+                    unsigned wc = (256 - pc) * pf * c.transp, wd = pc * pf * d.transp;
+                    unsigned total = wa + wb + wc + wd;
+                    if (total == 0) {
+                        out[cols] = transparente;
+                        continue;
+                    }
+                    // Cada suma es como mucho 65536*255*255 + total/2 < 2^32
+                    out[cols].r = (a.r * wa + b.r * wb + c.r * wc + d.r * wd + total / 2) / total;
+                    out[cols].g = (a.g * wa + b.g * wb + c.g * wc + d.g * wd + total / 2) / total;
+                    out[cols].b = (a.b * wa + b.b * wb + c.b * wc + d.b * wd + total / 2) / total;
+                    out[cols].transp = (total + (1 << 15)) >> 16;
+                }
+                else
+                    out[cols] = transparente;
+            }
+        }
+    }
+    return Iout;
+}
+
 // TODO Ambos Iteradores
\ No newline at end of file
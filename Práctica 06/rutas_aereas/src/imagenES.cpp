@@ -2,7 +2,11 @@
   * @file imagenES.cpp
   * @brief Fichero con definiciones para la E/S de imágenes
   *
-  * Permite la E/S de archivos de tipo PGM,PPM
+  * Permite la E/S de archivos de tipo PGM,PPM,PAM
+  *
+  * Las escrituras se hacen con una sola llamada al sistema por fichero (writev con la
+  * cabecera y los datos), sin copiar los datos a un buffer intermedio. FicheroSalida permite
+  * además escribir una imagen por partes, juntando varias en cada writev.
   *
   * @author Arturo Olivares Martos
   * @author Daniel Hidalgo Chica
@@ -11,6 +15,12 @@
 
 #include <fstream>
 #include <string>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
 #include "imagenES.h"
 using namespace std;
 
@@ -27,6 +37,7 @@ TipoImagen LeerTipo(ifstream& f)
 			switch (c2) {
 				case '5': res= IMG_PGM; break;
 				case '6': res= IMG_PPM; break;
+				case '7': res= IMG_PAM; break;
 				default: res= IMG_DESCONOCIDO;
 			}
 	}
@@ -74,21 +85,66 @@ bool LeerCabecera (ifstream& f, int& filas, int& columnas)
 
 // _____________________________________________________________________________
 
-TipoImagen LeerTipoImagen(const char nombre[], int& filas, int& columnas)
+// Lee la cabecera de una imagen PAM, hasta ENDHDR, y devuelve el número de canales
+bool LeerCabeceraPAM (ifstream& f, int& filas, int& columnas, int& canales)
+{
+	string clave;
+	int maxvalor=0;
+	canales=0;
+
+	while (f >> clave && clave!="ENDHDR") {
+		if (clave[0]=='#')
+			f.ignore(10000,'\n');
+		else if (clave=="WIDTH")
+			f >> columnas;
+		else if (clave=="HEIGHT")
+			f >> filas;
+		else if (clave=="DEPTH")
+			f >> canales;
+		else if (clave=="MAXVAL")
+			f >> maxvalor;
+		else
+			f.ignore(10000,'\n'); // TUPLTYPE u otras que no usamos
+	}
+
+	if (f && filas>0 && filas <5000 && columnas >0 && columnas<5000 && maxvalor==255 && (canales==3 || canales==4)) {
+		f.get(); // Saltamos el salto de línea tras ENDHDR
+		return true;
+	}
+	else return false;
+}
+
+// _____________________________________________________________________________
+
+TipoImagen LeerTipoImagen(const char nombre[], int& filas, int& columnas, int& canales)
 {
 	TipoImagen tipo;
-	filas=columnas=0;
+	filas=columnas=canales=0;
 	ifstream f(nombre);
 
 	tipo=LeerTipo(f);
-	if (tipo!=IMG_DESCONOCIDO)
+	if (tipo==IMG_PAM) {
+		if (!LeerCabeceraPAM(f,filas,columnas,canales))
+			tipo=IMG_DESCONOCIDO;
+	}
+	else if (tipo!=IMG_DESCONOCIDO) {
+		canales= (tipo==IMG_PGM) ? 1 : 3;
 		if (!LeerCabecera(f,filas,columnas)) {
 			tipo=IMG_DESCONOCIDO;
 		}
+	}
 
 	return tipo;
 }
 
+// _____________________________________________________________________________
+
+TipoImagen LeerTipoImagen(const char nombre[], int& filas, int& columnas)
+{
+	int canales;
+	return LeerTipoImagen(nombre, filas, columnas, canales);
+}
+
 
 // _____________________________________________________________________________
 
@@ -128,35 +184,130 @@ bool LeerImagenPGM (const char nombre[], int& filas, int& columnas, unsigned cha
 
 // _____________________________________________________________________________
 
-bool EscribirImagenPPM (const char nombre[], const unsigned char datos[], int filas, int columnas)
+// Como mucho, POSIX garantiza 16 partes por llamada a writev
+#ifndef IOV_MAX
+#define IOV_MAX 16
+#endif
+
+void FicheroSalida::Descartar ()
+{
+	partes.clear();
+	if (fd>=0) {
+		close(fd);
+		unlink(nombre.c_str());
+		fd= -1;
+	}
+	correcto= false;
+}
+
+bool FicheroSalida::Abrir (const char nombre[])
+{
+	Descartar();
+	this->nombre= nombre;
+	partes.clear();
+	fd= open(nombre, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	correcto= (fd>=0);
+	return correcto;
+}
+
+void FicheroSalida::Anadir (const void *datos, size_t n)
 {
-	ofstream f(nombre);
-	bool res= true;
+	if (!correcto || n==0)
+		return;
+
+	struct iovec parte;
+	parte.iov_base= const_cast<void *>(datos);
+	parte.iov_len= n;
+	partes.push_back(parte);
+	if (partes.size()>=IOV_MAX)
+		Volcar();
+}
 
-	if (f) {
-		f << "P6" << endl;
-		f << columnas << ' ' << filas << endl;
-		f << 255 << endl;
-		f.write(reinterpret_cast<const char *>(datos),filas*columnas*3);
-		if (!f) res=false;
+bool FicheroSalida::Volcar ()
+{
+	// writev puede escribir menos de lo pedido; en ese caso seguimos donde se quedó
+	size_t primera= 0, total= partes.size();
+	while (correcto && primera<total) {
+		ssize_t escritos= writev(fd, partes.data()+primera, total-primera);
+		if (escritos<0) {
+			if (errno!=EINTR)
+				correcto= false;
+			continue;
+		}
+		while (primera<total && (size_t) escritos>=partes[primera].iov_len) {
+			escritos-= partes[primera].iov_len;
+			primera++;
+		}
+		if (primera<total) {
+			partes[primera].iov_base= static_cast<char *>(partes[primera].iov_base)+escritos;
+			partes[primera].iov_len-= escritos;
+		}
 	}
-	return res;
+	partes.clear();
+	return correcto;
+}
+
+bool FicheroSalida::Cerrar ()
+{
+	if (fd<0)
+		return false;
+
+	Volcar();
+	if (close(fd)!=0)
+		correcto= false;
+	fd= -1;
+	if (!correcto)
+		unlink(nombre.c_str());
+	return correcto;
+}
+
+// _____________________________________________________________________________
+
+string CabeceraImagen (TipoImagen tipo, int filas, int columnas)
+{
+	switch (tipo) {
+		case IMG_PGM:
+			return "P5\n" + to_string(columnas) + ' ' + to_string(filas) + "\n255\n";
+		case IMG_PPM:
+			return "P6\n" + to_string(columnas) + ' ' + to_string(filas) + "\n255\n";
+		case IMG_PAM:
+			return "P7\nWIDTH " + to_string(columnas) + "\nHEIGHT " + to_string(filas) +
+				   "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+		default:
+			return "";
+	}
+}
+
+// _____________________________________________________________________________
+
+// Escribe la cabecera y los datos de una imagen con una sola llamada a writev
+bool EscribirFichero (const char nombre[], const string& cabecera, const unsigned char datos[], size_t n)
+{
+	FicheroSalida f;
+	if (!f.Abrir(nombre))
+		return false;
+	f.Anadir(cabecera.data(), cabecera.size());
+	f.Anadir(datos, n);
+	return f.Cerrar();
+}
+
+// _____________________________________________________________________________
+
+bool EscribirImagenPPM (const char nombre[], const unsigned char datos[], int filas, int columnas)
+{
+	return EscribirFichero(nombre, CabeceraImagen(IMG_PPM, filas, columnas), datos, (size_t) filas*columnas*3);
 }
 // _____________________________________________________________________________
 
 bool EscribirImagenPGM (const char nombre[], const unsigned char datos[], int filas, int columnas)
 {
-	ofstream f(nombre);
-	bool res= true;
+	return EscribirFichero(nombre, CabeceraImagen(IMG_PGM, filas, columnas), datos, (size_t) filas*columnas);
+}
+// _____________________________________________________________________________
 
-	if (f) {
-		f << "P5" << endl;
-		f << columnas << ' ' << filas << endl;
-		f << 255 << endl;
-		f.write(reinterpret_cast<const char *>(datos),filas*columnas);
-		if (!f) res=false;
-	}
-	return res;
+bool EscribirImagenPAM (const char nombre[], const unsigned char datos[], int filas, int columnas)
+{
+	return EscribirFichero(nombre, CabeceraImagen(IMG_PAM, filas, columnas), datos, (size_t) filas*columnas*4);
 }
 
 
@@ -0,0 +1,109 @@
+/**
+ * @file imagen_prueba.cpp
+ * @brief Comprueba la lectura y escritura de imágenes PAM de la clase Imagen
+ *
+ * Escribe a mano una imagen PAM con 3 canales (RGB) y otra con 4 (RGBA), las lee con
+ * Imagen::LeerImagen() y comprueba cada píxel: la de 3 canales debe quedar opaca. Después
+ * escribe cada una con Imagen::EscribirImagen() como PAM y como PPM con máscara, la vuelve a
+ * leer y comprueba que es igual.
+ *
+ * @param Directorio Directorio donde se dejan los ficheros de la prueba. Opcional, por defecto el actual.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./imagen_prueba /tmp
+ * @endcode
+ *
+ * Muestra el número de comprobaciones y de errores, y termina con 0 si no hay errores.
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "imagen.h"
+
+using namespace std;
+
+const int FILAS = 37;     ///< Filas de las imágenes de prueba
+const int COLUMNAS = 53;  ///< Columnas de las imágenes de prueba
+
+/**
+ * @brief Valor de la muestra k del píxel (i, j) de las imágenes de prueba
+ */
+unsigned char Muestra(int i, int j, int k) {
+	return (unsigned char) (i * 7 + j * 13 + k * 61);
+}
+
+/**
+ * @brief Escribe una imagen PAM de prueba
+ * @param nombre Fichero
+ * @param canales 3 (RGB) o 4 (RGBA)
+ */
+void EscribirPAM(const string &nombre, int canales) {
+	ofstream f(nombre.c_str(), ios::binary);
+	f << "P7\nWIDTH " << COLUMNAS << "\nHEIGHT " << FILAS << "\nDEPTH " << canales
+	  << "\nMAXVAL 255\nTUPLTYPE " << (canales == 4 ? "RGB_ALPHA" : "RGB") << "\nENDHDR\n";
+	for (int i = 0; i < FILAS; i++)
+		for (int j = 0; j < COLUMNAS; j++)
+			for (int k = 0; k < canales; k++)
+				f.put(Muestra(i, j, k));
+}
+
+/**
+ * @brief Indica si una imagen tiene los píxeles de la imagen de prueba
+ * @param img Imagen
+ * @param canales Canales de la imagen de prueba. Con 3, la transparencia debe ser 255
+ */
+bool Comprobar(const Imagen &img, int canales) {
+	if (img.getFilas() != FILAS || img.getColumnas() != COLUMNAS)
+		return false;
+	for (int i = 0; i < FILAS; i++)
+		for (int j = 0; j < COLUMNAS; j++) {
+			const Pixel &p = img(i, j);
+			unsigned char transp = (canales == 4) ? Muestra(i, j, 3) : 255;
+			if (p.r != Muestra(i, j, 0) || p.g != Muestra(i, j, 1) || p.b != Muestra(i, j, 2) || p.transp != transp)
+				return false;
+		}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 2) {
+		cerr << "Uso: imagen_prueba [Directorio]" << endl;
+		return 1;
+	}
+	string dir = (argc > 1) ? string(argv[1]) + "/" : "";
+
+	int comprobaciones = 0, errores = 0;
+	for (int canales = 3; canales <= 4; canales++) {
+		string nombre = dir + "imagen_prueba_" + to_string(canales) + ".pam";
+		EscribirPAM(nombre, canales);
+
+		Imagen img;
+		img.LeerImagen(nombre.c_str());
+		errores += !Comprobar(img, canales);
+
+		// Ida y vuelta como PAM
+		string pam = dir + "imagen_prueba_" + to_string(canales) + "_copia.pam";
+		img.EscribirImagen(pam.c_str(), PAM_RGBA);
+		Imagen copia;
+		copia.LeerImagen(pam.c_str());
+		errores += !Comprobar(copia, canales);
+
+		// Ida y vuelta como PPM con la transparencia en la máscara
+		string ppm = dir + "imagen_prueba_" + to_string(canales) + "_copia.ppm";
+		img.EscribirImagen(ppm.c_str(), PPM_MASCARA);
+		Imagen copia_ppm;
+		copia_ppm.LeerImagen(ppm.c_str(), Imagen::NombreMascara(ppm.c_str()));
+		errores += !Comprobar(copia_ppm, canales);
+
+		comprobaciones += 3;
+	}
+
+	cout << "Comprobaciones: " << comprobaciones << ", errores: " << errores << endl;
+	return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+/**
+ * @file mapaTeselado.cpp
+ * @brief Fichero de implementación del TDA MapaTeselado
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "mapaTeselado.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/**
+ * @brief Interseca dos regiones
+ * @param a Primera región
+ * @param b Segunda región
+ * @return Intersección. Si no se cortan, tiene 0 filas o 0 columnas
+ */
+static Region Interseccion(const Region &a, const Region &b) {
+	int fila = max(a.fila, b.fila), columna = max(a.columna, b.columna);
+	int filas = min(a.fila + a.filas, b.fila + b.filas) - fila;
+	int columnas = min(a.columna + a.columnas, b.columna + b.columnas) - columna;
+	Region r = {fila, columna, max(filas, 0), max(columnas, 0)};
+	return r;
+}
+
+/**
+ * @brief Indica si una región está vacía
+ * @param r Región
+ * @return true si no tiene filas o no tiene columnas
+ */
+static inline bool Vacia(const Region &r) {
+	return r.filas <= 0 || r.columnas <= 0;
+}
+
+MapaTeselado::MapaTeselado() : nf(0), nc(0), tc(0) {}
+
+MapaTeselado::MapaTeselado(const Imagen &img) : nf(img.getFilas()), nc(img.getColumnas()) {
+	int tf = (nf + TAM_TESELA - 1) / TAM_TESELA;
+	tc = (nc + TAM_TESELA - 1) / TAM_TESELA;
+
+	for (int ti = 0; ti < tf; ti++)
+		for (int tj = 0; tj < tc; tj++) {
+			int fila = ti * TAM_TESELA, columna = tj * TAM_TESELA;
+			base.push_back(make_shared<const Imagen>(img.ExtraerImagen(fila, columna,
+					min(TAM_TESELA, nf - fila), min(TAM_TESELA, nc - columna))));
+			base_opaca.push_back(base.back()->EsOpaca());
+		}
+
+	Region vacia = {0, 0, 0, 0};
+	propias.assign(base.size(), shared_ptr<Imagen>());
+	cajas.assign(base.size(), vacia);
+}
+
+MapaTeselado::MapaTeselado(const MapaTeselado &otro) {
+	*this = otro;
+}
+
+MapaTeselado & MapaTeselado::operator=(const MapaTeselado &otro) {
+	if (this != &otro) {
+		nf = otro.nf;
+		nc = otro.nc;
+		tc = otro.tc;
+		base = otro.base;
+		base_opaca = otro.base_opaca;
+
+		Region vacia = {0, 0, 0, 0};
+		propias.assign(base.size(), shared_ptr<Imagen>());
+		cajas.assign(base.size(), vacia);
+	}
+	return *this;
+}
+
+const Pixel & MapaTeselado::operator()(int i, int j) const {
+	int t = (i / TAM_TESELA) * tc + j / TAM_TESELA;
+	const Imagen &tesela = propias[t] ? *propias[t] : *base[t];
+	return tesela(i % TAM_TESELA, j % TAM_TESELA);
+}
+
+Imagen & MapaTeselado::Escribir(int t) {
+	if (!propias[t])
+		propias[t] = make_shared<Imagen>(*base[t]);
+	return *propias[t];
+}
+
+void MapaTeselado::Anotar(int t, int fila, int columna, int filas, int columnas) {
+	Region nueva = {fila, columna, filas, columnas};
+	Region &caja = cajas[t];
+	if (Vacia(caja))
+		caja = nueva;
+	else {
+		int fin_f = max(caja.fila + caja.filas, fila + filas), fin_c = max(caja.columna + caja.columnas, columna + columnas);
+		caja.fila = min(caja.fila, fila);
+		caja.columna = min(caja.columna, columna);
+		caja.filas = fin_f - caja.fila;
+		caja.columnas = fin_c - caja.columna;
+	}
+}
+
+bool MapaTeselado::Teselas(const Region &reg, int &ti0, int &ti1, int &tj0, int &tj1) const {
+	Region mapa = {0, 0, nf, nc};
+	Region r = Interseccion(reg, mapa);
+	if (Vacia(r))
+		return false;
+
+	ti0 = r.fila / TAM_TESELA;
+	ti1 = (r.fila + r.filas - 1) / TAM_TESELA;
+	tj0 = r.columna / TAM_TESELA;
+	tj1 = (r.columna + r.columnas - 1) / TAM_TESELA;
+	return true;
+}
+
+void MapaTeselado::PutImagen(int i, int j, const Imagen &img, Tipo_Pegado tp) {
+	Region reg = {i, j, img.getFilas(), img.getColumnas()};
+	int ti0, ti1, tj0, tj1;
+	if (!Teselas(reg, ti0, ti1, tj0, tj1))
+		return;
+
+	for (int ti = ti0; ti <= ti1; ti++)
+		for (int tj = tj0; tj <= tj1; tj++) {
+			int t = ti * tc + tj, fila = ti * TAM_TESELA, columna = tj * TAM_TESELA;
+			Imagen &tesela = Escribir(t);
+			tesela.PutImagen(i - fila, j - columna, img, tp);
+
+			Region zona = {fila, columna, tesela.getFilas(), tesela.getColumnas()};
+			zona = Interseccion(zona, reg);
+			Anotar(t, zona.fila, zona.columna, zona.filas, zona.columnas);
+		}
+}
+
+void MapaTeselado::DibujarLinea(double f0, double c0, double f1, double c1, const Pixel &color, const Region *recorte) {
+	// Caja del segmento, ampliada un píxel por el antialiasing
+	int fmin = (int) floor(min(f0, f1)) - 1, fmax = (int) floor(max(f0, f1)) + 1;
+	int cmin = (int) floor(min(c0, c1)) - 1, cmax = (int) floor(max(c0, c1)) + 1;
+	Region reg = {fmin, cmin, fmax - fmin + 1, cmax - cmin + 1};
+	if (recorte != 0)
+		reg = Interseccion(reg, *recorte);
+
+	int ti0, ti1, tj0, tj1;
+	if (color.transp == 0 || !Teselas(reg, ti0, ti1, tj0, tj1))
+		return;
+
+	for (int ti = ti0; ti <= ti1; ti++)
+		for (int tj = tj0; tj <= tj1; tj++) {
+			int t = ti * tc + tj, fila = ti * TAM_TESELA, columna = tj * TAM_TESELA;
+			Imagen &tesela = Escribir(t);
+
+			// Recortamos a la tesela, en sus propias coordenadas
+			Region zona = {fila, columna, tesela.getFilas(), tesela.getColumnas()};
+			zona = Interseccion(zona, reg);
+			Region local = {zona.fila - fila, zona.columna - columna, zona.filas, zona.columnas};
+			tesela.DibujarLinea(f0 - fila, c0 - columna, f1 - fila, c1 - columna, color, &local);
+			Anotar(t, zona.fila, zona.columna, zona.filas, zona.columnas);
+		}
+}
+
+Region MapaTeselado::Huella() const {
+	Region huella = {0, 0, 0, 0};
+	for (size_t t = 0; t < cajas.size(); t++) {
+		const Region &caja = cajas[t];
+		if (Vacia(caja))
+			continue;
+		if (Vacia(huella))
+			huella = caja;
+		else {
+			int fin_f = max(huella.fila + huella.filas, caja.fila + caja.filas);
+			int fin_c = max(huella.columna + huella.columnas, caja.columna + caja.columnas);
+			huella.fila = min(huella.fila, caja.fila);
+			huella.columna = min(huella.columna, caja.columna);
+			huella.filas = fin_f - huella.fila;
+			huella.columnas = fin_c - huella.columna;
+		}
+	}
+	return huella;
+}
+
+int MapaTeselado::TeselasModificadas() const {
+	int n = 0;
+	for (size_t t = 0; t < propias.size(); t++)
+		if (propias[t])
+			n++;
+	return n;
+}
+
+void MapaTeselado::Restaurar() {
+	Region vacia = {0, 0, 0, 0};
+	for (size_t t = 0; t < propias.size(); t++) {
+		propias[t].reset();
+		cajas[t] = vacia;
+	}
+}
+
+Imagen MapaTeselado::ExtraerImagen(const Region &reg) const {
+	Imagen resultado(reg.filas, reg.columnas);
+	for (int i = 0; i < reg.filas; i++) {
+		int fila = reg.fila + i;
+		for (int j = 0; j < reg.columnas; ) {
+			// Copiamos de una vez el tramo de la fila que cae en la misma tesela
+			int columna = reg.columna + j;
+			int fin = min(reg.columnas, j + TAM_TESELA - columna % TAM_TESELA);
+			const Pixel *origen = &(*this)(fila, columna);
+			for (; j < fin; j++, origen++)
+				resultado(i, j) = *origen;
+		}
+	}
+	return resultado;
+}
+
+bool MapaTeselado::EsOpaca(const Region &reg) const {
+	int ti0, ti1, tj0, tj1;
+	if (!Teselas(reg, ti0, ti1, tj0, tj1))
+		return true;
+
+	for (int ti = ti0; ti <= ti1; ti++)
+		for (int tj = tj0; tj <= tj1; tj++) {
+			int t = ti * tc + tj;
+			if (propias[t] ? !propias[t]->EsOpaca() : !base_opaca[t])
+				return false;
+		}
+	return true;
+}
+
+bool MapaTeselado::EscribirRegion(const char img_path[], const Region &reg, Tipo_Salida ts) const {
+	if (Vacia(reg)) {
+		cerr << "La región a escribir en " << img_path << " está vacía" << endl;
+		return false;
+	}
+	if (ts == AUTOMATICO)
+		ts = EsOpaca(reg) ? SOLO_PPM : PPM_MASCARA;
+
+	EscritorImagen escritor;
+	if (!escritor.Abrir(img_path, reg.filas, reg.columnas, ts))
+		return false;
+
+	// Cada fila se da por tramos, uno por cada tesela que atraviesa
+	for (int i = 0; i < reg.filas; i++) {
+		int fila = reg.fila + i;
+		for (int j = 0; j < reg.columnas; ) {
+			int columna = reg.columna + j;
+			int fin = min(reg.columnas, j + TAM_TESELA - columna % TAM_TESELA);
+			escritor.Anadir(&(*this)(fila, columna), fin - j);
+			j = fin;
+		}
+	}
+	return escritor.Cerrar();
+}
+
+bool MapaTeselado::EscribirImagen(const char img_path[], Tipo_Salida ts) const {
+	Region todo = {0, 0, nf, nc};
+	return EscribirRegion(img_path, todo, ts);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file mapa_medida.cpp
+ * @brief Fichero usado para medir el coste de dibujar rutas sobre un mapa grande
+ *
+ * Genera un mapa de las dimensiones indicadas y un conjunto de rutas cortas aleatorias.
+ * Para cada ruta dibuja sus arcos y pega un avión en cada punto, y luego obtiene la imagen a guardar.
+ * Compara hacerlo sobre una copia completa del mapa (una Imagen, como hacía rutaaerea) con hacerlo
+ * sobre un MapaTeselado, que sólo duplica las teselas que toca la ruta y puede extraer sólo su huella.
+ *
+ * @param Filas Número de filas del mapa. Opcional, por defecto 4096 (el doble de columnas).
+ * @param NumeroDeRutas Número de rutas. Opcional, por defecto 100.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./mapa_medida 4096 100
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "imagen.h"
+#include "mapaTeselado.h"
+#include "arcos.h"
+
+using namespace std;
+
+/**
+ * @brief Dibuja una ruta sobre un lienzo: sus arcos y un avión en cada punto
+ * @param ruta Puntos de la ruta
+ * @param avion Imagen del avión
+ * @param lienzo Imagen o MapaTeselado sobre el que se dibuja
+ */
+template <class Lienzo>
+void Dibujar(const vector<Punto> &ruta, const Imagen &avion, Lienzo &lienzo) {
+	Pixel rojo = {200, 0, 0, 255};
+	LoteArcos arcos;
+	for (size_t i = 1; i < ruta.size(); i++)
+		arcos.Anadir(ruta[i - 1], ruta[i]);
+	arcos.Dibujar(lienzo, rojo);
+
+	for (size_t i = 0; i < ruta.size(); i++) {
+		pair<int,int> pos = ruta[i].coordenadasMapa(lienzo.getColumnas(), lienzo.getFilas());
+		lienzo.PutImagen(pos.first, pos.second, avion, SOBRE);
+	}
+}
+
+int main (int argc, char* argv[]) {
+	int filas = (argc > 1) ? atoi(argv[1]) : 4096;
+	int nrutas = (argc > 2) ? atoi(argv[2]) : 100;
+
+	if (argc > 3 || filas <= 0 || nrutas <= 0) {
+		cerr << "Uso: mapa_medida [Filas] [NumeroDeRutas]" << endl;
+		return 1;
+	}
+
+	// Mapa con un degradado y avión semitransparente
+	srand(1);
+	Imagen imagen(filas, 2 * filas), avion(32, 32);
+	for (int i = 0; i < imagen.getFilas(); i++)
+		for (int j = 0; j < imagen.getColumnas(); j++) {
+			Pixel p = {(unsigned char) i, (unsigned char) j, (unsigned char) (i + j), 255};
+			imagen(i, j) = p;
+		}
+	for (int i = 0; i < avion.getFilas(); i++)
+		for (int j = 0; j < avion.getColumnas(); j++) {
+			Pixel p = {0, 0, 255, (unsigned char) (8 * (i + j))};
+			avion(i, j) = p;
+		}
+
+	// Rutas de 4 puntos en un entorno de 10 grados
+	vector<vector<Punto> > rutas(nrutas);
+	for (int r = 0; r < nrutas; r++) {
+		double lat = rand() / (double) RAND_MAX * 140 - 70, lon = rand() / (double) RAND_MAX * 340 - 170;
+		for (int k = 0; k < 4; k++)
+			rutas[r].push_back(Punto(lat + rand() / (double) RAND_MAX * 10 - 5, lon + rand() / (double) RAND_MAX * 10 - 5));
+	}
+
+	// Copia completa del mapa por ruta
+	clock_t tini = clock();
+	long long pixeles_imagen = 0;
+	for (int r = 0; r < nrutas; r++) {
+		Imagen lienzo(imagen);
+		Dibujar(rutas[r], avion, lienzo);
+		pixeles_imagen += (long long) lienzo.getFilas() * lienzo.getColumnas();
+	}
+	clock_t tfin = clock();
+	double t_imagen = (tfin - tini) / (double) CLOCKS_PER_SEC / nrutas;
+
+	// Mapa teselado: se crea una vez, y por ruta se dibuja, se extrae la huella y se restaura
+	tini = clock();
+	MapaTeselado mapa(imagen);
+	tfin = clock();
+	double t_teselar = (tfin - tini) / (double) CLOCKS_PER_SEC;
+
+	tini = clock();
+	long long pixeles_huella = 0, teselas = 0;
+	for (int r = 0; r < nrutas; r++) {
+		Dibujar(rutas[r], avion, mapa);
+		Imagen recorte = mapa.ExtraerImagen(mapa.Huella());
+		pixeles_huella += (long long) recorte.getFilas() * recorte.getColumnas();
+		teselas += mapa.TeselasModificadas();
+		mapa.Restaurar();
+	}
+	tfin = clock();
+	double t_teselado = (tfin - tini) / (double) CLOCKS_PER_SEC / nrutas;
+
+	// Mostramos resultados (segundos por ruta)
+	cout << "Mapa: " << imagen.getFilas() << "x" << imagen.getColumnas() << ", rutas: " << nrutas << endl;
+	cout << "Imagen:\t\t" << t_imagen << " s/ruta, " << pixeles_imagen / nrutas << " pixeles de salida" << endl;
+	cout << "MapaTeselado:\t" << t_teselado << " s/ruta, " << pixeles_huella / nrutas << " pixeles de salida, "
+		 << teselas / (double) nrutas << " teselas modificadas (teselar el mapa: " << t_teselar << " s)" << endl;
+
+	return 0;
+}
@@ -10,16 +10,16 @@
 #include "pais.h"
 
 Pais::Pais(string nombre, string bandera, const Punto &p) {
-	this->nombre = nombre;
-	this->bandera = bandera;
+	this->nombre = move(nombre);
+	this->bandera = move(bandera);
 	this->p = p;
 }
 
-string Pais::getNombre() const {
+const string & Pais::getNombre() const {
 	return nombre;
 }
 
-string Pais::getBandera() const {
+const string & Pais::getBandera() const {
 	return bandera;
 }
 
@@ -40,7 +40,7 @@ void Pais::setPunto(const Punto &p) {
 }
 
 bool Pais::operator<(const Pais &p) const {
-	return nombre < p.getNombre();
+	return nombre < p.nombre;
 }
 
 ostream & operator<<(ostream & os, const Pais & p) {
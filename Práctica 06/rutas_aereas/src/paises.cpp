@@ -8,46 +8,389 @@
  */
 
 #include "paises.h"
-#include <sstream>
+#include "ficheroMapeado.h"
+#include "formatoBinario.h"
+#include <cstring>
+#include <algorithm>
 
 const string CAD_MAGS[4] = {"# Latitud", "Longitud", "Pais", "Bandera"};
 
+#define MAGIA_BINARIA "PAISEBIN"
+
+const double Paises::TAM_CELDA = 1.0;
+
+int Paises::Celda(double grados) {
+	return (int) floor(grados / TAM_CELDA);
+}
+
+long long Paises::Clave(int fila, int columna) {
+	return ((long long) fila << 32) ^ (unsigned int) columna;
+}
+
+size_t Paises::Hash(const string &s) {
+	size_t h = 14695981039346656037ULL;
+	for (size_t i = 0; i < s.size(); i++) {
+		h ^= (unsigned char) s[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+void Paises::InsertarHash(vector<int> &tabla, const string &clave, int pos) {
+	size_t mascara = tabla.size() - 1;
+	size_t i = Hash(clave) & mascara;
+	while (tabla[i] != -1)
+		i = (i + 1) & mascara;
+	tabla[i] = pos;
+}
+
+int Paises::BuscarNombre(const string &nombre) const {
+	if (hash_nombre.empty())
+		return -1;
+
+	size_t mascara = hash_nombre.size() - 1;
+	for (size_t i = Hash(nombre) & mascara; hash_nombre[i] != -1; i = (i + 1) & mascara)
+		if (datos[hash_nombre[i]].getNombre() == nombre)
+			return hash_nombre[i];
+	return -1;
+}
+
+bool Paises::Anadir(const Pais &pais) {
+	if (BuscarNombre(pais.getNombre()) != -1)
+		return false;
+
+	int pos = datos.size();
+	datos.push_back(pais);
+
+	// Mantenemos las tablas hash con, como mucho, la mitad de las casillas ocupadas
+	if (2 * datos.size() > hash_nombre.size()) {
+		size_t tam = 16;
+		while (tam < 2 * datos.size())
+			tam *= 2;
+		hash_nombre.assign(tam, -1);
+		hash_bandera.assign(tam, -1);
+		for (int i = 0; i < pos; i++) {
+			InsertarHash(hash_nombre, datos[i].getNombre(), i);
+			InsertarHash(hash_bandera, datos[i].getBandera(), i);
+		}
+	}
+	InsertarHash(hash_nombre, pais.getNombre(), pos);
+	InsertarHash(hash_bandera, pais.getBandera(), pos);
+
+	const Punto &p = pais.getPunto();
+	rejilla[Clave(Celda(p.getLatitud()), Celda(p.getLongitud()))].push_back(pos);
+	return true;
+}
+
+/**
+ * @brief Compara posiciones de un vector de paises por el nombre del pais
+ */
+class MenorNombre {
+private:
+	const vector<Pais> &datos;
+public:
+	MenorNombre(const vector<Pais> &d): datos(d) {}
+	bool operator()(int a, int b) const {return datos[a] < datos[b];}
+};
+
+void Paises::Ordenar() {
+	orden.resize(datos.size());
+	for (size_t i = 0; i < orden.size(); i++)
+		orden[i] = i;
+
+	// Si ya vienen ordenados (por ejemplo, de un fichero binario) no hace falta ordenar
+	if (!is_sorted(orden.begin(), orden.end(), MenorNombre(datos)))
+		sort(orden.begin(), orden.end(), MenorNombre(datos));
+
+	posicion.resize(orden.size());
+	for (size_t i = 0; i < orden.size(); i++)
+		posicion[orden[i]] = i;
+}
+
+void Paises::Reindexar() {
+	vector<Pais> aux;
+	aux.swap(datos);
+	clear();
+	datos.reserve(aux.size());
+	for (size_t i = 0; i < aux.size(); i++)
+		Anadir(aux[i]);
+	Ordenar();
+}
+
+bool Paises::LeerPais(const char *ini, const char *fin, Pais &pais) {
+	Lector lector(ini, fin);
+	lector.SaltarBlancos();
+	if (lector.Fin() || *lector.Posicion() == '#')
+		return false;  // Salta las líneas de comentarios o vacías
+
+	double latitud, longitud;
+	string nombre, bandera;
+	if (!lector.LeerDouble(latitud) || !lector.LeerDouble(longitud) ||
+		!lector.LeerPalabra(nombre) || !lector.LeerPalabra(bandera))
+		return false;
+
+	pais = Pais(move(nombre), move(bandera), Punto(latitud, longitud));
+	return true;
+}
+
+void Paises::Parsear(const char *ini, const char *fin) {
+	Pais pais;
+	while (ini < fin) {
+		const char *fin_linea = (const char *) memchr(ini, '\n', fin - ini);
+		if (fin_linea == 0)
+			fin_linea = fin;
+
+		if (LeerPais(ini, fin_linea, pais))
+			Anadir(pais);
+		ini = fin_linea + 1;
+	}
+}
+
+bool Paises::CargarFichero(const string &nombre) {
+	FicheroMapeado fichero;
+	if (!fichero.Abrir(nombre)) {
+		cerr << "Error de apertura del fichero " << nombre << endl;
+		return false;
+	}
+
+	if (EsBinario(fichero, MAGIA_BINARIA)) {
+		const char *cuerpo;
+		size_t tam;
+		bool correcto = AbrirBinario(fichero, MAGIA_BINARIA, cuerpo, tam) && LeerBinario(cuerpo, tam);
+		Ordenar();
+		if (!correcto)
+			cerr << "El fichero binario " << nombre << " está dañado o es de otra versión" << endl;
+		return correcto;
+	}
+
+	Parsear(fichero.begin(), fichero.end());
+	Ordenar();
+	return true;
+}
+
+bool Paises::GuardarBinario(const string &nombre) const {
+	vector<double> coordenadas;
+	vector<uint64_t> inicios(1, 0);
+	string cadenas;
+
+	for (iterator it = begin(); it != end(); ++it) {
+		const Pais &pais = *it;
+		coordenadas.push_back(pais.getPunto().getLatitud());
+		coordenadas.push_back(pais.getPunto().getLongitud());
+		cadenas += pais.getNombre();
+		inicios.push_back(cadenas.size());
+		cadenas += pais.getBandera();
+		inicios.push_back(cadenas.size());
+	}
+
+	uint64_t tamanos[2] = {datos.size(), cadenas.size()};
+	vector<char> cuerpo;
+	cuerpo.reserve(sizeof(tamanos) + 8 * (coordenadas.size() + inicios.size()) + cadenas.size());
+	AnadirBinario(cuerpo, tamanos, 2);
+	AnadirBinario(cuerpo, coordenadas);
+	AnadirBinario(cuerpo, inicios);
+	AnadirBinario(cuerpo, cadenas.data(), cadenas.size());
+
+	if (!GuardarFicheroBinario(nombre, MAGIA_BINARIA, cuerpo)) {
+		cerr << "Error de escritura del fichero " << nombre << endl;
+		return false;
+	}
+	return true;
+}
+
+bool Paises::LeerBinario(const char *cuerpo, size_t tam) {
+	if (tam < 2 * sizeof(uint64_t))
+		return false;
+
+	const uint64_t *tamanos = (const uint64_t *) cuerpo;
+	uint64_t num = tamanos[0], tam_cadenas = tamanos[1];
+	if (num > tam / 32 || tam_cadenas > tam || tam != 8 * (2 + 2 * num + 2 * num + 1) + tam_cadenas)
+		return false;
+
+	const double *coordenadas = (const double *) (tamanos + 2);
+	const uint64_t *inicios = (const uint64_t *) (coordenadas + 2 * num);
+	const char *cadenas = (const char *) (inicios + 2 * num + 1);
+
+	if (inicios[0] != 0 || inicios[2 * num] != tam_cadenas)
+		return false;
+	for (uint64_t i = 0; i < 2 * num; i++)
+		if (inicios[i] > inicios[i + 1])
+			return false;
+
+	datos.reserve(datos.size() + num);
+	for (uint64_t i = 0; i < num; i++) {
+		string nombre(cadenas + inicios[2 * i], cadenas + inicios[2 * i + 1]);
+		string bandera(cadenas + inicios[2 * i + 1], cadenas + inicios[2 * i + 2]);
+		Anadir(Pais(move(nombre), move(bandera), Punto(coordenadas[2 * i], coordenadas[2 * i + 1])));
+	}
+	return true;
+}
+
 Paises::Paises(const set<Pais> &paises) {
-	datos = paises;
+	for (set<Pais>::const_iterator it = paises.begin(); it != paises.end(); ++it)
+		Anadir(*it);
+	Ordenar();
 }
 
 int Paises::size() const {
 	return datos.size();
 }
 
-const set<Pais>& Paises::getDatos() const {
+const vector<Pais>& Paises::getDatos() const {
 	return datos;
 }
 
 void Paises::insertar(const Pais &pais) {
-	datos.insert(pais);
+	if (!Anadir(pais))
+		return;
+
+	// Colocamos el nuevo pais en su sitio del orden por nombre
+	int pos = datos.size() - 1;
+	vector<int>::iterator it = lower_bound(orden.begin(), orden.end(), pos, MenorNombre(datos));
+	it = orden.insert(it, pos);
+
+	posicion.resize(datos.size());
+	for (size_t i = it - orden.begin(); i < orden.size(); i++)
+		posicion[orden[i]] = i;
 }
 
 void Paises::eliminar(const Pais &pais) {
-	datos.erase(pais);
+	int pos = BuscarNombre(pais.getNombre());
+	if (pos != -1) {
+		// Ocupamos su hueco con el último, para que los datos sigan contiguos
+		datos[pos] = datos.back();
+		datos.pop_back();
+		Reindexar();
+	}
 }
 
 void Paises::clear() {
     datos.clear();
+    orden.clear();
+    posicion.clear();
+    hash_nombre.clear();
+    hash_bandera.clear();
+    rejilla.clear();
 }
 
 Paises::iterator Paises::find(const Pais &pais) const {
-	return datos.find(pais);
+	return findNombre(pais.getNombre());
+}
+
+Paises::iterator Paises::findNombre(const string &nombre) const {
+	int pos = BuscarNombre(nombre);
+	return pos == -1 ? end() : iterator(this, posicion[pos]);
+}
+
+Paises::iterator Paises::findBandera(const string &bandera) const {
+	if (hash_bandera.empty())
+		return end();
+
+	// Puede haber varios paises con la misma bandera: nos quedamos con el primero por nombre
+	int encontrado = -1;
+	size_t mascara = hash_bandera.size() - 1;
+	for (size_t i = Hash(bandera) & mascara; hash_bandera[i] != -1; i = (i + 1) & mascara) {
+		int pos = hash_bandera[i];
+		if (datos[pos].getBandera() == bandera && (encontrado == -1 || posicion[pos] < posicion[encontrado]))
+			encontrado = pos;
+	}
+	return encontrado == -1 ? end() : iterator(this, posicion[encontrado]);
 }
 
 Paises::iterator Paises::find(const Punto &punto) const {
-	Paises::iterator it;
-	for (it = this->begin(); it != this->end(); ++it) {
-		if ((*it).getPunto()==punto) {
-			return it;
+	// Celdas que pueden contener puntos iguales (con la tolerancia de Punto::operator==)
+	const double TOL = 1e-5;
+	int fmin = Celda(punto.getLatitud() - TOL), fmax = Celda(punto.getLatitud() + TOL);
+	int cmin = Celda(punto.getLongitud() - TOL), cmax = Celda(punto.getLongitud() + TOL);
+
+	// De entre los que coinciden, devolvemos el primero por nombre
+	int encontrado = -1;
+	for (int f = fmin; f <= fmax; f++)
+		for (int c = cmin; c <= cmax; c++) {
+			unordered_map<long long, vector<int> >::const_iterator celda = rejilla.find(Clave(f, c));
+			if (celda == rejilla.end())
+				continue;
+
+			const vector<int> &v = celda->second;
+			for (size_t k = 0; k < v.size(); k++)
+				if (datos[v[k]].getPunto() == punto && (encontrado == -1 || posicion[v[k]] < posicion[encontrado]))
+					encontrado = v[k];
+		}
+
+	return encontrado == -1 ? end() : iterator(this, posicion[encontrado]);
+}
+
+/**
+ * @brief Distancia al cuadrado, en grados, entre dos puntos del plano latitud/longitud
+ */
+static double distancia2(const Punto &p1, const Punto &p2) {
+	double dlat = p1.getLatitud() - p2.getLatitud();
+	double dlon = p1.getLongitud() - p2.getLongitud();
+	return dlat * dlat + dlon * dlon;
+}
+
+Paises::iterator Paises::masCercano(const Punto &punto) const {
+	int f0 = Celda(punto.getLatitud()), c0 = Celda(punto.getLongitud());
+	int max_anillo = (int) ceil(360 / TAM_CELDA) + 1;
+
+	int mejor = -1;
+	double mejor_d2 = 0;
+
+	// Recorremos anillos de celdas cada vez más alejados de la del punto. Cualquier país
+	// del anillo r está al menos a (r-1)*TAM_CELDA grados, así que podemos parar en cuanto
+	// esa cota supere la mejor distancia encontrada.
+	for (int r = 0; r <= max_anillo && !datos.empty(); r++) {
+		if (mejor != -1 && (r - 1) * TAM_CELDA * (r - 1) * TAM_CELDA > mejor_d2)
+			break;
+
+		for (int f = f0 - r; f <= f0 + r; f++) {
+			// En las filas intermedias sólo están en el anillo las columnas de los extremos
+			int paso = (f == f0 - r || f == f0 + r) ? 1 : max(2 * r, 1);
+			for (int c = c0 - r; c <= c0 + r; c += paso) {
+				unordered_map<long long, vector<int> >::const_iterator celda = rejilla.find(Clave(f, c));
+				if (celda == rejilla.end())
+					continue;
+
+				const vector<int> &v = celda->second;
+				for (size_t k = 0; k < v.size(); k++) {
+					double d2 = distancia2(datos[v[k]].getPunto(), punto);
+					if (mejor == -1 || d2 < mejor_d2 || (d2 == mejor_d2 && posicion[v[k]] < posicion[mejor])) {
+						mejor = v[k];
+						mejor_d2 = d2;
+					}
+				}
+			}
 		}
 	}
-	return this->end();
+
+	return mejor == -1 ? end() : iterator(this, posicion[mejor]);
+}
+
+vector<Paises::iterator> Paises::enRadio(const Punto &punto, double radio) const {
+	vector<int> encontrados;
+
+	// No hace falta mirar fuera del rango de coordenadas válidas
+	int fmin = Celda(max(punto.getLatitud() - radio, -90.0)), fmax = Celda(min(punto.getLatitud() + radio, 90.0));
+	int cmin = Celda(max(punto.getLongitud() - radio, -180.0)), cmax = Celda(min(punto.getLongitud() + radio, 180.0));
+
+	for (int f = fmin; f <= fmax; f++)
+		for (int c = cmin; c <= cmax; c++) {
+			unordered_map<long long, vector<int> >::const_iterator celda = rejilla.find(Clave(f, c));
+			if (celda == rejilla.end())
+				continue;
+
+			const vector<int> &v = celda->second;
+			for (size_t k = 0; k < v.size(); k++)
+				if (distancia2(datos[v[k]].getPunto(), punto) <= radio * radio)
+					encontrados.push_back(posicion[v[k]]);
+		}
+
+	// Las posiciones en el orden por nombre ya dan el orden del resultado
+	sort(encontrados.begin(), encontrados.end());
+	vector<iterator> resultado;
+	for (size_t i = 0; i < encontrados.size(); i++)
+		resultado.push_back(iterator(this, encontrados[i]));
+	return resultado;
 }
 
 
@@ -66,27 +409,16 @@ ostream &operator<<(ostream &os, const Paises &paises) {
 }
 
 istream& operator>>(istream& is, Paises& paises) {
-    double longitud, latitud;
-    string nombre, bandera;
-
     // Leer una línea del archivo
     string line;
+    Pais pais;
     while (getline(is, line)) {
-        if (line.empty() || line[0] == '#') {
-            continue;  // Salta las líneas de comentarios o vacías
-        }
-
-        // Utilizar un stringstream para extraer campos
-        istringstream iss(line);
-        // Leer los campos uno por uno
-        iss >> latitud >> longitud >> nombre >> bandera;
-
-        // Creamos un objeto Pais y lo añadimos al conjunto
-        // de paises
-        Punto point(latitud, longitud);
-        Pais pais(nombre, bandera, point);
-        paises.insertar(pais);
+        // Extraemos los campos directamente de la línea y lo añadimos al conjunto
+        if (Paises::LeerPais(line.data(), line.data() + line.size(), pais))
+            paises.Anadir(pais);
     }
+
+    // Ordenamos una sola vez, al final de la carga
+    paises.Ordenar();
     return is;
 }
-
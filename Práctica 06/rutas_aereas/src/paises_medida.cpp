@@ -0,0 +1,193 @@
+/**
+ * @file paises_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de la carga y las búsquedas en Paises
+ *
+ * Genera un conjunto de paises aleatorios y compara el tiempo de buscar un punto recorriendo
+ * todos los paises con el de Paises::find(const Punto&), que usa el índice espacial.
+ * También mide Paises::masCercano() y Paises::enRadio().
+ *
+ * Además compara la carga y las búsquedas por nombre y por bandera con las de un set<Pais>,
+ * que es como se almacenaban antes los paises.
+ *
+ * @param NumeroDePaises Número de paises a generar. Opcional, por defecto 100000.
+ * @param NumeroDeConsultas Número de búsquedas de cada tipo. Opcional, por defecto 1000.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./paises_medida 100000 1000
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <set>
+#include <sstream>
+#include "paises.h"
+
+using namespace std;
+
+/**
+ * @brief Busca un punto recorriendo todos los paises, como hacía Paises::find(const Punto&)
+ * @param paises Paises en los que buscar
+ * @param punto Punto a buscar
+ * @return Iterador al pais encontrado o end()
+ */
+Paises::iterator BuscarLineal(const Paises &paises, const Punto &punto) {
+	Paises::iterator it;
+	for (it = paises.begin(); it != paises.end(); ++it)
+		if ((*it).getPunto() == punto)
+			return it;
+	return paises.end();
+}
+
+/**
+ * @brief Lee unos paises sobre un set<Pais>, como hacía antes operator>>
+ * @param is Flujo de entrada
+ * @param paises Conjunto donde se añaden los paises
+ */
+void LeerSet(istream &is, set<Pais> &paises) {
+	double latitud, longitud;
+	string nombre, bandera, line;
+	while (getline(is, line)) {
+		if (line.empty() || line[0] == '#')
+			continue;
+		istringstream iss(line);
+		iss >> latitud >> longitud >> nombre >> bandera;
+		paises.insert(Pais(nombre, bandera, Punto(latitud, longitud)));
+	}
+}
+
+/**
+ * @brief Busca una bandera recorriendo todo un set<Pais>
+ * @param paises Conjunto en el que buscar
+ * @param bandera Bandera a buscar
+ * @return Iterador al pais encontrado o end()
+ */
+set<Pais>::const_iterator BuscarBanderaSet(const set<Pais> &paises, const string &bandera) {
+	set<Pais>::const_iterator it;
+	for (it = paises.begin(); it != paises.end(); ++it)
+		if (it->getBandera() == bandera)
+			return it;
+	return paises.end();
+}
+
+int main (int argc, char* argv[]) {
+	int npaises = (argc > 1) ? atoi(argv[1]) : 100000;
+	int nconsultas = (argc > 2) ? atoi(argv[2]) : 1000;
+
+	if (argc > 3 || npaises <= 0 || nconsultas <= 0) {
+		cerr << "Uso: paises_medida [NumeroDePaises] [NumeroDeConsultas]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	ostringstream fichero;
+	vector<Punto> puntos;
+	vector<string> nombres;
+	for (int i = 0; i < npaises; i++) {
+		Punto p(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180);
+		string nombre = "Pais" + to_string(rand()) + "_" + to_string(i);
+		fichero << p.getLatitud() << " " << p.getLongitud() << " " << nombre << " " << nombre << ".ppm" << endl;
+		nombres.push_back(nombre);
+	}
+
+	// Carga con set<Pais> y con Paises, desde el mismo texto
+	istringstream entrada_set(fichero.str());
+	clock_t tini = clock();
+	set<Pais> conjunto;
+	LeerSet(entrada_set, conjunto);
+	clock_t tfin = clock();
+	double t_carga_set = (tfin - tini) / (double) CLOCKS_PER_SEC;
+
+	istringstream entrada(fichero.str());
+	tini = clock();
+	Paises paises;
+	entrada >> paises;
+	tfin = clock();
+	double t_carga = (tfin - tini) / (double) CLOCKS_PER_SEC;
+
+	// Los puntos a buscar son los que se han leído, que pueden diferir algo de los generados
+	const vector<Pais> &datos = paises.getDatos();
+	for (size_t i = 0; i < datos.size(); i++)
+		puntos.push_back(datos[i].getPunto());
+
+	// Búsquedas por nombre y por bandera
+	int por_nombre = 0, por_bandera = 0;
+	tini = clock();
+	for (int i = 0; i < nconsultas; i++)
+		if (conjunto.find(Pais(nombres[rand() % npaises], "", Punto())) != conjunto.end())
+			por_nombre++;
+	tfin = clock();
+	double t_nombre_set = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	tini = clock();
+	for (int i = 0; i < nconsultas; i++)
+		if (paises.findNombre(nombres[rand() % npaises]) != paises.end())
+			por_nombre++;
+	tfin = clock();
+	double t_nombre = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	tini = clock();
+	for (int i = 0; i < nconsultas; i++)
+		if (BuscarBanderaSet(conjunto, nombres[rand() % npaises] + ".ppm") != conjunto.end())
+			por_bandera++;
+	tfin = clock();
+	double t_bandera_set = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	tini = clock();
+	for (int i = 0; i < nconsultas; i++)
+		if (paises.findBandera(nombres[rand() % npaises] + ".ppm") != paises.end())
+			por_bandera++;
+	tfin = clock();
+	double t_bandera = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	// Buscamos puntos existentes
+	tini = clock();
+	int encontrados = 0;
+	for (int i = 0; i < nconsultas; i++)
+		if (BuscarLineal(paises, puntos[rand() % npaises]) != paises.end())
+			encontrados++;
+	tfin = clock();
+	double t_lineal = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	tini = clock();
+	for (int i = 0; i < nconsultas; i++)
+		if (paises.find(puntos[rand() % npaises]) != paises.end())
+			encontrados++;
+	tfin = clock();
+	double t_indice = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	// Vecino más cercano y búsqueda por radio en puntos aleatorios
+	tini = clock();
+	for (int i = 0; i < nconsultas; i++)
+		paises.masCercano(Punto(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180));
+	tfin = clock();
+	double t_cercano = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	tini = clock();
+	size_t en_radio = 0;
+	for (int i = 0; i < nconsultas; i++)
+		en_radio += paises.enRadio(Punto(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180), 2).size();
+	tfin = clock();
+	double t_radio = (tfin - tini) / (double) CLOCKS_PER_SEC / nconsultas;
+
+	// Mostramos resultados (segundos totales para la carga, por consulta para el resto)
+	cout << "Paises: " << npaises << ", consultas: " << nconsultas << ", encontrados: " << encontrados << endl;
+	cout << "carga set:\t" << t_carga_set << endl;
+	cout << "carga Paises:\t" << t_carga << endl;
+	cout << "nombre set:\t" << t_nombre_set << " (" << por_nombre << " encontrados)" << endl;
+	cout << "nombre hash:\t" << t_nombre << endl;
+	cout << "bandera set:\t" << t_bandera_set << " (" << por_bandera << " encontrados)" << endl;
+	cout << "bandera hash:\t" << t_bandera << endl;
+	cout << "find lineal:\t" << t_lineal << endl;
+	cout << "find indice:\t" << t_indice << endl;
+	cout << "masCercano:\t" << t_cercano << endl;
+	cout << "enRadio(2):\t" << t_radio << " (" << en_radio / (double) nconsultas << " paises de media)" << endl;
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file pintorRutas.cpp
+ * @brief Fichero de implementación del TDA PintorRutas
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "pintorRutas.h"
+
+PintorRutas::PintorRutas(const Paises &paises, const string &dir_banderas, const Imagen &avion)
+	: paises(paises), avion(avion), dir_banderas(dir_banderas) {
+	Pixel rojo = {200, 0, 0, 255};
+	color_arcos = rojo;
+}
+
+void PintorRutas::PrecargarBanderas(const AlmacenRutas &almacen) {
+	AlmacenRutas::const_iterator it_a;
+	for (it_a = almacen.begin(); it_a != almacen.end(); ++it_a) {
+		Ruta::const_iterator it_r;
+		for (it_r = (*it_a).begin(); it_r != (*it_a).end(); ++it_r) {
+			Paises::iterator pos = paises.find(*it_r);
+			if (pos != paises.end() && banderas.find((*pos).getBandera()) == banderas.end()) {
+				string nombre_bandera = dir_banderas + "/" + (*pos).getBandera();
+				banderas[(*pos).getBandera()].LeerImagen(nombre_bandera.c_str());
+			}
+		}
+	}
+}
+
+const Imagen & PintorRutas::Bandera(const Pais &pais, Imagen &aux) const {
+	map<string, Imagen>::const_iterator it = banderas.find(pais.getBandera());
+	if (it != banderas.end())
+		return it->second;
+
+	string nombre_bandera = dir_banderas + "/" + pais.getBandera();
+	aux.LeerImagen(nombre_bandera.c_str());
+	return aux;
+}
+
+template <class Lienzo>
+void PintorRutas::Pegar(Lienzo &mapa, int i, int j, const Imagen &img, Tipo_Pegado tp, vector<Region> *regiones) {
+	mapa.PutImagen(i, j, img, tp);
+	if (regiones != 0) {
+		Region reg = {i, j, img.getFilas(), img.getColumnas()};
+		regiones->push_back(reg);
+	}
+}
+
+template <class Lienzo>
+bool PintorRutas::Pintar(const Ruta &ruta, Lienzo &mapa, ostream *os, vector<Region> *regiones) const {
+	Ruta::const_iterator it_r = ruta.begin();
+	Punto point1, point2;
+	pair<int,int> coord_point1, coord_point2, coord_point_midpoint;
+	double orientation_angle;
+	Imagen avion_rotado;
+	Imagen aux;
+
+	// Dibujo los arcos de todos los tramos, que quedan por debajo de banderas y aviones
+	if (color_arcos.transp != 0) {
+		LoteArcos arcos;
+		arcos.Anadir(ruta);
+		arcos.Dibujar(mapa, color_arcos, TRAMOS_ARCO, 1, regiones);
+	}
+
+	while (it_r != ruta.end()) {
+		point1 = *it_r;
+		coord_point1 = point1.coordenadasMapa(mapa.getColumnas(), mapa.getFilas());
+
+		// Extraigo país
+		Paises::iterator pos_pais_point1 = paises.find(point1);
+		if (pos_pais_point1 == paises.end()) {
+			if (os != 0)
+				*os << "No pudo encontrarse el pais que tiene como punto " << point1 << endl;
+			return false;
+		}
+		const Pais &pais = *pos_pais_point1;
+
+		// Pongo bandera en el mapa
+		Pegar(mapa, coord_point1.first, coord_point1.second, Bandera(pais, aux), BLENDING, regiones);
+		// Imprimo el nombre del país
+		if (os != 0)
+			*os << pais.getNombre() << " ";
+
+		// Leo siguiente punto
+		++it_r;
+		if (it_r != ruta.end()) {
+			point2 = *it_r;
+			coord_point2 = point2.coordenadasMapa(mapa.getColumnas(), mapa.getFilas());
+			coord_point_midpoint = point1.punto_medio_en_mapa(point2, mapa.getColumnas(), mapa.getFilas());
+			orientation_angle = point1.angulo_en_mapa(point2, mapa.getColumnas(), mapa.getFilas());
+
+			// Pego los 3 aviones correspondientes
+			avion_rotado = avion.Rota(orientation_angle);
+			Pegar(mapa, coord_point_midpoint.first, coord_point_midpoint.second, avion_rotado, OPACO, regiones);
+			Pegar(mapa, coord_point1.first, coord_point1.second, avion_rotado, OPACO, regiones);
+			Pegar(mapa, coord_point2.first, coord_point2.second, avion_rotado, OPACO, regiones);
+		} // if (it_r != ruta.end())
+	} // while (it_r != ruta.end())
+
+	return true;
+}
+
+template bool PintorRutas::Pintar<Imagen>(const Ruta &, Imagen &, ostream *, vector<Region> *) const;
+template bool PintorRutas::Pintar<MapaTeselado>(const Ruta &, MapaTeselado &, ostream *, vector<Region> *) const;
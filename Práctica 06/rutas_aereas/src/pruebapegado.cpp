@@ -12,15 +12,7 @@
  * @param img_salida Nombre de la imagen de salida, con la imagen pegada.
  * @param fil Fila donde se va a pegar la imagen.
  * @param col Columna donde se va a pegar la imagen.
- * @param TipoPegado Tipo de pegado. 0: Opaco 1: Blending
- *
- * // Ambos positivos
- * @pre 0<=@a fil
- * @pre 0<=@a col
- *
- * // Que quepa en la imagen
- * @pre fil+img_pegar.getFilas()<=img_fondo.getFilas()
- * @pre col+img_pegar.getColumnas()<=img_fondo.getColumnas()
+ * @param TipoPegado Tipo de pegado. 0: Opaco 1: Blending 2: Sobre 3: Aditivo 4: Multiplicativo
  *
  * // Que la máscara sea válida
  * @pre img_pegar.getFilas()==mascara.getFilas()
@@ -32,6 +24,18 @@
  * pruebapegado fondo.ppm pegar.ppm mascara.pgm salida.ppm 10 10 0
  * @endcode
  *
+ * Si se llama con el único argumento @c -medida, mide el tiempo de Imagen::PutImagen()
+ * con cada tipo de pegado:
+ * @code{.sh}
+ * pruebapegado -medida
+ * @endcode
+ *
+ * Con el único argumento @c -prueba, comprueba el pegado SOBRE con fondos no opacos comparándolo
+ * con la composición "over" calculada en coma flotante, y termina con 0 si no hay errores:
+ * @code{.sh}
+ * pruebapegado -prueba
+ * @endcode
+ *
  * Este ejemplo muestra cómo utilizar el ejecutable **pruebarotacion** para rotar una imagen dada.
  *
  * <div style="text-align: center;">
@@ -59,12 +63,107 @@
 #include "imagen.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cmath>
 
 using namespace std;
 
+/**
+ * @brief Mide el tiempo de pegar una imagen con cada uno de los tipos de pegado
+ *
+ * Pega repetidamente una imagen de 512x512 con transparencia variable sobre un fondo
+ * de 1024x1024, parcialmente fuera de él, y muestra los megapíxeles por segundo de cada tipo.
+ */
+void Medir(){
+	const char *NOMBRES[] = {"OPACO", "BLENDING", "SOBRE", "ADITIVO", "MULTIPLICATIVO"};
+	const int NREPS = 200;
+
+	Imagen fondo(1024, 1024), pegar(512, 512);
+	for (int i = 0; i < pegar.getFilas(); i++)
+		for (int j = 0; j < pegar.getColumnas(); j++) {
+			pegar(i, j).r = i;
+			pegar(i, j).g = j;
+			pegar(i, j).b = i ^ j;
+			pegar(i, j).transp = i + j;
+		}
 
+	cout << "Tipo\tSegundos\tMpix/s" << endl;
+	for (int t = OPACO; t <= MULTIPLICATIVO; t++) {
+		clock_t tini = clock();
+		for (int n = 0; n < NREPS; n++)
+			fondo.PutImagen(n % 700 - 100, n % 600, pegar, (Tipo_Pegado) t);
+		clock_t tfin = clock();
+
+		double segundos = (tfin - tini) / (double) CLOCKS_PER_SEC;
+		cout << NOMBRES[t] << "\t" << segundos << "\t"
+			 << NREPS * 512.0 * 512.0 / 1e6 / segundos << endl;
+	}
+}
+
+/**
+ * @brief Comprueba el pegado SOBRE sobre fondos con cualquier transparencia
+ *
+ * Pega una imagen con colores y transparencias aleatorias sobre un fondo también aleatorio, en el
+ * que una de cada cuatro filas es totalmente transparente, y compara cada píxel con la composición
+ * "over" de colores sin premultiplicar calculada en coma flotante, admitiendo una unidad de error.
+ * Comprueba además que el rojo semitransparente sobre azul transparente sigue siendo rojo.
+ *
+ * @return Número de errores
+ */
+int Probar(){
+	const int N = 64;
+	Imagen fondo(N, N), pegar(N, N);
+	srand(1);
+	for (int i = 0; i < N; i++)
+		for (int j = 0; j < N; j++) {
+			Pixel &f = fondo(i, j), &p = pegar(i, j);
+			f.r = rand() % 256; f.g = rand() % 256; f.b = rand() % 256;
+			f.transp = (i % 4 == 0) ? 0 : rand() % 256;
+			p.r = rand() % 256; p.g = rand() % 256; p.b = rand() % 256;
+			p.transp = rand() % 256;
+		}
+	Imagen resultado = fondo;
+	resultado.PutImagen(0, 0, pegar, SOBRE);
+
+	int comprobaciones = 0, errores = 0;
+	for (int i = 0; i < N; i++)
+		for (int j = 0; j < N; j++) {
+			const Pixel &f = fondo(i, j), &p = pegar(i, j), &r = resultado(i, j);
+			double as = p.transp / 255.0, ad = f.transp / 255.0, ao = as + ad * (1 - as);
+			double esperado[4] = {(double) f.r, (double) f.g, (double) f.b, ao * 255};
+			if (as > 0) {
+				esperado[0] = (p.r * as + f.r * ad * (1 - as)) / ao;
+				esperado[1] = (p.g * as + f.g * ad * (1 - as)) / ao;
+				esperado[2] = (p.b * as + f.b * ad * (1 - as)) / ao;
+			}
+			double obtenido[4] = {(double) r.r, (double) r.g, (double) r.b, (double) r.transp};
+			for (int k = 0; k < 4; k++)
+				errores += fabs(obtenido[k] - esperado[k]) > 1;
+			comprobaciones += 4;
+		}
+
+	Imagen azul(1, 1), rojo(1, 1);
+	Pixel p_azul = {0, 0, 255, 0}, p_rojo = {255, 0, 0, 128};
+	azul(0, 0) = p_azul;
+	rojo(0, 0) = p_rojo;
+	azul.PutImagen(0, 0, rojo, SOBRE);
+	const Pixel &r = azul(0, 0);
+	errores += r.r != 255 || r.g != 0 || r.b != 0 || r.transp != 128;
+	comprobaciones++;
+
+	cout << "Comprobaciones: " << comprobaciones << ", errores: " << errores << endl;
+	return errores;
+}
 
 int main(int argc, char * argv[]){
+	if (argc == 2 && strcmp(argv[1], "-medida") == 0){
+		Medir();
+		return 0;
+	}
+	if (argc == 2 && strcmp(argv[1], "-prueba") == 0)
+		return Probar() == 0 ? 0 : 1;
+
 	if (argc!=8){
 		cout<<"Los parametros son :"<<endl;
 		cout<<"1 - La imagen de fondo"<<endl;
@@ -73,8 +172,10 @@ int main(int argc, char * argv[]){
 		cout<<"4 - El nombre de la imagen de salida"<<endl;
 		cout<<"5 - La fila donde pegar"<<endl;
 		cout<<"6 - La columna donde pegar"<<endl;
-		cout<<"7 - 0: Pegado Opaco 1: Pegado Blending"<<endl;
+		cout<<"7 - 0: Pegado Opaco 1: Pegado Blending 2: Sobre 3: Aditivo 4: Multiplicativo"<<endl;
 		cout << "Uso: " << argv[0] << " <img_fondo> <img_pegar> <mascara> <img_salida> <fil> <col> <TipoPegado>" << endl;
+		cout << "     " << argv[0] << " -medida" << endl;
+		cout << "     " << argv[0] << " -prueba" << endl;
 		return -1;
 	}
 	Imagen I,Ip;
@@ -84,14 +185,12 @@ int main(int argc, char * argv[]){
 	int i,j;    // Pasamos fila y columnas a enteros
 	i=atoi(argv[5]); j=atoi(argv[6]);
 
-	Tipo_Pegado tp; //variable de tipo Tipo_Pegado que es un enumerado con los valores OPACO y BLENDING
 	int au= atoi(argv[7]);
-	if (au==0) tp=OPACO;
-	else if (au==1) tp=BLENDING;
-	else {
-		cout<<"El valor de pegado debe ser 0 o 1"<<endl;
+	if (au<OPACO || au>MULTIPLICATIVO) {
+		cout<<"El valor de pegado debe estar entre 0 y 4"<<endl;
 		return -1;
 	}
+	Tipo_Pegado tp = (Tipo_Pegado) au; //variable de tipo Tipo_Pegado que es un enumerado
 
 	// Pegamos la imagen
 	I.PutImagen(i,j,Ip,tp);
@@ -100,4 +199,4 @@ int main(int argc, char * argv[]){
 	I.EscribirImagen(argv[4]);
 
 	return 0;
-}  
\ No newline at end of file
+}
@@ -10,6 +10,7 @@
  * @param img_entrada Nombre de la imagen de entrada, a rotar.
  * @param angulo_grados Ángulo de rotación en grados.
  * @param img_salida Nombre de la imagen de salida, rotada.
+ * @param interpolacion Tipo de interpolación. 0: Vecino más cercano 1: Bilineal. Opcional, por defecto 0.
  *
  * Un ejemplo de ejecución es:
  * Ejemplo de uso:
@@ -17,6 +18,12 @@
  * pruebarotacion avion.ppm 45 avion_45.ppm
  * @endcode
  *
+ * Si se llama con el único argumento @c -medida, compara el tiempo de Imagen::Rota_noeff()
+ * con el de Imagen::Rota() (con ambos tipos de interpolación) para varios tamaños y ángulos:
+ * @code{.sh}
+ * pruebarotacion -medida
+ * @endcode
+ *
  * Este ejemplo muestra cómo utilizar el ejecutable **pruebarotacion** para rotar una imagen dada.
  *
  * <div style="text-align: center;">
@@ -37,26 +44,89 @@
 #include "imagen.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
+#include <ctime>
 using namespace std;
 
+/**
+ * @brief Mide el tiempo medio de rotar una imagen con cada uno de los métodos
+ *
+ * Muestra una línea por cada tamaño y ángulo con los segundos por rotación de
+ * Imagen::Rota_noeff(), Imagen::Rota() con VECINO e Imagen::Rota() con BILINEAL.
+ */
+void Medir(){
+	const int TAMS[] = {64, 256, 1024};
+	const double ANGULOS[] = {15, 45, 90, 135};
+
+	cout << "Tamaño\tÁngulo\tRota_noeff\tRota(VECINO)\tRota(BILINEAL)" << endl;
+	for (int t = 0; t < 3; t++) {
+		// Imagen con un degradado para que no sea uniforme
+		Imagen I(TAMS[t], TAMS[t]);
+		for (int i = 0; i < I.getFilas(); i++)
+			for (int j = 0; j < I.getColumnas(); j++) {
+				I(i, j).r = i;
+				I(i, j).g = j;
+				I(i, j).b = i + j;
+			}
+
+		// Repetimos más veces las imágenes pequeñas para que los tiempos sean medibles
+		int nreps = (1024 / TAMS[t]) * (1024 / TAMS[t]);
+
+		for (int a = 0; a < 4; a++) {
+			double rads = ANGULOS[a] * M_PI / 180;
+			double tiempos[3];
+
+			for (int m = 0; m < 3; m++) {
+				clock_t tini = clock();
+				for (int n = 0; n < nreps; n++) {
+					if (m == 0) I.Rota_noeff(rads);
+					else if (m == 1) I.Rota(rads, VECINO);
+					else I.Rota(rads, BILINEAL);
+				}
+				clock_t tfin = clock();
+				tiempos[m] = (tfin - tini) / (double) CLOCKS_PER_SEC / nreps;
+			}
+
+			cout << TAMS[t] << "\t" << ANGULOS[a] << "\t" << tiempos[0] << "\t"
+				 << tiempos[1] << "\t" << tiempos[2] << endl;
+		}
+	}
+}
 
 int main(int argc, char * argv[]){
 
-	if (argc!=4){
+	if (argc == 2 && strcmp(argv[1], "-medida") == 0){
+		Medir();
+		return 0;
+	}
+
+	if (argc!=4 && argc!=5){
 		cout<<"Los parametros son :"<<endl;
 		cout<<"1 - La imagen de entrada"<<endl;
 		cout<<"2 - El angulo de rotación en grados"<<endl;
 		cout<<"3 - El nombre de la imagen de salida"<<endl;
-		cout << "Uso: " << argv[0] << " <img_entrada> <angulo_grados> <img_salida>" << endl;
+		cout<<"4 - 0: Interpolación vecino más cercano 1: Interpolación bilineal (opcional)"<<endl;
+		cout << "Uso: " << argv[0] << " <img_entrada> <angulo_grados> <img_salida> [interpolacion]" << endl;
+		cout << "     " << argv[0] << " -medida" << endl;
 		return -1;
 	}
 
+	Tipo_Interpolacion ti = VECINO;
+	if (argc == 5){
+		int au = atoi(argv[4]);
+		if (au == 1) ti = BILINEAL;
+		else if (au != 0){
+			cout<<"El valor de interpolación debe ser 0 o 1"<<endl;
+			return -1;
+		}
+	}
+
 	Imagen I;
 	I.LeerImagen(argv[1]);
 
 	double angulo=atof(argv[2]);
 	angulo = angulo*(M_PI)/180;
-	Imagen Iout=I.Rota(angulo);
+	Imagen Iout=I.Rota(angulo, ti);
 	Iout.EscribirImagen(argv[3]);
-}
\ No newline at end of file
+}
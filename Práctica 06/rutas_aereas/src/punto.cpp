@@ -12,14 +12,6 @@ Punto::Punto(): latitud(0), longitud(0){}
 
 Punto::Punto(double lat, double lon): latitud(lat), longitud(lon){}
 
-double Punto::getLatitud() const{
-	return latitud;
-}
-
-double Punto::getLongitud() const{
-	return longitud;
-}
-
 void Punto::setLatitud(double lat){
 	latitud = lat;
 }
@@ -72,3 +64,42 @@ double Punto::angulo_en_mapa(const Punto & p, int num_columnas, int num_filas) c
 	if (p2.second < p1.second) angle += M_PI;
     return angle;
 }
+
+double Punto::distancia(const Punto &p) const {
+	double lat1 = latitud * M_PI / 180, lat2 = p.latitud * M_PI / 180;
+	double s_lat = sin((lat2 - lat1) / 2);
+	double s_lon = sin((p.longitud - longitud) * M_PI / 360);
+	double h = s_lat * s_lat + cos(lat1) * cos(lat2) * s_lon * s_lon;
+	return 2 * RADIO_TIERRA * asin(sqrt(min(h, 1.0)));
+}
+
+double Punto::rumbo(const Punto &p) const {
+	double lat1 = latitud * M_PI / 180, lat2 = p.latitud * M_PI / 180;
+	double dlon = (p.longitud - longitud) * M_PI / 180;
+	double y = sin(dlon) * cos(lat2);
+	double x = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(dlon);
+	double grados = atan2(y, x) * 180 / M_PI;
+	return grados < 0 ? grados + 360 : grados;
+}
+
+Punto Punto::puntoIntermedio(const Punto &p, double fraccion) const {
+	double lat1 = latitud * M_PI / 180, lat2 = p.latitud * M_PI / 180;
+	double lon1 = longitud * M_PI / 180, lon2 = p.longitud * M_PI / 180;
+	double d = distancia(p) / RADIO_TIERRA;
+
+	// Interpolación esférica entre los vectores unitarios de los dos puntos
+	double a, b;
+	if (sin(d) < 1e-12) {
+		a = 1 - fraccion;
+		b = fraccion;
+	}
+	else {
+		a = sin((1 - fraccion) * d) / sin(d);
+		b = sin(fraccion * d) / sin(d);
+	}
+	double x = a * cos(lat1) * cos(lon1) + b * cos(lat2) * cos(lon2);
+	double y = a * cos(lat1) * sin(lon1) + b * cos(lat2) * sin(lon2);
+	double z = a * sin(lat1) + b * sin(lat2);
+
+	return Punto(atan2(z, sqrt(x * x + y * y)) * 180 / M_PI, atan2(y, x) * 180 / M_PI);
+}
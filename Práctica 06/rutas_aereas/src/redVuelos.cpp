@@ -0,0 +1,255 @@
+/**
+ * @file redVuelos.cpp
+ * @brief Fichero de implementación del TDA RedVuelos
+ *
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include "redVuelos.h"
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+const double RedVuelos::TAM_CELDA = 1e-4;
+
+long long RedVuelos::Celda(double lat, double lon) {
+	long long fila = (long long) floor(lat / TAM_CELDA), columna = (long long) floor(lon / TAM_CELDA);
+	return (fila << 32) ^ (unsigned int) columna;
+}
+
+RedVuelos::RedVuelos(const AlmacenRutas &almacen) {
+	Construir(almacen);
+}
+
+int RedVuelos::buscarNodo(const Punto &p) const {
+	// Celdas que pueden contener puntos iguales (con la tolerancia de Punto::operator==)
+	const double TOL = 1e-5;
+	double lat = p.getLatitud(), lon = p.getLongitud();
+	long long claves[4] = {Celda(lat - TOL, lon - TOL), Celda(lat - TOL, lon + TOL),
+						   Celda(lat + TOL, lon - TOL), Celda(lat + TOL, lon + TOL)};
+
+	for (int c = 0; c < 4; c++) {
+		unordered_map<long long, vector<int> >::const_iterator celda = celdas.find(claves[c]);
+		if (celda == celdas.end())
+			continue;
+		for (size_t k = 0; k < celda->second.size(); k++)
+			if (puntos[celda->second[k]] == p)
+				return celda->second[k];
+	}
+	return -1;
+}
+
+int RedVuelos::Internar(const Punto &p) {
+	int nodo = buscarNodo(p);
+	if (nodo == -1) {
+		nodo = puntos.size();
+		puntos.push_back(p);
+		celdas[Celda(p.getLatitud(), p.getLongitud())].push_back(nodo);
+	}
+	return nodo;
+}
+
+void RedVuelos::Construir(const AlmacenRutas &almacen) {
+	puntos.clear();
+	celdas.clear();
+
+	// Nodos y aristas (repetidas) de cada par de puntos consecutivos de las rutas
+	vector<pair<int,int> > aristas;
+	for (AlmacenRutas::const_iterator it = almacen.begin(); it != almacen.end(); ++it) {
+		const vector<Punto> &ruta = (*it).getPuntos();
+		int anterior = -1;
+		for (size_t i = 0; i < ruta.size(); i++) {
+			int nodo = Internar(ruta[i]);
+			if (anterior != -1 && anterior != nodo)
+				aristas.push_back(pair<int,int>(anterior, nodo));
+			anterior = nodo;
+		}
+	}
+	sort(aristas.begin(), aristas.end());
+	aristas.erase(unique(aristas.begin(), aristas.end()), aristas.end());
+
+	// Datos precalculados para las distancias
+	int n = puntos.size();
+	lat_rad.resize(n);
+	lon_rad.resize(n);
+	cos_lat.resize(n);
+	for (int i = 0; i < n; i++) {
+		lat_rad[i] = puntos[i].getLatitud() * M_PI / 180;
+		lon_rad[i] = puntos[i].getLongitud() * M_PI / 180;
+		cos_lat[i] = cos(lat_rad[i]);
+	}
+
+	// Formato CSR: las aristas ya están ordenadas por origen
+	inicio.assign(n + 1, 0);
+	destino.resize(aristas.size());
+	peso.resize(aristas.size());
+	for (size_t e = 0; e < aristas.size(); e++) {
+		inicio[aristas[e].first + 1]++;
+		destino[e] = aristas[e].second;
+		peso[e] = Distancia(aristas[e].first, aristas[e].second);
+	}
+	for (int i = 0; i < n; i++)
+		inicio[i + 1] += inicio[i];
+}
+
+double RedVuelos::Distancia(int a, int b) const {
+	double s_lat = sin((lat_rad[b] - lat_rad[a]) / 2);
+	double s_lon = sin((lon_rad[b] - lon_rad[a]) / 2);
+	double h = s_lat * s_lat + cos_lat[a] * cos_lat[b] * s_lon * s_lon;
+	return 2 * RADIO_TIERRA * asin(sqrt(min(h, 1.0)));
+}
+
+/**
+ * @brief Memoria de trabajo de una búsqueda, que cada hilo reutiliza entre búsquedas
+ *
+ * En lugar de reinicializar las distancias en cada búsqueda, cada nodo guarda la marca de la
+ * última búsqueda en la que se alcanzó; si no coincide con la actual, el nodo no se ha alcanzado.
+ */
+struct MemoriaBusqueda {
+	vector<double> dist;
+	vector<int> previo;
+	vector<unsigned> marca;
+	vector<unsigned> cerrado;
+	unsigned actual;
+
+	MemoriaBusqueda(): actual(0) {}
+
+	void Preparar(int n) {
+		if ((int) dist.size() != n || actual == ~0u) {
+			dist.assign(n, 0);
+			previo.assign(n, -1);
+			marca.assign(n, 0);
+			cerrado.assign(n, 0);
+			actual = 0;
+		}
+		actual++;
+	}
+};
+
+double RedVuelos::Buscar(int origen, int destino, bool heuristica, vector<int> *camino) const {
+	static thread_local MemoriaBusqueda mem;
+	mem.Preparar(numNodos());
+
+	// Cola de prioridad de (distancia + heurística, nodo). Como la heurística es consistente (cumple la
+	// desigualdad triangular), un nodo no mejora tras expandirlo: sus entradas posteriores se descartan
+	typedef pair<double,int> Entrada;
+	priority_queue<Entrada, vector<Entrada>, greater<Entrada> > cola;
+
+	mem.dist[origen] = 0;
+	mem.previo[origen] = -1;
+	mem.marca[origen] = mem.actual;
+	cola.push(Entrada(heuristica ? Distancia(origen, destino) : 0, origen));
+
+	bool encontrado = false;
+	while (!cola.empty()) {
+		int u = cola.top().second;
+		cola.pop();
+		if (mem.cerrado[u] == mem.actual)
+			continue;  // Obsoleta
+		mem.cerrado[u] = mem.actual;
+
+		double du = mem.dist[u];
+		if (u == destino) {
+			encontrado = true;
+			break;
+		}
+
+		for (int k = inicio[u]; k < inicio[u + 1]; k++) {
+			int v = this->destino[k];
+			double dv = du + peso[k];
+			if (mem.cerrado[v] != mem.actual && (mem.marca[v] != mem.actual || dv < mem.dist[v])) {
+				mem.marca[v] = mem.actual;
+				mem.dist[v] = dv;
+				mem.previo[v] = u;
+				cola.push(Entrada(dv + (heuristica ? Distancia(v, destino) : 0), v));
+			}
+		}
+	}
+
+	if (camino != 0) {
+		camino->clear();
+		if (encontrado) {
+			for (int v = destino; v != -1; v = mem.previo[v])
+				camino->push_back(v);
+			reverse(camino->begin(), camino->end());
+		}
+	}
+	return encontrado ? mem.dist[destino] : -1;
+}
+
+double RedVuelos::Dijkstra(int origen, int destino, vector<int> *camino) const {
+	return Buscar(origen, destino, false, camino);
+}
+
+double RedVuelos::AEstrella(int origen, int destino, vector<int> *camino) const {
+	return Buscar(origen, destino, true, camino);
+}
+
+vector<double> RedVuelos::Distancias(int origen) const {
+	vector<double> dist(numNodos(), -1);
+	typedef pair<double,int> Entrada;
+	priority_queue<Entrada, vector<Entrada>, greater<Entrada> > cola;
+
+	dist[origen] = 0;
+	cola.push(Entrada(0, origen));
+	while (!cola.empty()) {
+		Entrada e = cola.top();
+		cola.pop();
+		int u = e.second;
+		if (e.first > dist[u])
+			continue;  // Obsoleta
+
+		for (int k = inicio[u]; k < inicio[u + 1]; k++) {
+			int v = destino[k];
+			double dv = e.first + peso[k];
+			if (dist[v] < 0 || dv < dist[v]) {
+				dist[v] = dv;
+				cola.push(Entrada(dv, v));
+			}
+		}
+	}
+	return dist;
+}
+
+/**
+ * @brief Ejecuta una tarea para cada índice en [0, n), repartiendo los índices entre varios hilos
+ * @param n Número de índices
+ * @param num_hilos Número de hilos
+ * @param tarea Tarea a ejecutar para cada índice
+ */
+static void EnParalelo(int n, int num_hilos, const function<void(int)> &tarea) {
+	num_hilos = max(1, min(num_hilos, n));
+	atomic<int> siguiente(0);
+	vector<thread> hilos;
+	for (int h = 0; h < num_hilos; h++)
+		hilos.push_back(thread([&]() {
+			for (int i = siguiente++; i < n; i = siguiente++)
+				tarea(i);
+		}));
+	for (int h = 0; h < num_hilos; h++)
+		hilos[h].join();
+}
+
+vector<double> RedVuelos::CaminosMinimos(const vector<pair<int,int> > &consultas, int num_hilos,
+										 vector<vector<int> > *caminos) const {
+	vector<double> resultado(consultas.size());
+	if (caminos != 0)
+		caminos->assign(consultas.size(), vector<int>());
+
+	EnParalelo(consultas.size(), num_hilos, [&](int i) {
+		resultado[i] = Buscar(consultas[i].first, consultas[i].second, true, caminos != 0 ? &(*caminos)[i] : 0);
+	});
+	return resultado;
+}
+
+vector<vector<double> > RedVuelos::Distancias(const vector<int> &origenes, int num_hilos) const {
+	vector<vector<double> > resultado(origenes.size());
+	EnParalelo(origenes.size(), num_hilos, [&](int i) {
+		resultado[i] = Distancias(origenes[i]);
+	});
+	return resultado;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file red_medida.cpp
+ * @brief Fichero usado para medir la eficiencia empírica de los caminos mínimos en RedVuelos
+ *
+ * Genera una red sintética de aeropuertos aleatorios, en la que cada aeropuerto tiene vuelos de ida
+ * y vuelta con algunos aeropuertos cercanos y unos pocos tienen vuelos de largo recorrido.
+ * Mide la construcción de la red y el tiempo medio de un camino mínimo entre dos aeropuertos al azar
+ * con Dijkstra, con A* y con A* repartiendo las consultas entre varios hilos.
+ *
+ * @param NumeroDeNodos Número de aeropuertos. Opcional, por defecto 100000.
+ * @param NumeroDeConsultas Número de caminos mínimos a calcular. Opcional, por defecto 200.
+ * @param NumeroDeHilos Número de hilos del lote. Opcional, por defecto los que tenga la máquina.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./red_medida 100000 200 4
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include "redVuelos.h"
+
+using namespace std;
+
+/**
+ * @brief Devuelve los segundos transcurridos desde un instante
+ * @param tini Instante inicial
+ * @return Segundos transcurridos
+ */
+double Segundos(chrono::steady_clock::time_point tini) {
+	return chrono::duration<double>(chrono::steady_clock::now() - tini).count();
+}
+
+/**
+ * @brief Número real aleatorio en un intervalo
+ */
+double Aleatorio(double a, double b) {
+	return a + (b - a) * (rand() / (double) RAND_MAX);
+}
+
+/**
+ * @brief Añade al almacén una ruta de ida y vuelta entre dos puntos
+ */
+void AnadirVuelo(AlmacenRutas &almacen, const Punto &a, const Punto &b, int &num_rutas) {
+	vector<Punto> puntos;
+	puntos.push_back(a);
+	puntos.push_back(b);
+	puntos.push_back(a);
+	almacen.insertarRuta(Ruta("R" + to_string(num_rutas++), move(puntos)));
+}
+
+int main (int argc, char* argv[]) {
+	int nnodos = (argc > 1) ? atoi(argv[1]) : 100000;
+	int nconsultas = (argc > 2) ? atoi(argv[2]) : 200;
+	int nhilos = (argc > 3) ? atoi(argv[3]) : (int) thread::hardware_concurrency();
+	if (nhilos <= 0)
+		nhilos = 1;
+
+	if (argc > 4 || nnodos <= 1 || nconsultas <= 0) {
+		cerr << "Uso: red_medida [NumeroDeNodos] [NumeroDeConsultas] [NumeroDeHilos]" << endl;
+		return 1;
+	}
+
+	// Aeropuertos repartidos en una rejilla con unos 4 por celda
+	srand(1);
+	double celda = sqrt(130.0 * 360.0 / (nnodos / 4.0));
+	vector<Punto> aeropuertos;
+	unordered_map<long long, vector<int> > rejilla;
+	for (int i = 0; i < nnodos; i++) {
+		Punto p(Aleatorio(-60, 70), Aleatorio(-180, 180));
+		aeropuertos.push_back(p);
+		rejilla[((long long) floor(p.getLatitud() / celda) << 32) ^ (unsigned) floor(p.getLongitud() / celda)].push_back(i);
+	}
+
+	// Vuelos con 3 aeropuertos de la misma celda o de las vecinas, y unos pocos de largo recorrido
+	AlmacenRutas almacen;
+	int num_rutas = 0;
+	for (int i = 0; i < nnodos; i++) {
+		const Punto &p = aeropuertos[i];
+		for (int k = 0; k < 3; k++) {
+			int f = (int) floor(p.getLatitud() / celda) + rand() % 3 - 1;
+			int c = (int) floor(p.getLongitud() / celda) + rand() % 3 - 1;
+			unordered_map<long long, vector<int> >::const_iterator vecinos = rejilla.find(((long long) f << 32) ^ (unsigned) c);
+			if (vecinos != rejilla.end()) {
+				int j = vecinos->second[rand() % vecinos->second.size()];
+				if (j != i)
+					AnadirVuelo(almacen, p, aeropuertos[j], num_rutas);
+			}
+		}
+	}
+	for (int i = 0; i < nnodos / 100; i++)
+		AnadirVuelo(almacen, aeropuertos[rand() % nnodos], aeropuertos[rand() % nnodos], num_rutas);
+
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+	RedVuelos red(almacen);
+	double t_construir = Segundos(tini);
+
+	vector<pair<int,int> > consultas;
+	for (int i = 0; i < nconsultas; i++)
+		consultas.push_back(pair<int,int>(rand() % red.numNodos(), rand() % red.numNodos()));
+
+	// Dijkstra y A*, una consulta tras otra
+	vector<double> d_dijkstra(nconsultas), d_aestrella(nconsultas);
+	tini = chrono::steady_clock::now();
+	for (int i = 0; i < nconsultas; i++)
+		d_dijkstra[i] = red.Dijkstra(consultas[i].first, consultas[i].second);
+	double t_dijkstra = Segundos(tini) / nconsultas;
+
+	tini = chrono::steady_clock::now();
+	for (int i = 0; i < nconsultas; i++)
+		d_aestrella[i] = red.AEstrella(consultas[i].first, consultas[i].second);
+	double t_aestrella = Segundos(tini) / nconsultas;
+
+	// Lote en paralelo
+	tini = chrono::steady_clock::now();
+	vector<double> d_lote = red.CaminosMinimos(consultas, nhilos);
+	double t_lote = Segundos(tini) / nconsultas;
+
+	int distintos = 0, sin_camino = 0;
+	for (int i = 0; i < nconsultas; i++) {
+		if (fabs(d_dijkstra[i] - d_aestrella[i]) > 1e-6 || fabs(d_dijkstra[i] - d_lote[i]) > 1e-6)
+			distintos++;
+		if (d_dijkstra[i] < 0)
+			sin_camino++;
+	}
+
+	// Mostramos resultados (segundos por consulta)
+	cout << "Nodos: " << red.numNodos() << ", aristas: " << red.numAristas() << ", rutas: " << almacen.getNumRutas() << endl;
+	cout << "Construccion:\t" << t_construir << " s" << endl;
+	cout << "Dijkstra:\t" << t_dijkstra << endl;
+	cout << "A*:\t\t" << t_aestrella << endl;
+	cout << "A* (" << nhilos << " hilos):\t" << t_lote << endl;
+	cout << "Consultas: " << nconsultas << ", sin camino: " << sin_camino << ", resultados distintos: " << distintos << endl;
+
+	return distintos == 0 ? 0 : 1;
+}
@@ -8,26 +8,41 @@
  */
 
 #include "ruta.h"
+#include <algorithm>
+#include <limits>
 
 Ruta::Ruta(string codigo, const list<Punto> &puntos) {
-	this->codigo = codigo;
-	this->puntos = puntos;
+	this->codigo = move(codigo);
+	this->puntos.assign(puntos.begin(), puntos.end());
+}
+
+Ruta::Ruta(string codigo, vector<Punto> &&puntos) {
+	this->codigo = move(codigo);
+	this->puntos = move(puntos);
 }
 
 void Ruta::setCodigo(string codigo) {
-	this->codigo = codigo;
+	this->codigo = move(codigo);
 }
 
 
 void Ruta::setPuntos(const list<Punto> &puntos) {
+	this->puntos.assign(puntos.begin(), puntos.end());
+}
+
+void Ruta::setPuntos(const vector<Punto> &puntos) {
 	this->puntos = puntos;
 }
 
+void Ruta::setPuntos(vector<Punto> &&puntos) {
+	this->puntos = move(puntos);
+}
+
 string Ruta::getCodigo() const {
 	return codigo;
 }
 
-const list<Punto>& Ruta::getPuntos() const {
+const vector<Punto>& Ruta::getPuntos() const {
 	return puntos;
 }
 
@@ -40,14 +55,40 @@ void Ruta::insertarPunto(const Punto &p) {
 }
 
 void Ruta::eliminarPunto(const Punto &p) {
-	puntos.remove(p);
+	puntos.erase(remove(puntos.begin(), puntos.end(), p), puntos.end());
+}
+
+double Ruta::longitudTotal() const {
+	double total = 0;
+	for (size_t i = 1; i < puntos.size(); i++)
+		total += puntos[i - 1].distancia(puntos[i]);
+	return total;
+}
+
+Caja Ruta::caja() const {
+	double inf = numeric_limits<double>::infinity();
+	double lat_min = inf, lat_max = -inf, lon_min = inf, lon_max = -inf;
+
+	// Bucle sin dependencias entre iteraciones salvo los mínimos y máximos, para que el compilador pueda vectorizarlo
+	const Punto *p = puntos.data();
+	size_t n = puntos.size();
+	for (size_t i = 0; i < n; i++) {
+		double lat = p[i].getLatitud(), lon = p[i].getLongitud();
+		lat_min = lat < lat_min ? lat : lat_min;
+		lat_max = lat > lat_max ? lat : lat_max;
+		lon_min = lon < lon_min ? lon : lon_min;
+		lon_max = lon > lon_max ? lon : lon_max;
+	}
+
+	Caja c = {lat_min, lat_max, lon_min, lon_max};
+	return c;
 }
 
 ostream & operator<<(ostream & os, const Ruta & r) {
 	os << r.codigo << " ";
 	os << r.getNumPuntos() << " ";
 
-	list<Punto>::const_iterator it;
+	vector<Punto>::const_iterator it;
 	for (it = r.puntos.begin(); it != r.puntos.end(); ++it) {
 		os << *it << " ";
 	}
@@ -57,7 +98,7 @@ ostream & operator<<(ostream & os, const Ruta & r) {
 istream & operator>>(istream & is, Ruta & r) {
 	string codigo;
 	int numPuntos;
-	list<Punto> puntos;
+	vector<Punto> puntos;
 
 	is >> codigo;
 	r.setCodigo(codigo);
@@ -65,13 +106,14 @@ istream & operator>>(istream & is, Ruta & r) {
 	if (codigo.length()>0) {
 
 		is >> numPuntos;
+		puntos.reserve(min(max(numPuntos, 0), 4096));
 		Punto p;
 		for (int i = 0; i < numPuntos; ++i) {
 			is >> p;
 			puntos.push_back(p);
 		}
 
-		r.setPuntos(puntos);
+		r.setPuntos(move(puntos));
 	}
 	return is;
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file ruta_medida.cpp
+ * @brief Fichero usado para medir la memoria y el recorrido de las rutas
+ *
+ * Genera un conjunto de rutas aleatorias y compara guardar sus puntos en un list<Punto>,
+ * como se hacía antes en Ruta, con la Ruta actual, que los guarda de forma contigua.
+ * Mide los bytes reservados por ruta, el tiempo de recorrer todos los puntos y el de calcular
+ * la longitud total y la caja envolvente de cada ruta.
+ *
+ * @param NumeroDeRutas Número de rutas. Opcional, por defecto 100000.
+ * @param PuntosPorRuta Número de puntos de cada ruta. Opcional, por defecto 8.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./ruta_medida 100000 8
+ * @endcode
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <list>
+#include <vector>
+#include <limits>
+#include <malloc.h>
+#include "ruta.h"
+
+using namespace std;
+
+/**
+ * @brief Devuelve los bytes reservados en ese momento con malloc
+ * @return Bytes reservados
+ */
+size_t BytesReservados() {
+	return mallinfo2().uordblks;
+}
+
+/**
+ * @brief Longitud total de una ruta guardada en una lista
+ * @param puntos Puntos de la ruta
+ * @return Longitud en kilómetros
+ */
+double LongitudLista(const list<Punto> &puntos) {
+	double total = 0;
+	list<Punto>::const_iterator ant = puntos.begin(), it;
+	if (ant == puntos.end())
+		return 0;
+	for (it = ant, ++it; it != puntos.end(); ++it, ++ant)
+		total += (*ant).distancia(*it);
+	return total;
+}
+
+/**
+ * @brief Caja envolvente de una ruta guardada en una lista
+ * @param puntos Puntos de la ruta
+ * @return Caja envolvente
+ */
+Caja CajaLista(const list<Punto> &puntos) {
+	double inf = numeric_limits<double>::infinity();
+	Caja c = {inf, -inf, inf, -inf};
+	for (list<Punto>::const_iterator it = puntos.begin(); it != puntos.end(); ++it) {
+		c.lat_min = min(c.lat_min, it->getLatitud());
+		c.lat_max = max(c.lat_max, it->getLatitud());
+		c.lon_min = min(c.lon_min, it->getLongitud());
+		c.lon_max = max(c.lon_max, it->getLongitud());
+	}
+	return c;
+}
+
+/**
+ * @brief Devuelve los segundos transcurridos desde un instante
+ * @param tini Instante inicial
+ * @return Segundos transcurridos
+ */
+double Segundos(clock_t tini) {
+	return (clock() - tini) / (double) CLOCKS_PER_SEC;
+}
+
+int main (int argc, char* argv[]) {
+	int nrutas = (argc > 1) ? atoi(argv[1]) : 100000;
+	int npuntos = (argc > 2) ? atoi(argv[2]) : 8;
+
+	if (argc > 3 || nrutas <= 0 || npuntos <= 0) {
+		cerr << "Uso: ruta_medida [NumeroDeRutas] [PuntosPorRuta]" << endl;
+		return 1;
+	}
+
+	srand(1);
+	vector<Punto> aleatorios;
+	for (int i = 0; i < nrutas * npuntos; i++)
+		aleatorios.push_back(Punto(rand() / (double) RAND_MAX * 180 - 90, rand() / (double) RAND_MAX * 360 - 180));
+
+	// Construimos las rutas de las dos formas, midiendo la memoria que reservan
+	size_t antes = BytesReservados();
+	vector<list<Punto> > listas(nrutas);
+	for (int i = 0; i < nrutas; i++)
+		for (int j = 0; j < npuntos; j++)
+			listas[i].push_back(aleatorios[i * npuntos + j]);
+	double bytes_lista = (BytesReservados() - antes) / (double) nrutas;
+
+	antes = BytesReservados();
+	vector<Ruta> rutas(nrutas);
+	for (int i = 0; i < nrutas; i++) {
+		vector<Punto> puntos(aleatorios.begin() + i * npuntos, aleatorios.begin() + (i + 1) * npuntos);
+		rutas[i].setPuntos(move(puntos));
+	}
+	double bytes_ruta = (BytesReservados() - antes) / (double) nrutas;
+
+	// Recorrido de todos los puntos
+	double suma_lista = 0, suma_ruta = 0;
+	clock_t tini = clock();
+	for (int i = 0; i < nrutas; i++)
+		for (list<Punto>::const_iterator it = listas[i].begin(); it != listas[i].end(); ++it)
+			suma_lista += it->getLatitud();
+	double t_rec_lista = Segundos(tini);
+
+	tini = clock();
+	const vector<Ruta> &crutas = rutas;
+	for (int i = 0; i < nrutas; i++)
+		for (Ruta::const_iterator it = crutas[i].begin(); it != crutas[i].end(); ++it)
+			suma_ruta += (*it).getLatitud();
+	double t_rec_ruta = Segundos(tini);
+
+	// Longitud total
+	double long_lista = 0, long_ruta = 0;
+	tini = clock();
+	for (int i = 0; i < nrutas; i++)
+		long_lista += LongitudLista(listas[i]);
+	double t_long_lista = Segundos(tini);
+
+	tini = clock();
+	for (int i = 0; i < nrutas; i++)
+		long_ruta += rutas[i].longitudTotal();
+	double t_long_ruta = Segundos(tini);
+
+	// Caja envolvente
+	double area_lista = 0, area_ruta = 0;
+	tini = clock();
+	for (int i = 0; i < nrutas; i++) {
+		Caja c = CajaLista(listas[i]);
+		area_lista += (c.lat_max - c.lat_min) * (c.lon_max - c.lon_min);
+	}
+	double t_caja_lista = Segundos(tini);
+
+	tini = clock();
+	for (int i = 0; i < nrutas; i++) {
+		Caja c = rutas[i].caja();
+		area_ruta += (c.lat_max - c.lat_min) * (c.lon_max - c.lon_min);
+	}
+	double t_caja_ruta = Segundos(tini);
+
+	// Mostramos resultados (segundos totales)
+	cout << "Rutas: " << nrutas << ", puntos por ruta: " << npuntos << endl;
+	cout << "\t\tlist<Punto>\tRuta" << endl;
+	cout << "bytes/ruta\t" << bytes_lista << "\t\t" << bytes_ruta << endl;
+	cout << "recorrido\t" << t_rec_lista << "\t" << t_rec_ruta << "\t(" << (suma_lista == suma_ruta ? "iguales" : "DISTINTOS") << ")" << endl;
+	cout << "longitud\t" << t_long_lista << "\t" << t_long_ruta << "\t(" << (long_lista == long_ruta ? "iguales" : "DISTINTOS") << ")" << endl;
+	cout << "caja\t\t" << t_caja_lista << "\t" << t_caja_ruta << "\t(" << (area_lista == area_ruta ? "iguales" : "DISTINTOS") << ")" << endl;
+
+	return 0;
+}
@@ -10,7 +10,8 @@
  * y permite al usuario elegir una de ellas para mostrarla en un mapa del mundo.
  *
  * Se muestra por pantalla el nombre de los paises por los que pasa la ruta y, en la imagen del mapa del mundo,
- * se muestran las banderas de los paises por los que pasa la ruta y un avion que va de un pais a otro.
+ * se muestran el arco de circulo maximo que sigue cada tramo, las banderas de los paises por los que pasa
+ * la ruta y un avion que va de un pais a otro.
  *
  * @param fichero_paises Fichero con la informacion de los paises
  * @param mapa_mundo Nombre de la imagen con el mapa del mundo
@@ -18,6 +19,10 @@
  * @param almacen_rutas Fichero con el almacen de rutas
  * @param avion Nombre de la imagen con el avion. Tipo PPM
  * @param mascara_avion Nombre de la imagen de la mascara del avion. Tipo PGM
+ * @param recorte Si se indica "recorte", solo se guarda la zona del mapa por la que pasa la ruta. Opcional.
+ *
+ * El mapa se divide en teselas (MapaTeselado) y solo se copian y modifican las que toca la ruta.
+ * La imagen resultante se escribe componiendo sus filas a partir de las teselas.
  *
  *
  * Un ejemplo de ejecucin es:
@@ -49,12 +54,14 @@
 #include "almacenRutas.h"
 #include "paises.h"
 #include "imagen.h"
+#include "pintorRutas.h"
+#include "mapaTeselado.h"
 #include <fstream>
 
 #define RESULT_PATH "./output/"
 
 int main (int argc, char* argv[]) {
-    if (argc!=7){
+    if ((argc != 7 && argc != 8) || (argc == 8 && string(argv[7]) != "recorte")){
         cout<<"Los parametros son:"<<endl;
         cout<<"1 - Fichero con la informacion de los paises"<<endl;
         cout<<"2 - Nombre de la imagen con el mapa del mundo"<<endl;
@@ -62,41 +69,29 @@ int main (int argc, char* argv[]) {
         cout<<"4 - Fichero con el almacen de rutas"<<endl;
         cout<<"5 - Nombre de la imagen con el avion"<<endl;
         cout<<"6 - Nombre de la imagen de la mascara del avion"<<endl;
+        cout<<"7 - recorte, para guardar solo la zona de la ruta (opcional)"<<endl;
 
-		cout << "Uso: " << argv[0] << " <fichero_paises> <mapa_mundo> <dir_banderas> <almacen_rutas> <avion> <mascara_avion>" << endl;
+		cout << "Uso: " << argv[0] << " <fichero_paises> <mapa_mundo> <dir_banderas> <almacen_rutas> <avion> <mascara_avion> [recorte]" << endl;
 
         return -1;
     }
 
-	ifstream file;
-	file.open(argv[1]);
 	Paises paises; // Leemos los paises
-	if (file)
-		file >> paises;
-	else {
-		cout << "Error de apertura del fichero" << argv[1] << endl;
+	if (!paises.CargarFichero(argv[1]))
 		return -1;
-	}
-	file.close();
 
 
-	Imagen mapa;
-	mapa.LeerImagen(argv[2]);
+	Imagen imagen_mapa;
+	imagen_mapa.LeerImagen(argv[2]);
+	MapaTeselado mapa(imagen_mapa);
 
 	Imagen avion;
 	avion.LeerImagen(argv[5], argv[6]); // Leemos con la mscara
 
 
     AlmacenRutas Ar; // Leemos el almacen de rutas
-    file.open (argv[4]);
-	if (file){
-		file >> Ar;
-	}
-	else {
-		cout << "Error de apertura del fichero " << argv[4] << endl;
+	if (!Ar.CargarFichero(argv[4]))
 		return -1;
-	}
-	file.close();
 
 	// Muestra todas las rutas disponibles
     cout<<"Las rutas: "<<endl;
@@ -109,60 +104,20 @@ int main (int argc, char* argv[]) {
         cout << "La ruta no existe" << endl;
         return 1;
     }
-    Ruta route=Ar.getRuta(id_ruta);
+    const Ruta &route=Ar.getRuta(id_ruta);
 
     // Ya tenemos la ruta, ahora vamos a mostrarla
-    string dir_banderas = argv[3];
-
-    Ruta::iterator it_r=route.begin();
-    Punto point1, point2;
-    pair<int,int> coord_point1, coord_point2, coord_point_midpoint;
-    double orientation_angle;
-    Imagen avion_rotado;
-    Pais pais;
-    Imagen bandera;
-
-    while (it_r != route.end()) {
-        point1=*it_r;
-        coord_point1 = point1.coordenadasMapa(mapa.getColumnas(), mapa.getFilas());
-
-        // Extraigo pas
-        Paises::iterator pos_pais_point1 = paises.find(point1);
-        if (pos_pais_point1 == paises.end()) {
-            cout << "No pudo encontrarse el pais que tiene como punto " << point1 << endl;
-            exit(-1);
-        }
-        pais = *(paises.find(point1));
-
-        // Pongo bandera en el mapa
-        string nombre_bandera = dir_banderas + "/" + pais.getBandera();
-        bandera.LeerImagen(nombre_bandera.c_str());
-        Tipo_Pegado tp_bl = BLENDING;
-        mapa.PutImagen(coord_point1.first, coord_point1.second, bandera, tp_bl);
-        // Imprimo por pantalla el nombre del pas
-        cout << pais.getNombre() << " ";
-
-        // Leo siguiente punto
-        ++it_r;
-        if (it_r != route.end()) {
-            point2=*it_r;
-            coord_point2 = point2.coordenadasMapa(mapa.getColumnas(), mapa.getFilas());
-            coord_point_midpoint = point1.punto_medio_en_mapa(point2, mapa.getColumnas(), mapa.getFilas());
-            orientation_angle = point1.angulo_en_mapa(point2, mapa.getColumnas(), mapa.getFilas());
-
-            // Pego los 3 aviones correspondientes
-            Tipo_Pegado tp_op = OPACO;
-            avion_rotado = avion.Rota(orientation_angle);
-            mapa.PutImagen(coord_point_midpoint.first, coord_point_midpoint.second, avion_rotado, tp_op);
-            mapa.PutImagen(coord_point1.first, coord_point1.second, avion_rotado, tp_op);
-            mapa.PutImagen(coord_point2.first, coord_point2.second, avion_rotado, tp_op);
-        } // if (it_r != route.end())
-    } // while (it_r != route.end())
+    PintorRutas pintor(paises, argv[3], avion);
+    if (!pintor.Pintar(route, mapa, &cout))
+        exit(-1);
 
     string result_path = RESULT_PATH + route.getCodigo() + string("_Mapa.ppm");
-    mapa.EscribirImagen(result_path.c_str());
-
+    // El mapa es la imagen final: su transparencia no interesa, asi que no se escribe la mascara
+    if (argc == 8)
+        mapa.EscribirRegion(result_path.c_str(), mapa.Huella(), SOLO_PPM);
+    else
+        mapa.EscribirImagen(result_path.c_str(), SOLO_PPM);
 
-	cout << endl << endl;
+    cout << endl << endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+/**
+ * @file rutaaerea_lote.cpp
+ *
+ * @author Arturo Olivares Martos
+ * @author Daniel Hidalgo Chica
+ *
+ * @brief Programa que genera el mapa de todas las rutas de un almacén de rutas.
+ *
+ * Es la versión por lotes de rutaaerea.cpp: en lugar de pedir una ruta al usuario, genera
+ * el fichero <codigo>_Mapa.ppm de cada una de las rutas del almacén, repartiéndolas entre varios hilos.
+ *
+ * El mapa del mundo, las banderas y el avión se leen una única vez y todos los hilos los comparten
+ * sin modificarlos. El mapa se divide en teselas (MapaTeselado): cada hilo pinta sobre su propia copia,
+ * que sólo duplica las teselas que toca la ruta, y tras guardarla la restaura descartándolas. Así el
+ * coste de cada ruta depende de la zona que ocupa y no del tamaño del mapa. Cada mapa se guarda
+ * completo o, si se pide, recortado a la zona de la ruta.
+ *
+ * Si se indica, genera además un mapa con la red completa: los arcos de círculo máximo de todos
+ * los tramos de todas las rutas, dibujados en una sola pasada por las teselas del mapa.
+ *
+ * Al terminar se muestra el número de rutas por segundo y el pico de memoria del proceso.
+ *
+ * @param fichero_paises Fichero con la informacion de los paises
+ * @param mapa_mundo Nombre de la imagen con el mapa del mundo
+ * @param dir_banderas Directorio con las banderas
+ * @param almacen_rutas Fichero con el almacen de rutas
+ * @param avion Nombre de la imagen con el avion. Tipo PPM
+ * @param mascara_avion Nombre de la imagen de la mascara del avion. Tipo PGM
+ * @param num_hilos Número de hilos a emplear. Opcional, por defecto los que tenga la máquina.
+ * @param mapa_red Nombre del mapa con la red completa. Opcional, si no se indica o es "-" no se genera.
+ * @param recorte Si se indica "recorte", de cada ruta sólo se guarda la zona del mapa por la que pasa. Opcional.
+ *
+ * Ejemplo de uso:
+ * @code{.sh}
+ * ./rutaaerea_lote ./datos/paises.txt ./datos/imagenes/mapas/mapa1.ppm ./datos/imagenes/banderas/ ./datos/almacen_rutas.txt ./datos/imagenes/aviones/avion3.ppm ./datos/imagenes/aviones/mascara_avion3.pgm 4 ./output/Red_Mapa.ppm
+ * Rutas generadas: 5 de 5
+ * Tiempo: 0.31 s (16.1 rutas/s)
+ * Red: 29 tramos en 0.002 s
+ * Pico de memoria: 61 MB
+ * @endcode
+ */
+
+#include "almacenRutas.h"
+#include "paises.h"
+#include "imagen.h"
+#include "pintorRutas.h"
+#include "arcos.h"
+#include "mapaTeselado.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <sys/resource.h>
+
+#define RESULT_PATH "./output/"
+
+/**
+ * @brief Pinta y guarda las rutas que le vayan tocando a un hilo
+ * @param pintor Pintor de rutas compartido
+ * @param mapa Mapa del mundo compartido
+ * @param recorte Si es true, sólo se guarda la zona de cada ruta
+ * @param rutas Rutas a pintar
+ * @param siguiente Índice de la siguiente ruta por pintar, compartido por todos los hilos
+ * @param generadas Contador de rutas generadas
+ */
+void Trabajador(const PintorRutas &pintor, const MapaTeselado &mapa, bool recorte, const vector<const Ruta *> &rutas,
+				atomic<int> &siguiente, atomic<int> &generadas) {
+	MapaTeselado lienzo(mapa);
+
+	for (int i = siguiente++; i < (int) rutas.size(); i = siguiente++) {
+		if (pintor.Pintar(*rutas[i], lienzo)) {
+			string result_path = RESULT_PATH + rutas[i]->getCodigo() + string("_Mapa.ppm");
+			// El mapa es la imagen final: su transparencia no interesa, así que no se escribe la máscara
+			if (recorte)
+				lienzo.EscribirRegion(result_path.c_str(), lienzo.Huella(), SOLO_PPM);
+			else
+				lienzo.EscribirImagen(result_path.c_str(), SOLO_PPM);
+			generadas++;
+		}
+
+		// Dejamos el lienzo como el mapa original
+		lienzo.Restaurar();
+	}
+}
+
+int main (int argc, char* argv[]) {
+	if (argc < 7 || argc > 10 || (argc == 10 && string(argv[9]) != "recorte")) {
+		cout << "Los parametros son:" << endl;
+		cout << "1 - Fichero con la informacion de los paises" << endl;
+		cout << "2 - Nombre de la imagen con el mapa del mundo" << endl;
+		cout << "3 - Directorio con las banderas" << endl;
+		cout << "4 - Fichero con el almacen de rutas" << endl;
+		cout << "5 - Nombre de la imagen con el avion" << endl;
+		cout << "6 - Nombre de la imagen de la mascara del avion" << endl;
+		cout << "7 - Numero de hilos (opcional)" << endl;
+		cout << "8 - Nombre del mapa con la red completa, o - para no generarlo (opcional)" << endl;
+		cout << "9 - recorte, para guardar solo la zona de cada ruta (opcional)" << endl;
+
+		cout << "Uso: " << argv[0] << " <fichero_paises> <mapa_mundo> <dir_banderas> <almacen_rutas> <avion> <mascara_avion> [num_hilos] [mapa_red] [recorte]" << endl;
+
+		return -1;
+	}
+
+	int num_hilos = (argc >= 8) ? atoi(argv[7]) : (int) thread::hardware_concurrency();
+	if (num_hilos <= 0)
+		num_hilos = 1;
+
+	Paises paises; // Leemos los paises
+	if (!paises.CargarFichero(argv[1]))
+		return -1;
+
+	Imagen imagen_mapa;
+	imagen_mapa.LeerImagen(argv[2]);
+	MapaTeselado mapa(imagen_mapa);
+	bool recorte = (argc == 10);
+
+	Imagen avion;
+	avion.LeerImagen(argv[5], argv[6]); // Leemos con la máscara
+
+	AlmacenRutas Ar; // Leemos el almacen de rutas, repartiéndolo entre los mismos hilos
+	if (!Ar.CargarFichero(argv[4], num_hilos))
+		return -1;
+
+	chrono::steady_clock::time_point tini = chrono::steady_clock::now();
+
+	PintorRutas pintor(paises, argv[3], avion);
+	pintor.PrecargarBanderas(Ar);
+
+	const AlmacenRutas &almacen = Ar;
+	vector<const Ruta *> rutas;
+	for (AlmacenRutas::const_iterator it = almacen.begin(); it != almacen.end(); ++it)
+		rutas.push_back(&(*it));
+
+	atomic<int> siguiente(0), generadas(0);
+	vector<thread> hilos;
+	for (int h = 0; h < num_hilos; h++)
+		hilos.push_back(thread(Trabajador, cref(pintor), cref(mapa), recorte, cref(rutas), ref(siguiente), ref(generadas)));
+	for (int h = 0; h < num_hilos; h++)
+		hilos[h].join();
+
+	chrono::steady_clock::time_point tfin = chrono::steady_clock::now();
+	double segundos = chrono::duration<double>(tfin - tini).count();
+
+	struct rusage uso;
+	getrusage(RUSAGE_SELF, &uso);
+
+	cout << "Rutas generadas: " << generadas << " de " << rutas.size() << endl;
+	cout << "Tiempo: " << segundos << " s (" << generadas / segundos << " rutas/s)" << endl;
+	// Mapa con todos los tramos de todas las rutas
+	if (argc >= 9 && string(argv[8]) != "-") {
+		tini = chrono::steady_clock::now();
+		MapaTeselado red(mapa);
+		LoteArcos arcos;
+		arcos.Anadir(almacen);
+		arcos.Dibujar(red, pintor.getColorArcos(), TRAMOS_ARCO, num_hilos);
+		tfin = chrono::steady_clock::now();
+		red.EscribirImagen(argv[8], SOLO_PPM);
+
+		cout << "Red: " << arcos.size() << " tramos en " << chrono::duration<double>(tfin - tini).count() << " s" << endl;
+	}
+
+	cout << "Pico de memoria: " << uso.ru_maxrss / 1024 << " MB" << endl;
+
+	return (generadas == (int) rutas.size()) ? 0 : 1;
+}